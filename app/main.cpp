@@ -1,10 +1,17 @@
+#include <fstream>
 #include <iostream>
 
 #include <cxxopts.hpp>
 
 #include <anthem/AST.h>
+#include <anthem/Batch.h>
 #include <anthem/Context.h>
+#include <anthem/Exception.h>
+#include <anthem/Server.h>
 #include <anthem/Translation.h>
+#include <anthem/TranslationCache.h>
+#include <anthem/Version.h>
+#include <anthem/Watcher.h>
 
 int main(int argc, char **argv)
 {
@@ -16,12 +23,25 @@ int main(int argc, char **argv)
 		("h,help", "Display this help message")
 		("v,version", "Display version information")
 		("i,input", "Input files (one file for plain translation, two files for proving equivalence)", cxxopts::value<std::vector<std::string>>())
+		("batch", "Run the translation jobs listed in this file (“-” for standard input), each given by its input files followed by the output file on one line", cxxopts::value<std::string>())
+		("serve", "Keep running and answer translation requests given as JSON objects, one per line, on standard input")
+		("socket", "Keep running and answer translation requests given as JSON objects, one per line, on this Unix domain socket", cxxopts::value<std::string>())
+		("watch", "Keep running and translate the input files again whenever they change")
 		("mode", "Translation mode (here-and-there, completion)", cxxopts::value<std::string>()->default_value("here-and-there"))
 		("output-format", "Output format (human-readable, tptp)", cxxopts::value<std::string>()->default_value("human-readable"))
 		("map-to-integers", "Map all variable sorts to integers (always, auto)", cxxopts::value<std::string>()->default_value("auto"))
 		("no-simplify", "Do not simplify the output (only with completion translation mode)")
 		("no-complete", "Do not perform completion (only with completion translation mode)")
 		("no-detect-integers", "Do not detect integer variables (only with completion translation mode)")
+		("abbreviation-threshold", "Keep hidden predicates that occur more than once and whose definitions exceed this number of nodes as abbreviations instead of eliminating them, 0 to always eliminate them (only with completion translation mode)", cxxopts::value<size_t>()->default_value("0"))
+		("stats", "Print performance statistics to the error stream (per formula with --log-priority=debug)")
+		("cache", "Reuse translation outputs stored in this directory, and store new ones there", cxxopts::value<std::string>())
+		("cache-size", "Maximum size of the cache directory in MiB, beyond which the least recently used outputs are removed", cxxopts::value<size_t>()->default_value("1024"))
+		("cache-stats", "Print statistics about the cache to the error stream")
+		("profile", "Write a profile of the translation phases to this file (Chrome trace event format)", cxxopts::value<std::string>())
+		("profile-details", "Include individual predicates, formulas, and statements in the profile")
+		("parallel-parsing", "Parse and translate two input programs concurrently (only with here-and-there translation mode)")
+		("threads", "Number of threads for completion and simplification (only with completion translation mode) or for running batch jobs", cxxopts::value<size_t>()->default_value("1"))
 		("color", "Colorize output (always, never, auto)", cxxopts::value<std::string>()->default_value("auto"))
 		("parentheses", "Parenthesis style (normal, full) (only with human-readable output format)", cxxopts::value<std::string>()->default_value("normal"))
 		("p,log-priority", "Log messages starting from this priority (debug, info, warning, error)", cxxopts::value<std::string>()->default_value("info"));
@@ -45,6 +65,14 @@ int main(int argc, char **argv)
 	std::string colorPolicyString;
 	std::string parenthesisStyleString;
 	std::string logPriorityString;
+	std::string profileFileName;
+	std::string batchFileName;
+	bool serve;
+	bool watch;
+	std::string cacheDirectory;
+	size_t cacheSize;
+	bool printCacheStatistics;
+	std::string socketPath;
 
 	try
 	{
@@ -56,12 +84,38 @@ int main(int argc, char **argv)
 		if (parseResult.count("input") > 0)
 			inputFiles = parseResult["input"].as<std::vector<std::string>>();
 
+		if (parseResult.count("batch") > 0)
+			batchFileName = parseResult["batch"].as<std::string>();
+
+		serve = (parseResult.count("serve") > 0);
+		watch = (parseResult.count("watch") > 0);
+
+		if (parseResult.count("socket") > 0)
+			socketPath = parseResult["socket"].as<std::string>();
+
 		translationModeString = parseResult["mode"].as<std::string>();
 		outputFormatString = parseResult["output-format"].as<std::string>();
 		mapToIntegersPolicyString = parseResult["map-to-integers"].as<std::string>();
 		context.performSimplification = (parseResult.count("no-simplify") == 0);
 		context.performCompletion = (parseResult.count("no-complete") == 0);
 		context.performIntegerDetection = (parseResult.count("no-detect-integers") == 0);
+		context.abbreviationThreshold = parseResult["abbreviation-threshold"].as<size_t>();
+		context.numberOfThreads = parseResult["threads"].as<size_t>();
+		context.parseConcurrently = (parseResult.count("parallel-parsing") > 0);
+		context.collectStatistics = (parseResult.count("stats") > 0);
+
+		if (parseResult.count("profile") > 0)
+		{
+			profileFileName = parseResult["profile"].as<std::string>();
+			context.profiler = std::make_unique<anthem::Profiler>(parseResult.count("profile-details") > 0);
+		}
+
+		if (parseResult.count("cache") > 0)
+			cacheDirectory = parseResult["cache"].as<std::string>();
+
+		cacheSize = parseResult["cache-size"].as<size_t>();
+		printCacheStatistics = (parseResult.count("cache-stats") > 0);
+
 		colorPolicyString = parseResult["color"].as<std::string>();
 		parenthesisStyleString = parseResult["parentheses"].as<std::string>();
 		logPriorityString = parseResult["log-priority"].as<std::string>();
@@ -82,7 +136,7 @@ int main(int argc, char **argv)
 
 	if (version)
 	{
-		std::cout << "anthem version 0.1.9+git" << std::endl;
+		std::cout << "anthem version " << anthem::Version << std::endl;
 		return EXIT_SUCCESS;
 	}
 
@@ -122,6 +176,14 @@ int main(int argc, char **argv)
 		return EXIT_FAILURE;
 	}
 
+	if (context.numberOfThreads == 0)
+	{
+		context.logger.log(anthem::output::Priority::Error) << "number of threads must be at least 1";
+		context.logger.errorStream() << std::endl;
+		printHelp();
+		return EXIT_FAILURE;
+	}
+
 	if (colorPolicyString == "auto")
 		context.logger.setColorPolicy(anthem::output::ColorStream::ColorPolicy::Auto);
 	else if (colorPolicyString == "never")
@@ -136,6 +198,9 @@ int main(int argc, char **argv)
 		return EXIT_FAILURE;
 	}
 
+	// Formulas are written in large chunks rather than token by token
+	context.logger.outputStream().enableBuffering();
+
 	if (parenthesisStyleString == "normal")
 		context.parenthesisStyle = anthem::output::ParenthesisStyle::Normal;
 	else if (parenthesisStyleString == "full")
@@ -161,18 +226,166 @@ int main(int argc, char **argv)
 		return EXIT_FAILURE;
 	}
 
+	if (!cacheDirectory.empty())
+	{
+		try
+		{
+			context.translationCache = std::make_shared<anthem::TranslationCache>(cacheDirectory, cacheSize * 1024 * 1024);
+		}
+		catch (const std::exception &e)
+		{
+			context.logger.log(anthem::output::Priority::Error) << e.what();
+			return EXIT_FAILURE;
+		}
+	}
+	else if (printCacheStatistics)
+	{
+		context.logger.log(anthem::output::Priority::Error) << "cache statistics require a cache directory";
+		return EXIT_FAILURE;
+	}
+
+	// The profile is also written if the translation fails
+	const auto writeProfile =
+		[&]()
+		{
+			if (!context.profiler)
+				return true;
+
+			std::ofstream profileFile(profileFileName, std::ios::out);
+
+			if (!profileFile.is_open())
+			{
+				context.logger.log(anthem::output::Priority::Error) << "could not write profile to “" << profileFileName << "”";
+				return false;
+			}
+
+			context.profiler->write(profileFile);
+
+			return true;
+		};
+
+	if (!batchFileName.empty())
+	{
+		if (!inputFiles.empty())
+		{
+			context.logger.log(anthem::output::Priority::Error) << "input files must be listed in the batch file";
+			return EXIT_FAILURE;
+		}
+
+		size_t numberOfJobs = 0;
+		size_t numberOfFailedJobs = 0;
+
+		try
+		{
+			std::ifstream batchFile;
+
+			if (batchFileName != "-")
+			{
+				batchFile.open(batchFileName, std::ios::in);
+
+				if (!batchFile.is_open())
+					throw anthem::LogicException("could not read file “" + batchFileName + "”");
+			}
+
+			auto &batchStream = (batchFileName == "-") ? std::cin : static_cast<std::istream &>(batchFile);
+			const auto jobs = anthem::readBatchJobs(batchFileName.c_str(), batchStream);
+
+			numberOfJobs = jobs.size();
+			numberOfFailedJobs = anthem::runBatchJobs(jobs, context);
+		}
+		catch (const std::exception &e)
+		{
+			context.logger.log(anthem::output::Priority::Error) << e.what();
+			writeProfile();
+			return EXIT_FAILURE;
+		}
+
+		if (printCacheStatistics)
+			context.translationCache->printStatistics(context.logger.errorStream());
+
+		if (numberOfFailedJobs > 0)
+			context.logger.log(anthem::output::Priority::Error) << "failed jobs: " << numberOfFailedJobs << " of " << numberOfJobs;
+
+		if (!writeProfile() || numberOfFailedJobs > 0)
+			return EXIT_FAILURE;
+
+		return EXIT_SUCCESS;
+	}
+
+	if (serve || !socketPath.empty())
+	{
+		if (!inputFiles.empty() || !batchFileName.empty())
+		{
+			context.logger.log(anthem::output::Priority::Error) << "input files must be part of the requests in server mode";
+			return EXIT_FAILURE;
+		}
+
+		anthem::Server server(context);
+
+		try
+		{
+			if (!socketPath.empty())
+				server.serveOnSocket(socketPath);
+			else
+				server.serve(std::cin, std::cout);
+		}
+		catch (const std::exception &e)
+		{
+			context.logger.log(anthem::output::Priority::Error) << e.what();
+			writeProfile();
+			return EXIT_FAILURE;
+		}
+
+		if (!writeProfile())
+			return EXIT_FAILURE;
+
+		return EXIT_SUCCESS;
+	}
+
+	if (watch)
+	{
+		if (inputFiles.empty())
+		{
+			context.logger.log(anthem::output::Priority::Error) << "input files must be given in watch mode";
+			return EXIT_FAILURE;
+		}
+
+		try
+		{
+			anthem::Watcher watcher(inputFiles, context);
+			watcher.watch();
+		}
+		catch (const std::exception &e)
+		{
+			context.logger.log(anthem::output::Priority::Error) << e.what();
+			return EXIT_FAILURE;
+		}
+
+		return EXIT_SUCCESS;
+	}
+
 	try
 	{
 		if (!inputFiles.empty())
 			anthem::translate(inputFiles, context);
 		else
 			anthem::translate("std::cin", std::cin, context);
+
+		if (context.collectStatistics)
+			context.statistics.print(context.logger.errorStream(), context.logger.logPriority() == anthem::output::Priority::Debug);
+
+		if (printCacheStatistics)
+			context.translationCache->printStatistics(context.logger.errorStream());
 	}
 	catch (const std::exception &e)
 	{
 		context.logger.log(anthem::output::Priority::Error) << e.what();
+		writeProfile();
 		return EXIT_FAILURE;
 	}
 
+	if (!writeProfile())
+		return EXIT_FAILURE;
+
 	return EXIT_SUCCESS;
 }
@@ -0,0 +1,89 @@
+#ifndef __ANTHEM__BENCHMARKS__BENCHMARK_H
+#define __ANTHEM__BENCHMARKS__BENCHMARK_H
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <anthem/AST.h>
+#include <anthem/Context.h>
+
+namespace anthem
+{
+namespace benchmarks
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Benchmark
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Benchmark
+{
+	const char *name;
+	std::function<void()> run;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Memory
+{
+	// Total size of the arenas holding the AST nodes
+	size_t arenaBytes;
+	// Peak resident set size of the whole process so far
+	size_t peakResidentBytes;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::vector<Benchmark> &registeredBenchmarks();
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Registers a benchmark when constructed as a global object
+struct BenchmarkRegistration
+{
+	BenchmarkRegistration(const char *name, std::function<void()> &&run)
+	{
+		registeredBenchmarks().push_back({name, std::move(run)});
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Runs a function several times and returns the median duration of a single run
+std::chrono::duration<double, std::milli> measure(const std::function<void()> &function, size_t repetitions = 5);
+// Same as above, but prepares the input of each run without measuring the preparation
+std::chrono::duration<double, std::milli> measure(const std::function<void()> &prepare,
+	const std::function<void()> &function, size_t repetitions = 5);
+
+// Prints the duration of a benchmark variant, or records it if the results are printed as JSON
+void report(const char *benchmark, const char *variant, std::chrono::duration<double, std::milli> duration);
+// Same as above, along with the memory that the variant needed
+void report(const char *benchmark, const char *variant, std::chrono::duration<double, std::milli> duration,
+	const Memory &memory);
+
+// Returns the peak resident set size of the process so far in bytes
+size_t peakResidentBytes();
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Reads a program from the examples directory by its name without extension
+std::string readExample(const char *name);
+
+// Concatenates copies of a program, renaming the predicates and constants of each copy apart
+std::string scaleProgram(const std::string &program, size_t factor);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Builds formulas shaped like completed definitions, shared by several benchmarks
+std::vector<ast::Formula> buildCompletedFormulas(Context &context);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#endif
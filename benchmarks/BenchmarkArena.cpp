@@ -0,0 +1,123 @@
+#include <sstream>
+
+#include <anthem/AST.h>
+#include <anthem/Arena.h>
+#include <anthem/Context.h>
+#include <anthem/Translation.h>
+
+#include "Benchmark.h"
+
+namespace anthem
+{
+namespace benchmarks
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// BenchmarkArena
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+constexpr size_t NumberOfFormulas = 100000;
+constexpr size_t NumberOfVariables = 3;
+constexpr size_t NumberOfRules = 5000;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Builds and tears down formulas of the form “forall X1 X2 X3 (p(X1, X2, X3) -> not q(X1))”
+void buildAndDestroyFormulas(ast::PredicateDeclaration *p, ast::PredicateDeclaration *q)
+{
+	std::vector<ast::Formula> formulas;
+	formulas.reserve(NumberOfFormulas);
+
+	for (size_t i = 0; i < NumberOfFormulas; i++)
+	{
+		ast::VariableDeclarationPointers variables;
+		std::vector<ast::Term> arguments;
+
+		for (size_t j = 0; j < NumberOfVariables; j++)
+		{
+			variables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::UserDefined));
+			arguments.emplace_back(ast::Variable(variables.back().get()));
+		}
+
+		std::vector<ast::Term> argumentsQ;
+		argumentsQ.emplace_back(ast::Variable(variables.front().get()));
+
+		ast::Formula antecedent = ast::Predicate(p, std::move(arguments));
+		ast::Formula consequent = ast::Not(ast::Predicate(q, std::move(argumentsQ)));
+		ast::Formula implies = ast::Implies(std::move(antecedent), std::move(consequent));
+
+		formulas.emplace_back(ast::ForAll(std::move(variables), std::move(implies)));
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const BenchmarkRegistration benchmarkArenaAST("arena/ast",
+	[]()
+	{
+		ast::PredicateDeclaration p("p", NumberOfVariables);
+		ast::PredicateDeclaration q("q", 1);
+
+		report("arena/ast", "heap", measure(
+			[&]()
+			{
+				buildAndDestroyFormulas(&p, &q);
+			}));
+
+		report("arena/ast", "arena", measure(
+			[&]()
+			{
+				Arena arena;
+				ArenaScope arenaScope(&arena);
+
+				buildAndDestroyFormulas(&p, &q);
+			}));
+	});
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void translateRules(const std::string &program, bool allocateFromArena)
+{
+	std::stringstream input(program);
+	std::stringstream output;
+	std::stringstream errors;
+
+	output::Logger logger(output, errors);
+	Context context(std::move(logger));
+	context.translationMode = TranslationMode::Completion;
+	context.performCompletion = true;
+	context.performSimplification = true;
+	context.allocateFromArena = allocateFromArena;
+
+	translate("benchmark", input, context);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const BenchmarkRegistration benchmarkArenaTranslation("arena/translation",
+	[]()
+	{
+		std::stringstream program;
+
+		for (size_t i = 0; i < NumberOfRules; i++)
+			program << "p" << (i % 100) << "(X, Y) :- q" << i << "(X, Z), not r(Z, Y), X < Y.\n";
+
+		report("arena/translation", "heap", measure(
+			[&]()
+			{
+				translateRules(program.str(), false);
+			}));
+
+		report("arena/translation", "arena", measure(
+			[&]()
+			{
+				translateRules(program.str(), true);
+			}));
+	});
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+}
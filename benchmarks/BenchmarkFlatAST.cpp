@@ -0,0 +1,152 @@
+#include <sstream>
+
+#include <anthem/AST.h>
+#include <anthem/Context.h>
+#include <anthem/Evaluation.h>
+#include <anthem/FlatAST.h>
+#include <anthem/output/FormatterHumanReadable.h>
+
+#include "Benchmark.h"
+
+namespace anthem
+{
+namespace benchmarks
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// BenchmarkFlatAST
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+constexpr size_t NumberOfCompletedFormulas = 20000;
+constexpr size_t NumberOfDisjuncts = 8;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Builds formulas shaped like completed definitions:
+// “forall X1 X2 (p(X1, X2) <-> exists Y (q(X1, Y) and X2 < Y + 1) or exists Y (...) or ...)”
+std::vector<ast::Formula> buildCompletedFormulas(Context &context)
+{
+	auto *p = context.findOrCreatePredicateDeclaration("p", 2);
+	auto *q = context.findOrCreatePredicateDeclaration("q", 2);
+
+	std::vector<ast::Formula> formulas;
+	formulas.reserve(NumberOfCompletedFormulas);
+
+	for (size_t i = 0; i < NumberOfCompletedFormulas; i++)
+	{
+		ast::VariableDeclarationPointers parameters;
+		parameters.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::Head));
+		parameters.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::Head));
+
+		auto *x1 = parameters[0].get();
+		auto *x2 = parameters[1].get();
+
+		std::vector<ast::Formula> disjuncts;
+
+		for (size_t j = 0; j < NumberOfDisjuncts; j++)
+		{
+			ast::VariableDeclarationPointers variables;
+			variables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::Body));
+
+			auto *y = variables[0].get();
+
+			std::vector<ast::Term> qArguments;
+			qArguments.emplace_back(ast::Variable(x1));
+			qArguments.emplace_back(ast::Variable(y));
+
+			std::vector<ast::Formula> conjuncts;
+			conjuncts.emplace_back(ast::Predicate(q, std::move(qArguments)));
+			conjuncts.emplace_back(ast::Comparison(ast::Comparison::Operator::LessThan, ast::Variable(x2),
+				ast::BinaryOperation(ast::BinaryOperation::Operator::Plus, ast::Variable(y), ast::Integer(j))));
+
+			disjuncts.emplace_back(ast::Exists(std::move(variables), ast::And(std::move(conjuncts))));
+		}
+
+		std::vector<ast::Term> pArguments;
+		pArguments.emplace_back(ast::Variable(x1));
+		pArguments.emplace_back(ast::Variable(x2));
+
+		ast::Formula biconditional = ast::Biconditional(ast::Predicate(p, std::move(pArguments)), ast::Or(std::move(disjuncts)));
+		formulas.emplace_back(ast::ForAll(std::move(parameters), std::move(biconditional)));
+	}
+
+	return formulas;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const BenchmarkRegistration benchmarkFlatAST("flat-ast",
+	[]()
+	{
+		Context context;
+		const auto formulas = buildCompletedFormulas(context);
+
+		flat::Tree tree;
+		std::vector<flat::NodeIndex> roots;
+		roots.reserve(formulas.size());
+
+		report("flat-ast/convert", "to flat", measure(
+			[&]()
+			{
+				tree = flat::Tree();
+				roots.clear();
+
+				for (const auto &formula : formulas)
+					roots.emplace_back(tree.add(formula));
+			}, 1));
+
+		volatile size_t numberOfUnknownResults = 0;
+
+		report("flat-ast/evaluate", "ast", measure(
+			[&]()
+			{
+				for (const auto &formula : formulas)
+					numberOfUnknownResults = numberOfUnknownResults + (evaluate(formula) == EvaluationResult::Unknown);
+			}));
+
+		report("flat-ast/evaluate", "flat", measure(
+			[&]()
+			{
+				for (const auto root : roots)
+					numberOfUnknownResults = numberOfUnknownResults + (evaluate(tree, root) == EvaluationResult::Unknown);
+			}));
+
+		const auto printAll =
+			[&](const auto &values)
+			{
+				std::stringstream output;
+				output::ColorStream stream(output);
+				output::PrintContext printContext(context);
+
+				for (const auto &value : values)
+				{
+					output::print<output::FormatterHumanReadable>(stream, value, printContext);
+					stream << "\n";
+				}
+			};
+
+		std::vector<flat::Node> nodes;
+		nodes.reserve(roots.size());
+
+		for (const auto root : roots)
+			nodes.push_back({tree, root});
+
+		report("flat-ast/print", "ast", measure(
+			[&]()
+			{
+				printAll(formulas);
+			}));
+
+		report("flat-ast/print", "flat", measure(
+			[&]()
+			{
+				printAll(nodes);
+			}));
+	});
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+}
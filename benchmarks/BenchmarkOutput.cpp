@@ -0,0 +1,61 @@
+#include <fstream>
+
+#include <anthem/AST.h>
+#include <anthem/Context.h>
+#include <anthem/output/FormatterHumanReadable.h>
+
+#include "Benchmark.h"
+
+namespace anthem
+{
+namespace benchmarks
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// BenchmarkOutput
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const BenchmarkRegistration benchmarkOutput("output",
+	[]()
+	{
+		Context context;
+		const auto formulas = buildCompletedFormulas(context);
+
+		const auto printAll =
+			[&](bool enableBuffering)
+			{
+				std::ofstream file("/dev/null", std::ios::out);
+				output::ColorStream stream(file);
+				output::PrintContext printContext(context);
+
+				if (enableBuffering)
+					stream.enableBuffering();
+
+				for (const auto &formula : formulas)
+				{
+					output::print<output::FormatterHumanReadable>(stream, formula, printContext);
+					stream << "\n";
+				}
+
+				stream.flush();
+			};
+
+		report("output/print", "unbuffered", measure(
+			[&]()
+			{
+				printAll(false);
+			}));
+
+		report("output/print", "buffered", measure(
+			[&]()
+			{
+				printAll(true);
+			}));
+	});
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+}
@@ -0,0 +1,331 @@
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <clingo.hh>
+
+#include <anthem/AST.h>
+#include <anthem/Completion.h>
+#include <anthem/Context.h>
+#include <anthem/Exception.h>
+#include <anthem/HiddenPredicateElimination.h>
+#include <anthem/IntegerVariableDetection.h>
+#include <anthem/MapDomains.h>
+#include <anthem/Simplification.h>
+#include <anthem/StatementVisitor.h>
+#include <anthem/ThreadPool.h>
+#include <anthem/output/FormatterHumanReadable.h>
+#include <anthem/output/FormatterTPTP.h>
+
+#include "Benchmark.h"
+
+namespace anthem
+{
+namespace benchmarks
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// BenchmarkPasses
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+constexpr size_t ScalingFactor = 500;
+
+// Examples that can be translated in completion mode
+constexpr const char *ExampleNames[] =
+{
+	"choice-rules",
+	"graph-coloring",
+	"hide-circular-dependency",
+	"letters",
+	"nested-arguments",
+	"permutations",
+	"prime",
+	"propositions",
+	"schur-numbers",
+	"simple-external",
+	"simple-external-show",
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::string readExample(const char *name)
+{
+	const auto fileName = std::string(ANTHEM_EXAMPLES_DIRECTORY) + "/" + name + ".lp";
+	std::ifstream file(fileName, std::ios::in);
+
+	if (!file.is_open())
+		throw LogicException("could not read file “" + fileName + "”");
+
+	std::stringstream program;
+	program << file.rdbuf();
+
+	return program.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::string scaleProgram(const std::string &program, size_t factor)
+{
+	const auto isIdentifierCharacter =
+		[](char character)
+		{
+			return std::isalnum(static_cast<unsigned char>(character)) || character == '_' || character == '\'';
+		};
+
+	std::string scaledProgram;
+	scaledProgram.reserve(factor * (program.size() + 64));
+
+	for (size_t i = 0; i < factor; i++)
+	{
+		const auto suffix = "_" + std::to_string(i);
+
+		for (size_t position = 0; position < program.size();)
+		{
+			const auto character = program[position];
+
+			// Drop comments
+			if (character == '%')
+			{
+				position = program.find('\n', position);
+
+				if (position == std::string::npos)
+					break;
+
+				continue;
+			}
+
+			if (!isIdentifierCharacter(character) && character != '#')
+			{
+				scaledProgram += character;
+				position++;
+				continue;
+			}
+
+			auto end = position + 1;
+
+			while (end < program.size() && isIdentifierCharacter(program[end]))
+				end++;
+
+			const auto word = program.substr(position, end - position);
+			scaledProgram += word;
+
+			// Directives, variables, and numbers keep their names
+			if (std::islower(static_cast<unsigned char>(character)) && word != "not")
+				scaledProgram += suffix;
+
+			position = end;
+		}
+
+		scaledProgram += "\n";
+	}
+
+	return scaledProgram;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The passes of the completion pipeline in the order in which they run
+enum class Pass
+{
+	Parse,
+	Complete,
+	EliminateHiddenPredicates,
+	DetectIntegerVariables,
+	Simplify,
+	PrintHumanReadable,
+	MapDomains,
+	PrintTPTP,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct PassState
+{
+	std::unique_ptr<Context> context;
+	std::vector<ast::ScopedFormula> scopedFormulas;
+	std::vector<ast::Formula> completedFormulas;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class Formatter>
+void printFormulas(const std::vector<ast::Formula> &formulas, const Context &context)
+{
+	std::ofstream file("/dev/null", std::ios::out);
+	output::ColorStream stream(file);
+	output::PrintContext printContext(context);
+
+	stream.enableBuffering();
+
+	for (const auto &formula : formulas)
+	{
+		output::print<Formatter>(stream, formula, printContext);
+		stream << "\n";
+	}
+
+	stream.flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void runPass(Pass pass, const std::string &program, PassState &state)
+{
+	auto &context = *state.context;
+
+	switch (pass)
+	{
+		case Pass::Parse:
+		{
+			const auto translateStatement =
+				[&](const Clingo::AST::Statement &statement)
+				{
+					statement.data.accept(StatementVisitor(), statement, state.scopedFormulas, context);
+				};
+
+			const auto logger =
+				[](const Clingo::WarningCode, const char *)
+				{
+				};
+
+			Clingo::parse_program(program.c_str(), translateStatement, logger);
+			return;
+		}
+		case Pass::Complete:
+		{
+			// Hidden predicates are eliminated in a pass of their own
+			const auto defaultPredicateVisibility = context.defaultPredicateVisibility;
+			context.defaultPredicateVisibility = ast::PredicateDeclaration::Visibility::Visible;
+
+			ThreadPool threadPool(1);
+			state.completedFormulas = complete(std::move(state.scopedFormulas), context, threadPool);
+
+			context.defaultPredicateVisibility = defaultPredicateVisibility;
+			return;
+		}
+		case Pass::EliminateHiddenPredicates:
+			eliminateHiddenPredicates(state.completedFormulas, context);
+			return;
+		case Pass::DetectIntegerVariables:
+			detectIntegerVariables(state.completedFormulas);
+			return;
+		case Pass::Simplify:
+			for (auto &completedFormula : state.completedFormulas)
+				simplify(completedFormula);
+			return;
+		case Pass::PrintHumanReadable:
+			printFormulas<output::FormatterHumanReadable>(state.completedFormulas, context);
+			return;
+		case Pass::MapDomains:
+			for (auto &completedFormula : state.completedFormulas)
+				mapDomains(completedFormula, context);
+			return;
+		case Pass::PrintTPTP:
+			printFormulas<output::FormatterTPTP>(state.completedFormulas, context);
+			return;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Measures one pass on each scaled-up example, after running the passes before it
+void benchmarkPass(const char *name, Pass pass)
+{
+	for (const auto *exampleName : ExampleNames)
+	{
+		PassState state;
+
+		const auto prepare =
+			[&](const std::string &program)
+			{
+				state.completedFormulas.clear();
+				state.scopedFormulas.clear();
+				state.context = std::make_unique<Context>();
+				state.context->translationMode = TranslationMode::Completion;
+
+				for (auto i = 0; i < static_cast<int>(pass); i++)
+				{
+					const auto previousPass = static_cast<Pass>(i);
+
+					if (previousPass != Pass::PrintHumanReadable)
+						runPass(previousPass, program, state);
+				}
+			};
+
+		try
+		{
+			const auto program = scaleProgram(readExample(exampleName), ScalingFactor);
+
+			report(name, exampleName, measure(
+				[&]()
+				{
+					prepare(program);
+				},
+				[&]()
+				{
+					runPass(pass, program, state);
+				}));
+		}
+		catch (const std::exception &exception)
+		{
+			std::cerr << name << " skipped for “" << exampleName << "”: " << exception.what() << std::endl;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const BenchmarkRegistration benchmarkParse("passes/parse",
+	[]()
+	{
+		benchmarkPass("passes/parse", Pass::Parse);
+	});
+
+const BenchmarkRegistration benchmarkComplete("passes/complete",
+	[]()
+	{
+		benchmarkPass("passes/complete", Pass::Complete);
+	});
+
+const BenchmarkRegistration benchmarkEliminateHiddenPredicates("passes/eliminate-hidden-predicates",
+	[]()
+	{
+		benchmarkPass("passes/eliminate-hidden-predicates", Pass::EliminateHiddenPredicates);
+	});
+
+const BenchmarkRegistration benchmarkDetectIntegerVariables("passes/detect-integer-variables",
+	[]()
+	{
+		benchmarkPass("passes/detect-integer-variables", Pass::DetectIntegerVariables);
+	});
+
+const BenchmarkRegistration benchmarkSimplify("passes/simplify",
+	[]()
+	{
+		benchmarkPass("passes/simplify", Pass::Simplify);
+	});
+
+const BenchmarkRegistration benchmarkPrintHumanReadable("passes/print-human-readable",
+	[]()
+	{
+		benchmarkPass("passes/print-human-readable", Pass::PrintHumanReadable);
+	});
+
+const BenchmarkRegistration benchmarkMapDomains("passes/map-domains",
+	[]()
+	{
+		benchmarkPass("passes/map-domains", Pass::MapDomains);
+	});
+
+const BenchmarkRegistration benchmarkPrintTPTP("passes/print-tptp",
+	[]()
+	{
+		benchmarkPass("passes/print-tptp", Pass::PrintTPTP);
+	});
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+}
@@ -0,0 +1,91 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <anthem/Context.h>
+#include <anthem/ProgramGenerator.h>
+#include <anthem/Translation.h>
+
+#include "Benchmark.h"
+
+namespace anthem
+{
+namespace benchmarks
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// BenchmarkSweep
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+constexpr size_t NumbersOfPredicates[] = {250, 500, 1000, 2000, 4000, 8000};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Translates generated programs of growing size in completion mode, reporting the time, the memory of
+// the AST nodes, and the peak resident set size for each size. As the sizes grow, the peak of the
+// process is reached by the current size
+void sweep(const char *name, ProgramGeneratorOptions options)
+{
+	for (const auto numberOfPredicates : NumbersOfPredicates)
+	{
+		options.numberOfPredicates = numberOfPredicates;
+
+		const auto program = generateProgram(options);
+		const auto variant = std::to_string(numberOfPredicates) + " predicates";
+
+		Memory memory{0, 0};
+
+		try
+		{
+			const auto duration = measure(
+				[&]()
+				{
+					std::ofstream file("/dev/null", std::ios::out);
+					Context context{output::Logger(output::ColorStream(file), output::ColorStream(std::cerr))};
+					context.logger.setLogPriority(output::Priority::Error);
+					context.logger.outputStream().enableBuffering();
+					context.translationMode = TranslationMode::Completion;
+
+					translate(std::vector<ProgramText>{{"generated", program}}, context);
+
+					memory.arenaBytes = context.arena.capacity();
+
+					for (const auto &adoptedArena : context.adoptedArenas)
+						memory.arenaBytes += adoptedArena->capacity();
+				}, 3);
+
+			memory.peakResidentBytes = peakResidentBytes();
+
+			report(name, variant.c_str(), duration, memory);
+		}
+		catch (const std::exception &exception)
+		{
+			std::cerr << name << " skipped for " << variant << ": " << exception.what() << std::endl;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const BenchmarkRegistration benchmarkSweep("sweep/visible",
+	[]()
+	{
+		sweep("sweep/visible", ProgramGeneratorOptions());
+	});
+
+const BenchmarkRegistration benchmarkSweepHidden("sweep/hidden",
+	[]()
+	{
+		ProgramGeneratorOptions options;
+		options.choiceRuleShare = 0.0;
+		options.showDensity = 0.5;
+
+		sweep("sweep/hidden", options);
+	});
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+}
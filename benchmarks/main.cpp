@@ -0,0 +1,219 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+
+#include <sys/resource.h>
+
+#include <anthem/Version.h>
+
+#include "Benchmark.h"
+
+namespace anthem
+{
+namespace benchmarks
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Benchmark
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Result
+{
+	std::string benchmark;
+	std::string variant;
+	double milliseconds;
+	std::optional<Memory> memory;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Only set if the results are printed as JSON once all benchmarks ran
+std::vector<Result> *recordedResults = nullptr;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::vector<Benchmark> &registeredBenchmarks()
+{
+	static std::vector<Benchmark> benchmarks;
+
+	return benchmarks;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::chrono::duration<double, std::milli> measure(const std::function<void()> &function, size_t repetitions)
+{
+	return measure([]() {}, function, repetitions);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::chrono::duration<double, std::milli> measure(const std::function<void()> &prepare,
+	const std::function<void()> &function, size_t repetitions)
+{
+	std::vector<std::chrono::duration<double, std::milli>> durations;
+	durations.reserve(repetitions);
+
+	for (size_t i = 0; i < repetitions; i++)
+	{
+		prepare();
+
+		const auto start = std::chrono::steady_clock::now();
+		function();
+		durations.emplace_back(std::chrono::steady_clock::now() - start);
+	}
+
+	std::sort(durations.begin(), durations.end());
+
+	return durations[durations.size() / 2];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void report(const Result &result)
+{
+	if (recordedResults)
+	{
+		recordedResults->push_back(result);
+		return;
+	}
+
+	std::cout
+		<< std::left << std::setw(32) << result.benchmark
+		<< std::setw(24) << result.variant
+		<< std::right << std::fixed << std::setprecision(3) << std::setw(12) << result.milliseconds << " ms";
+
+	const auto toMebibytes =
+		[](size_t bytes)
+		{
+			return bytes / (1024.0 * 1024.0);
+		};
+
+	if (result.memory)
+		std::cout
+			<< std::setw(12) << toMebibytes(result.memory->arenaBytes) << " MiB in arenas"
+			<< std::setw(12) << toMebibytes(result.memory->peakResidentBytes) << " MiB peak resident";
+
+	std::cout << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void report(const char *benchmark, const char *variant, std::chrono::duration<double, std::milli> duration)
+{
+	report({benchmark, variant, duration.count(), std::nullopt});
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void report(const char *benchmark, const char *variant, std::chrono::duration<double, std::milli> duration,
+	const Memory &memory)
+{
+	report({benchmark, variant, duration.count(), memory});
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t peakResidentBytes()
+{
+	rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+
+	// Reported in kilobytes on Linux, but in bytes on macOS
+#ifdef __APPLE__
+	return static_cast<size_t>(usage.ru_maxrss);
+#else
+	return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void writeJSONString(std::ostream &stream, const std::string &string)
+{
+	stream << "\"";
+
+	for (const auto character : string)
+	{
+		if (character == '"' || character == '\\')
+			stream << "\\";
+
+		stream << character;
+	}
+
+	stream << "\"";
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Prints the results as a JSON object, one result per line, to compare them across versions
+void writeJSON(std::ostream &stream, const std::vector<Result> &results)
+{
+	stream << "{\n\t\"version\": ";
+	writeJSONString(stream, Version);
+	stream << ",\n\t\"results\":\n\t[";
+
+	for (auto i = results.cbegin(); i != results.cend(); i++)
+	{
+		stream << ((i == results.cbegin()) ? "\n" : ",\n") << "\t\t{\"benchmark\": ";
+		writeJSONString(stream, i->benchmark);
+		stream << ", \"variant\": ";
+		writeJSONString(stream, i->variant);
+		stream << ", \"milliseconds\": " << std::fixed << std::setprecision(6) << i->milliseconds;
+
+		if (i->memory)
+			stream
+				<< ", \"arenaBytes\": " << i->memory->arenaBytes
+				<< ", \"peakResidentBytes\": " << i->memory->peakResidentBytes;
+
+		stream << "}";
+	}
+
+	stream << "\n\t]\n}" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Runs all benchmarks whose names start with one of the given prefixes (all benchmarks if none are
+// given). With “--json”, the results are printed as a JSON object instead of a table
+int main(int argc, char **argv)
+{
+	std::vector<const char *> prefixes;
+	std::vector<anthem::benchmarks::Result> results;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (std::strcmp(argv[i], "--json") == 0)
+			anthem::benchmarks::recordedResults = &results;
+		else
+			prefixes.push_back(argv[i]);
+	}
+
+	for (const auto &benchmark : anthem::benchmarks::registeredBenchmarks())
+	{
+		const auto isSelected = prefixes.empty() || std::any_of(prefixes.cbegin(), prefixes.cend(),
+			[&](const char *prefix)
+			{
+				return std::strncmp(benchmark.name, prefix, std::strlen(prefix)) == 0;
+			});
+
+		if (isSelected)
+			benchmark.run();
+	}
+
+	if (anthem::benchmarks::recordedResults)
+		anthem::benchmarks::writeJSON(std::cout, results);
+
+	return EXIT_SUCCESS;
+}
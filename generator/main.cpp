@@ -0,0 +1,71 @@
+#include <iostream>
+
+#include <cxxopts.hpp>
+
+#include <anthem/ProgramGenerator.h>
+
+int main(int argc, char **argv)
+{
+	cxxopts::Options options("anthem-generate", "Generate random ASP programs of a given size for load testing anthem.");
+
+	options.add_options()
+		("h,help", "Display this help message")
+		("predicates", "Number of predicates", cxxopts::value<size_t>()->default_value("10"))
+		("rules-per-predicate", "Number of rules defining each predicate that is not #external", cxxopts::value<size_t>()->default_value("3"))
+		("body-length", "Number of literals in rule bodies", cxxopts::value<size_t>()->default_value("2"))
+		("arity", "Arity of the predicates", cxxopts::value<size_t>()->default_value("2"))
+		("choice-rules", "Share of choice rules among the rules", cxxopts::value<double>()->default_value("0.1"))
+		("pools", "Share of pools among the arguments", cxxopts::value<double>()->default_value("0.05"))
+		("intervals", "Share of intervals among the arguments", cxxopts::value<double>()->default_value("0.1"))
+		("show-density", "Share of predicates that are shown (all predicates are shown without #show statements if 1)", cxxopts::value<double>()->default_value("1"))
+		("external-density", "Share of predicates that are declared #external", cxxopts::value<double>()->default_value("0.1"))
+		("seed", "Seed for the random choices", cxxopts::value<uint32_t>()->default_value("0"));
+
+	const auto printHelp =
+		[&]()
+		{
+			std::cout << options.help();
+		};
+
+	anthem::ProgramGeneratorOptions generatorOptions;
+
+	try
+	{
+		const auto parseResult = options.parse(argc, argv);
+
+		if (parseResult.count("help") > 0)
+		{
+			printHelp();
+			return EXIT_SUCCESS;
+		}
+
+		generatorOptions.numberOfPredicates = parseResult["predicates"].as<size_t>();
+		generatorOptions.rulesPerPredicate = parseResult["rules-per-predicate"].as<size_t>();
+		generatorOptions.bodyLength = parseResult["body-length"].as<size_t>();
+		generatorOptions.arity = parseResult["arity"].as<size_t>();
+		generatorOptions.choiceRuleShare = parseResult["choice-rules"].as<double>();
+		generatorOptions.poolShare = parseResult["pools"].as<double>();
+		generatorOptions.intervalShare = parseResult["intervals"].as<double>();
+		generatorOptions.showDensity = parseResult["show-density"].as<double>();
+		generatorOptions.externalDensity = parseResult["external-density"].as<double>();
+		generatorOptions.seed = parseResult["seed"].as<uint32_t>();
+	}
+	catch (const std::exception &exception)
+	{
+		std::cerr << "error: " << exception.what() << std::endl;
+		printHelp();
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		std::cout << anthem::generateProgram(generatorOptions);
+	}
+	catch (const std::exception &exception)
+	{
+		std::cerr << "error: " << exception.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -1,6 +1,7 @@
 #ifndef __ANTHEM__AST_H
 #define __ANTHEM__AST_H
 
+#include <anthem/Arena.h>
 #include <anthem/ASTForward.h>
 #include <anthem/Utils.h>
 
@@ -25,7 +26,7 @@ inline bool isPrimitive(const Term &term)
 // Primitives
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct BinaryOperation
+struct BinaryOperation : public ArenaAllocated
 {
 	enum class Operator
 	{
@@ -56,7 +57,7 @@ struct BinaryOperation
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct Boolean
+struct Boolean : public ArenaAllocated
 {
 	explicit Boolean(bool value)
 	:	value{value}
@@ -73,7 +74,7 @@ struct Boolean
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct Comparison
+struct Comparison : public ArenaAllocated
 {
 	enum class Operator
 	{
@@ -104,7 +105,7 @@ struct Comparison
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct Function
+struct Function : public ArenaAllocated
 {
 	explicit Function(FunctionDeclaration *declaration)
 	:	declaration{declaration}
@@ -164,7 +165,7 @@ struct FunctionDeclaration
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // TODO: refactor (limit element type to primitive terms)
-struct In
+struct In : public ArenaAllocated
 {
 	explicit In(Term &&element, Term &&set)
 	:	element{std::move(element)},
@@ -185,7 +186,7 @@ struct In
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct Integer
+struct Integer : public ArenaAllocated
 {
 	explicit Integer(int value)
 	:	value{value}
@@ -202,7 +203,7 @@ struct Integer
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct Interval
+struct Interval : public ArenaAllocated
 {
 	explicit Interval(Term &&from, Term &&to)
 	:	from{std::move(from)},
@@ -221,7 +222,7 @@ struct Interval
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct Predicate
+struct Predicate : public ArenaAllocated
 {
 	explicit Predicate(PredicateDeclaration *declaration)
 	:	declaration{declaration}
@@ -280,11 +281,13 @@ struct PredicateDeclaration
 	bool isUsed{false};
 	bool isExternal{false};
 	Visibility visibility{Visibility::Default};
+	// Hidden predicate whose definition is kept instead of being substituted for its occurrences
+	bool isAbbreviation{false};
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct SpecialInteger
+struct SpecialInteger : public ArenaAllocated
 {
 	enum class Type
 	{
@@ -307,7 +310,7 @@ struct SpecialInteger
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct String
+struct String : public ArenaAllocated
 {
 	explicit String(std::string &&text)
 	:	text{std::move(text)}
@@ -324,7 +327,7 @@ struct String
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct UnaryOperation
+struct UnaryOperation : public ArenaAllocated
 {
 	enum class Operator
 	{
@@ -349,7 +352,7 @@ struct UnaryOperation
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct Variable
+struct Variable : public ArenaAllocated
 {
 	explicit Variable(VariableDeclaration *declaration)
 	:	declaration{declaration}
@@ -366,7 +369,7 @@ struct Variable
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct VariableDeclaration
+struct VariableDeclaration : public ArenaAllocated
 {
 	enum class Type
 	{
@@ -407,7 +410,7 @@ struct VariableDeclaration
 // Expressions
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct And
+struct And : public ArenaAllocated
 {
 	And() = default;
 
@@ -426,7 +429,7 @@ struct And
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct Biconditional
+struct Biconditional : public ArenaAllocated
 {
 	explicit Biconditional(Formula &&left, Formula &&right)
 	:	left{std::move(left)},
@@ -445,7 +448,7 @@ struct Biconditional
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct Exists
+struct Exists : public ArenaAllocated
 {
 	// TODO: rename “variables”
 	explicit Exists(VariableDeclarationPointers &&variables, Formula &&argument)
@@ -465,7 +468,7 @@ struct Exists
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct ForAll
+struct ForAll : public ArenaAllocated
 {
 	explicit ForAll(VariableDeclarationPointers &&variables, Formula &&argument)
 	:	variables{std::move(variables)},
@@ -484,7 +487,7 @@ struct ForAll
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct Implies
+struct Implies : public ArenaAllocated
 {
 	explicit Implies(Formula &&antecedent, Formula &&consequent)
 	:	antecedent{std::move(antecedent)},
@@ -503,7 +506,7 @@ struct Implies
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct Not
+struct Not : public ArenaAllocated
 {
 	explicit Not(Formula &&argument)
 	:	argument{std::move(argument)}
@@ -520,7 +523,7 @@ struct Not
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct Or
+struct Or : public ArenaAllocated
 {
 	Or() = default;
 
@@ -51,6 +51,13 @@ std::vector<Formula> prepareCopy(const std::vector<Formula> &formulas);
 
 void fixDanglingVariables(ScopedFormula &scopedFormula);
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copying Scoped Formulas
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Copies the formula along with its free variables, which the copy refers to instead of the original ones
+ScopedFormula copy(const ScopedFormula &scopedFormula);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 }
@@ -2,6 +2,7 @@
 #define __ANTHEM__AST_UTILS_H
 
 #include <optional>
+#include <unordered_map>
 
 #include <anthem/AST.h>
 #include <anthem/ASTVisitors.h>
@@ -38,53 +39,48 @@ class VariableStack
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-// Replacing Variables
+// Counting Nodes
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-// Replaces all occurrences of a variable in a given term with another term
-struct ReplaceVariableInTermVisitor : public RecursiveTermVisitor<ReplaceVariableInTermVisitor>
-{
-	static void accept(Variable &variable, Term &, const VariableDeclaration *original, VariableDeclaration *replacement)
-	{
-		if (variable.declaration == original)
-			variable.declaration = replacement;
-	}
-
-	// Ignore all other types of expressions
-	template<class T>
-	static void accept(T &, Term &, const VariableDeclaration *, VariableDeclaration *)
-	{
-	}
-};
+// Counts the formulas and terms that a formula consists of, including the formula itself
+size_t countNodes(Formula &formula);
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Substituting Variables
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-// Replaces all occurrences of a variable in a given formula with a term
-struct ReplaceVariableInFormulaVisitor : public RecursiveFormulaVisitor<ReplaceVariableInFormulaVisitor>
+// Replaces several variables with other variables or terms in a single traversal
+// The result is the same as replacing the variables one after the other in the order in which they were added
+// Replacements are looked up in a table owned by the substitution, so several substitutions may share variables
+class VariableSubstitution
 {
-	static void accept(Comparison &comparison, Formula &, const VariableDeclaration *original, VariableDeclaration *replacement)
-	{
-		comparison.left.accept(ReplaceVariableInTermVisitor(), comparison.left, original, replacement);
-		comparison.right.accept(ReplaceVariableInTermVisitor(), comparison.right, original, replacement);
-	}
+	public:
+		void add(const VariableDeclaration &original, VariableDeclaration &replacement);
+		void add(const VariableDeclaration &original, Term &&replacement);
 
-	static void accept(In &in, Formula &, const VariableDeclaration *original, VariableDeclaration *replacement)
-	{
-		in.element.accept(ReplaceVariableInTermVisitor(), in.element, original, replacement);
-		in.set.accept(ReplaceVariableInTermVisitor(), in.set, original, replacement);
-	}
+		// Returns the term replacing a variable, or nullptr if the variable isn’t replaced
+		const Term *find(const VariableDeclaration &variableDeclaration) const;
 
-	static void accept(Predicate &predicate, Formula &, const VariableDeclaration *original, VariableDeclaration *replacement)
-	{
-		for (auto &argument : predicate.arguments)
-			argument.accept(ReplaceVariableInTermVisitor(), argument, original, replacement);
-	}
+		void apply(Formula &formula) const;
+		void apply(Term &term) const;
 
-	// Ignore all other types of expressions
-	template<class T>
-	static void accept(T &, Formula &, const VariableDeclaration *, VariableDeclaration *)
-	{
-	}
+	private:
+		friend struct SubstituteVariablesInTermVisitor;
+
+		struct Replacement
+		{
+			const VariableDeclaration *original;
+			Term term;
+		};
+
+		// Below this number of replacements, searching them is cheaper than looking them up in the index
+		static constexpr size_t MaximumNumberOfReplacementsSearchedDirectly = 8;
+
+		std::optional<size_t> findSlot(const VariableDeclaration &variableDeclaration) const;
+
+		std::vector<Replacement> m_replacements;
+		// Slots of the replaced variables, only filled once there are too many replacements to search them directly
+		std::unordered_map<const VariableDeclaration *, size_t> m_slots;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
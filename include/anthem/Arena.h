@@ -0,0 +1,108 @@
+#ifndef __ANTHEM__ARENA_H
+#define __ANTHEM__ARENA_H
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Arena
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Memory arena for AST nodes and variable declarations
+// Memory is carved out of large chunks and recycled through free lists per size class. All chunks are
+// released at once when the arena is destroyed, so the arena must outlive all objects allocated from it.
+// An arena is not thread-safe and only serves allocations of the thread on which it is active. Objects
+// deleted while another arena (or none) is active are not recycled, their memory is only released along
+// with the arena, which is why worker threads allocate from arenas of their own (see ThreadPool)
+class Arena
+{
+	public:
+		// Larger allocations are served by the heap
+		static constexpr size_t MaximumAllocationSize = 256;
+
+	public:
+		Arena() = default;
+
+		Arena(const Arena &other) = delete;
+		Arena &operator=(const Arena &other) = delete;
+
+		// Returns the arena active on the current thread, if any
+		static Arena *active();
+
+		void *allocate(size_t size);
+		void deallocate(void *pointer, size_t size);
+
+		// Takes over the chunks of another arena for reuse, all objects allocated from it must be destroyed
+		void reclaim(Arena &other);
+		// Returns reclaimed chunks that are not in use to the system until the capacity doesn’t exceed the
+		// given one
+		void trim(size_t maximumCapacity);
+
+		// Total size of all chunks requested from the system
+		size_t capacity() const noexcept;
+
+	private:
+		static constexpr size_t Granularity = 16;
+		static constexpr size_t ChunkSize = 64 * 1024;
+
+		struct FreeBlock
+		{
+			FreeBlock *next;
+		};
+
+		std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+		// Chunks that were reclaimed from other arenas and are used before requesting new ones
+		std::vector<std::unique_ptr<std::byte[]>> m_spareChunks;
+		std::byte *m_chunkPosition{nullptr};
+		std::byte *m_chunkEnd{nullptr};
+
+		std::array<FreeBlock *, MaximumAllocationSize / Granularity + 1> m_freeLists{};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Activates an arena on the current thread for the lifetime of the scope
+class ArenaScope
+{
+	public:
+		explicit ArenaScope(Arena *arena);
+		~ArenaScope();
+
+		ArenaScope(const ArenaScope &other) = delete;
+		ArenaScope &operator=(const ArenaScope &other) = delete;
+
+	private:
+		Arena *m_previousArena;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Base for types whose instances are allocated from the active arena (if any) instead of the heap
+struct ArenaAllocated
+{
+	static void *operator new(size_t size);
+	static void operator delete(void *pointer, size_t size);
+
+	// The class-specific allocation functions hide the global placement form otherwise
+	static void *operator new(size_t, void *place) noexcept
+	{
+		return place;
+	}
+
+	static void operator delete(void *, void *) noexcept
+	{
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef __ANTHEM__BATCH_H
+#define __ANTHEM__BATCH_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <anthem/Context.h>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Batch
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// A translation of one or two input files whose output is written to a file
+struct BatchJob
+{
+	std::vector<std::string> inputFileNames;
+	std::string outputFileName;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Reads one job per line, consisting of the input files followed by the output file, separated by
+// whitespace. Empty lines and lines starting with “#” are ignored
+std::vector<BatchJob> readBatchJobs(const char *manifestName, std::istream &stream);
+
+// Runs each job with a fresh context configured like the given one, distributing the jobs over the
+// context’s number of threads. Output files are only written once their job succeeded, failed jobs
+// leave existing files untouched. Returns the number of failed jobs
+size_t runBatchJobs(const std::vector<BatchJob> &jobs, Context &context);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
@@ -0,0 +1,538 @@
+#ifndef __ANTHEM__BIT_PARALLEL_EVALUATION_H
+#define __ANTHEM__BIT_PARALLEL_EVALUATION_H
+
+#include <array>
+#include <cstdint>
+
+#include <anthem/AST.h>
+#include <anthem/Evaluation.h>
+#include <anthem/Type.h>
+#include <anthem/Utils.h>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// BitParallelEvaluation
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Evaluates a formula under up to 64 different assumptions about the variable domains in a single
+// traversal, each assumption occupying one bit (lane) of 64-bit words
+
+using Lanes = uint64_t;
+
+constexpr size_t NumberOfLanes = 64;
+constexpr Lanes AllLanes = ~Lanes(0);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The evaluation results of all lanes as a pair of bit planes. True and false lanes have their bit set
+// in one of the planes, erroneous lanes in both, and unknown lanes in neither
+struct EvaluationResultLanes
+{
+	static EvaluationResultLanes broadcast(EvaluationResult evaluationResult, Lanes lanes = AllLanes)
+	{
+		EvaluationResultLanes evaluationResultLanes;
+		evaluationResultLanes.add(evaluationResult, lanes);
+
+		return evaluationResultLanes;
+	}
+
+	void add(EvaluationResult evaluationResult, Lanes lanes)
+	{
+		if (evaluationResult == EvaluationResult::True || evaluationResult == EvaluationResult::Error)
+			isTrue |= lanes;
+
+		if (evaluationResult == EvaluationResult::False || evaluationResult == EvaluationResult::Error)
+			isFalse |= lanes;
+	}
+
+	Lanes true_() const
+	{
+		return isTrue & ~isFalse;
+	}
+
+	Lanes false_() const
+	{
+		return isFalse & ~isTrue;
+	}
+
+	Lanes unknown() const
+	{
+		return ~(isTrue | isFalse);
+	}
+
+	Lanes error() const
+	{
+		return isTrue & isFalse;
+	}
+
+	EvaluationResult operator[](size_t lane) const
+	{
+		const auto isLaneTrue = ((isTrue >> lane) & 1) != 0;
+		const auto isLaneFalse = ((isFalse >> lane) & 1) != 0;
+
+		if (isLaneTrue && isLaneFalse)
+			return EvaluationResult::Error;
+
+		if (isLaneTrue)
+			return EvaluationResult::True;
+
+		if (isLaneFalse)
+			return EvaluationResult::False;
+
+		return EvaluationResult::Unknown;
+	}
+
+	Lanes isTrue{0};
+	Lanes isFalse{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The types of all lanes with one bit plane per domain and per set size, so that the bit of each lane
+// is set in exactly one domain plane and one set size plane
+struct TypeLanes
+{
+	static TypeLanes broadcast(const Type &type, Lanes lanes = AllLanes)
+	{
+		TypeLanes typeLanes;
+		typeLanes.add(type, lanes);
+
+		return typeLanes;
+	}
+
+	void add(const Type &type, Lanes lanes)
+	{
+		domains[static_cast<size_t>(type.domain)] |= lanes;
+		setSizes[static_cast<size_t>(type.setSize)] |= lanes;
+	}
+
+	Lanes domain(Domain domain) const
+	{
+		return domains[static_cast<size_t>(domain)];
+	}
+
+	Lanes setSize(SetSize setSize) const
+	{
+		return setSizes[static_cast<size_t>(setSize)];
+	}
+
+	// Calls the function once for each type occurring in some lane, along with the lanes of that type
+	template <class Function>
+	void forEachType(Function function) const
+	{
+		for (size_t i = 0; i < domains.size(); i++)
+		{
+			if (domains[i] == 0)
+				continue;
+
+			for (size_t j = 0; j < setSizes.size(); j++)
+			{
+				const auto lanes = domains[i] & setSizes[j];
+
+				if (lanes != 0)
+					function(Type{static_cast<Domain>(i), static_cast<SetSize>(j)}, lanes);
+			}
+		}
+	}
+
+	Type operator[](size_t lane) const
+	{
+		Type type;
+
+		forEachType(
+			[&](const Type &laneType, Lanes lanes)
+			{
+				if (((lanes >> lane) & 1) != 0)
+					type = laneType;
+			});
+
+		return type;
+	}
+
+	std::array<Lanes, 3> domains{};
+	std::array<Lanes, 4> setSizes{};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Terms and atomic formulas take few distinct types across the lanes, so their rules are applied once
+// per combination of operand types instead of once per lane
+
+template <class Rule>
+TypeLanes applyTypeRule(Rule rule, const TypeLanes &argumentTypes)
+{
+	TypeLanes typeLanes;
+
+	argumentTypes.forEachType(
+		[&](const Type &argumentType, Lanes lanes)
+		{
+			typeLanes.add(rule(argumentType), lanes);
+		});
+
+	return typeLanes;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class Rule>
+TypeLanes applyTypeRule(Rule rule, const TypeLanes &leftTypes, const TypeLanes &rightTypes)
+{
+	TypeLanes typeLanes;
+
+	leftTypes.forEachType(
+		[&](const Type &leftType, Lanes leftLanes)
+		{
+			rightTypes.forEachType(
+				[&](const Type &rightType, Lanes rightLanes)
+				{
+					if ((leftLanes & rightLanes) != 0)
+						typeLanes.add(rule(leftType, rightType), leftLanes & rightLanes);
+				});
+		});
+
+	return typeLanes;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class Rule>
+EvaluationResultLanes applyEvaluationRule(Rule rule, const TypeLanes &leftTypes, const TypeLanes &rightTypes)
+{
+	EvaluationResultLanes evaluationResultLanes;
+
+	leftTypes.forEachType(
+		[&](const Type &leftType, Lanes leftLanes)
+		{
+			rightTypes.forEachType(
+				[&](const Type &rightType, Lanes rightLanes)
+				{
+					if ((leftLanes & rightLanes) != 0)
+						evaluationResultLanes.add(rule(leftType, rightType), leftLanes & rightLanes);
+				});
+		});
+
+	return evaluationResultLanes;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The results of composite formulas are computed for all lanes at once with bitwise operations,
+// following the same rules as the single-lane evaluation
+
+template <class ArgumentRange, class EvaluateArgument>
+EvaluationResultLanes evaluateAndLanes(const ArgumentRange &arguments, EvaluateArgument evaluateArgument)
+{
+	Lanes someError = 0;
+	Lanes someFalse = 0;
+	Lanes someUnknown = 0;
+
+	for (const auto &argument : arguments)
+	{
+		const auto result = evaluateArgument(argument);
+
+		someError |= result.error();
+		someFalse |= result.false_();
+		someUnknown |= result.unknown();
+
+		// Like with a single lane, stop once all lanes are erroneous
+		if (someError == AllLanes)
+			break;
+	}
+
+	const auto allTrue = ~(someError | someFalse | someUnknown);
+
+	return {someError | allTrue, someError | someFalse};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline EvaluationResultLanes evaluateBiconditionalLanes(const EvaluationResultLanes &leftResult, const EvaluationResultLanes &rightResult)
+{
+	const auto error = leftResult.error() | rightResult.error();
+	const auto known = ~(error | leftResult.unknown() | rightResult.unknown());
+	const auto equal = ~(leftResult.isTrue ^ rightResult.isTrue);
+
+	return {error | (known & equal), error | (known & ~equal)};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline EvaluationResultLanes evaluateImpliesLanes(const EvaluationResultLanes &antecedentResult, const EvaluationResultLanes &consequentResult)
+{
+	const auto error = antecedentResult.error() | consequentResult.error();
+	const auto true_ = antecedentResult.false_() | consequentResult.true_();
+	const auto false_ = antecedentResult.true_() & consequentResult.false_();
+
+	return {error | true_, error | (false_ & ~true_)};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline EvaluationResultLanes evaluateNotLanes(const EvaluationResultLanes &result)
+{
+	// Swapping the planes negates true and false lanes, while erroneous and unknown lanes stay the same
+	return {result.isFalse, result.isTrue};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class ArgumentRange, class EvaluateArgument>
+EvaluationResultLanes evaluateOrLanes(const ArgumentRange &arguments, EvaluateArgument evaluateArgument)
+{
+	Lanes someError = 0;
+	Lanes someTrue = 0;
+	Lanes someUnknown = 0;
+
+	for (const auto &argument : arguments)
+	{
+		const auto result = evaluateArgument(argument);
+
+		someError |= result.error();
+		someTrue |= result.true_();
+		someUnknown |= result.unknown();
+
+		if (someError == AllLanes)
+			break;
+	}
+
+	const auto allFalse = ~(someError | someTrue | someUnknown);
+
+	return {someError | someTrue, someError | allFalse};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class ArgumentRange, class TypesOfArgument>
+EvaluationResultLanes evaluatePredicateLanes(const ast::PredicateDeclaration &declaration, const ArgumentRange &arguments, TypesOfArgument typesOfArgument)
+{
+	assert(arguments.size() == declaration.arity());
+
+	Lanes error = 0;
+
+	for (size_t i = 0; i < arguments.size(); i++)
+	{
+		const auto &parameter = declaration.parameters[i];
+
+		if (parameter.domain != Domain::Integer)
+			continue;
+
+		const auto argumentTypes = typesOfArgument(arguments[i]);
+
+		error |= argumentTypes.domain(Domain::Symbolic) | argumentTypes.setSize(SetSize::Empty);
+	}
+
+	return {error, error};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class VariableTypesAccessor, class... Arguments>
+TypeLanes typeLanes(const ast::Term &term, Arguments &&... arguments);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The variable types accessor returns the types of a variable in all lanes
+template <class VariableTypesAccessor>
+struct TermTypeLanesVisitor
+{
+	template <class... Arguments>
+	static TypeLanes visit(const ast::BinaryOperation &binaryOperation, Arguments &&... arguments)
+	{
+		const auto leftTypes = typeLanes<VariableTypesAccessor>(binaryOperation.left, std::forward<Arguments>(arguments)...);
+		const auto rightTypes = typeLanes<VariableTypesAccessor>(binaryOperation.right, std::forward<Arguments>(arguments)...);
+
+		return applyTypeRule(
+			[&](const Type &leftType, const Type &rightType)
+			{
+				return binaryOperationType(binaryOperation.operator_, leftType, rightType);
+			},
+			leftTypes, rightTypes);
+	}
+
+	template <class... Arguments>
+	static TypeLanes visit(const ast::Boolean &, Arguments &&...)
+	{
+		return TypeLanes::broadcast({Domain::Symbolic, SetSize::Unit});
+	}
+
+	template <class... Arguments>
+	static TypeLanes visit(const ast::Function &function, Arguments &&...)
+	{
+		return TypeLanes::broadcast({function.declaration->domain, SetSize::Unit});
+	}
+
+	template <class... Arguments>
+	static TypeLanes visit(const ast::Integer &, Arguments &&...)
+	{
+		return TypeLanes::broadcast({Domain::Integer, SetSize::Unit});
+	}
+
+	template <class... Arguments>
+	static TypeLanes visit(const ast::Interval &interval, Arguments &&... arguments)
+	{
+		const auto fromTypes = typeLanes<VariableTypesAccessor>(interval.from, std::forward<Arguments>(arguments)...);
+		const auto toTypes = typeLanes<VariableTypesAccessor>(interval.to, std::forward<Arguments>(arguments)...);
+
+		return applyTypeRule(intervalType, fromTypes, toTypes);
+	}
+
+	template <class... Arguments>
+	static TypeLanes visit(const ast::SpecialInteger &, Arguments &&...)
+	{
+		return TypeLanes::broadcast({Domain::Symbolic, SetSize::Unit});
+	}
+
+	template <class... Arguments>
+	static TypeLanes visit(const ast::String &, Arguments &&...)
+	{
+		return TypeLanes::broadcast({Domain::Symbolic, SetSize::Unit});
+	}
+
+	template <class... Arguments>
+	static TypeLanes visit(const ast::UnaryOperation &unaryOperation, Arguments &&... arguments)
+	{
+		const auto argumentTypes = typeLanes<VariableTypesAccessor>(unaryOperation.argument, std::forward<Arguments>(arguments)...);
+
+		return applyTypeRule(unaryOperationType, argumentTypes);
+	}
+
+	template <class... Arguments>
+	static TypeLanes visit(const ast::Variable &variable, Arguments &&... arguments)
+	{
+		return VariableTypesAccessor()(variable, std::forward<Arguments>(arguments)...);
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class VariableTypesAccessor, class... Arguments>
+TypeLanes typeLanes(const ast::Term &term, Arguments &&... arguments)
+{
+	return term.accept(TermTypeLanesVisitor<VariableTypesAccessor>(), std::forward<Arguments>(arguments)...);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class VariableTypesAccessor, class... Arguments>
+EvaluationResultLanes evaluateLanes(const ast::Formula &formula, Arguments &&... arguments);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class VariableTypesAccessor>
+struct EvaluateFormulaLanesVisitor
+{
+	template <class... Arguments>
+	static EvaluationResultLanes visit(const ast::And &and_, Arguments &&... arguments)
+	{
+		return evaluateAndLanes(and_.arguments,
+			[&](const auto &argument)
+			{
+				return evaluateLanes<VariableTypesAccessor>(argument, std::forward<Arguments>(arguments)...);
+			});
+	}
+
+	template <class... Arguments>
+	static EvaluationResultLanes visit(const ast::Biconditional &biconditional, Arguments &&... arguments)
+	{
+		const auto leftResult = evaluateLanes<VariableTypesAccessor>(biconditional.left, std::forward<Arguments>(arguments)...);
+		const auto rightResult = evaluateLanes<VariableTypesAccessor>(biconditional.right, std::forward<Arguments>(arguments)...);
+
+		return evaluateBiconditionalLanes(leftResult, rightResult);
+	}
+
+	template <class... Arguments>
+	static EvaluationResultLanes visit(const ast::Boolean &boolean, Arguments &&...)
+	{
+		return EvaluationResultLanes::broadcast(boolean.value == true ? EvaluationResult::True : EvaluationResult::False);
+	}
+
+	template <class... Arguments>
+	static EvaluationResultLanes visit(const ast::Comparison &comparison, Arguments &&... arguments)
+	{
+		const auto leftTypes = typeLanes<VariableTypesAccessor>(comparison.left, std::forward<Arguments>(arguments)...);
+		const auto rightTypes = typeLanes<VariableTypesAccessor>(comparison.right, std::forward<Arguments>(arguments)...);
+
+		return applyEvaluationRule(
+			[&](const Type &leftType, const Type &rightType)
+			{
+				return evaluateComparison(comparison.operator_, leftType, rightType);
+			},
+			leftTypes, rightTypes);
+	}
+
+	template <class... Arguments>
+	static EvaluationResultLanes visit(const ast::Exists &exists, Arguments &&... arguments)
+	{
+		return evaluateLanes<VariableTypesAccessor>(exists.argument, std::forward<Arguments>(arguments)...);
+	}
+
+	template <class... Arguments>
+	static EvaluationResultLanes visit(const ast::ForAll &forAll, Arguments &&... arguments)
+	{
+		return evaluateLanes<VariableTypesAccessor>(forAll.argument, std::forward<Arguments>(arguments)...);
+	}
+
+	template <class... Arguments>
+	static EvaluationResultLanes visit(const ast::Implies &implies, Arguments &&... arguments)
+	{
+		const auto antecedentResult = evaluateLanes<VariableTypesAccessor>(implies.antecedent, std::forward<Arguments>(arguments)...);
+		const auto consequentResult = evaluateLanes<VariableTypesAccessor>(implies.consequent, std::forward<Arguments>(arguments)...);
+
+		return evaluateImpliesLanes(antecedentResult, consequentResult);
+	}
+
+	template <class... Arguments>
+	static EvaluationResultLanes visit(const ast::In &in, Arguments &&... arguments)
+	{
+		const auto elementTypes = typeLanes<VariableTypesAccessor>(in.element, std::forward<Arguments>(arguments)...);
+		const auto setTypes = typeLanes<VariableTypesAccessor>(in.set, std::forward<Arguments>(arguments)...);
+
+		return applyEvaluationRule(evaluateIn, elementTypes, setTypes);
+	}
+
+	template <class... Arguments>
+	static EvaluationResultLanes visit(const ast::Not &not_, Arguments &&... arguments)
+	{
+		const auto result = evaluateLanes<VariableTypesAccessor>(not_.argument, std::forward<Arguments>(arguments)...);
+
+		return evaluateNotLanes(result);
+	}
+
+	template <class... Arguments>
+	static EvaluationResultLanes visit(const ast::Or &or_, Arguments &&... arguments)
+	{
+		return evaluateOrLanes(or_.arguments,
+			[&](const auto &argument)
+			{
+				return evaluateLanes<VariableTypesAccessor>(argument, std::forward<Arguments>(arguments)...);
+			});
+	}
+
+	template <class... Arguments>
+	static EvaluationResultLanes visit(const ast::Predicate &predicate, Arguments &&... arguments)
+	{
+		return evaluatePredicateLanes(*predicate.declaration, predicate.arguments,
+			[&](const auto &argument)
+			{
+				return typeLanes<VariableTypesAccessor>(argument, std::forward<Arguments>(arguments)...);
+			});
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class VariableTypesAccessor, class... Arguments>
+EvaluationResultLanes evaluateLanes(const ast::Formula &formula, Arguments &&... arguments)
+{
+	return formula.accept(EvaluateFormulaLanesVisitor<VariableTypesAccessor>(), std::forward<Arguments>(arguments)...);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <anthem/AST.h>
 #include <anthem/Context.h>
+#include <anthem/ThreadPool.h>
 
 namespace anthem
 {
@@ -13,7 +14,7 @@ namespace anthem
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-std::vector<ast::Formula> complete(std::vector<ast::ScopedFormula> &&scopedFormulas, Context &context);
+std::vector<ast::Formula> complete(std::vector<ast::ScopedFormula> &&scopedFormulas, Context &context, ThreadPool &threadPool);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
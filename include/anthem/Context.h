@@ -1,25 +1,65 @@
 #ifndef __ANTHEM__CONTEXT_H
 #define __ANTHEM__CONTEXT_H
 
+#include <memory>
 #include <optional>
+#include <string_view>
+#include <unordered_map>
 
 #include <anthem/AST.h>
+#include <anthem/Arena.h>
 #include <anthem/MapToIntegersPolicy.h>
 #include <anthem/Semantics.h>
+#include <anthem/Statistics.h>
+#include <anthem/TranslationCache.h>
 #include <anthem/TranslationMode.h>
 #include <anthem/OutputFormat.h>
+#include <anthem/Profiler.h>
 #include <anthem/output/Logger.h>
 #include <anthem/output/ParenthesisStyle.h>
 
 namespace anthem
 {
 
+class StatementCache;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // Context
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Identifies predicate and function declarations by name and arity
+struct DeclarationKey
+{
+	bool operator==(const DeclarationKey &other) const noexcept
+	{
+		return arity == other.arity && name == other.name;
+	}
+
+	std::string_view name;
+	size_t arity;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct DeclarationKeyHash
+{
+	size_t operator()(const DeclarationKey &declarationKey) const noexcept
+	{
+		const auto nameHash = std::hash<std::string_view>()(declarationKey.name);
+
+		return nameHash ^ (declarationKey.arity + 0x9e3779b9 + (nameHash << 6) + (nameHash >> 2));
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class Declaration>
+using DeclarationIndex = std::unordered_map<DeclarationKey, Declaration *, DeclarationKeyHash>;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 struct Context
 {
 	Context() = default;
@@ -31,18 +71,10 @@ struct Context
 
 	std::optional<ast::PredicateDeclaration *> findPredicateDeclaration(const char *name, size_t arity)
 	{
-		const auto matchesExistingPredicateDeclaration =
-			[&](const auto &predicateDeclaration)
-			{
-				return (predicateDeclaration->arity() == arity
-					&& strcmp(predicateDeclaration->name.c_str(), name) == 0);
-			};
-
-		auto matchingPredicateDeclaration = std::find_if(predicateDeclarations.begin(),
-			predicateDeclarations.end(), matchesExistingPredicateDeclaration);
+		const auto matchingPredicateDeclaration = predicateDeclarationIndex.find(DeclarationKey{name, arity});
 
-		if (matchingPredicateDeclaration != predicateDeclarations.end())
-			return matchingPredicateDeclaration->get();
+		if (matchingPredicateDeclaration != predicateDeclarationIndex.end())
+			return matchingPredicateDeclaration->second;
 
 		return std::nullopt;
 	}
@@ -56,7 +88,11 @@ struct Context
 
 		predicateDeclarations.emplace_back(std::make_unique<ast::PredicateDeclaration>(name, arity));
 
-		return predicateDeclarations.back().get();
+		auto newPredicateDeclaration = predicateDeclarations.back().get();
+		// The key refers to the name stored in the declaration itself, which lives as long as the context
+		predicateDeclarationIndex.emplace(DeclarationKey{newPredicateDeclaration->name, arity}, newPredicateDeclaration);
+
+		return newPredicateDeclaration;
 	}
 
 	ast::PredicateDeclaration *findOrCreatePrimePredicateDeclaration(const char *name, size_t arity, Context &context)
@@ -72,18 +108,10 @@ struct Context
 
 	std::optional<ast::FunctionDeclaration *> findFunctionDeclaration(const char *name, size_t arity)
 	{
-		const auto matchesExistingFunctionDeclaration =
-			[&](const auto &functionDeclarations)
-			{
-				return (functionDeclarations->arity() == arity
-					&& strcmp(functionDeclarations->name.c_str(), name) == 0);
-			};
-
-		auto matchingFunctionDeclaration = std::find_if(functionDeclarations.begin(),
-			functionDeclarations.end(), matchesExistingFunctionDeclaration);
+		const auto matchingFunctionDeclaration = functionDeclarationIndex.find(DeclarationKey{name, arity});
 
-		if (matchingFunctionDeclaration != functionDeclarations.end())
-			return matchingFunctionDeclaration->get();
+		if (matchingFunctionDeclaration != functionDeclarationIndex.end())
+			return matchingFunctionDeclaration->second;
 
 		return std::nullopt;
 	}
@@ -97,29 +125,78 @@ struct Context
 
 		functionDeclarations.emplace_back(std::make_unique<ast::FunctionDeclaration>(name, arity));
 
-		return functionDeclarations.back().get();
+		auto newFunctionDeclaration = functionDeclarations.back().get();
+		functionDeclarationIndex.emplace(DeclarationKey{newFunctionDeclaration->name, arity}, newFunctionDeclaration);
+
+		return newFunctionDeclaration;
+	}
+
+	// Copies the settings of another context that control translations, but none of its declarations
+	void copyOptions(const Context &other)
+	{
+		allocateFromArena = other.allocateFromArena;
+		translationMode = other.translationMode;
+		outputFormat = other.outputFormat;
+		performSimplification = other.performSimplification;
+		performCompletion = other.performCompletion;
+		performIntegerDetection = other.performIntegerDetection;
+		abbreviationThreshold = other.abbreviationThreshold;
+		mapToIntegersPolicy = other.mapToIntegersPolicy;
+		numberOfThreads = other.numberOfThreads;
+		parseConcurrently = other.parseConcurrently;
+		mapInputFiles = other.mapInputFiles;
+		parenthesisStyle = other.parenthesisStyle;
+		collectStatistics = other.collectStatistics;
 	}
 
 	output::Logger logger;
 
+	// AST nodes created during translations are allocated from this arena unless disabled
+	Arena arena;
+	bool allocateFromArena{true};
+	// Arenas of other threads whose AST nodes were handed over to this context
+	std::vector<std::unique_ptr<Arena>> adoptedArenas;
+
 	TranslationMode translationMode{TranslationMode::HereAndThere};
 	OutputFormat outputFormat{OutputFormat::HumanReadable};
 
 	bool performSimplification{false};
 	bool performCompletion{false};
 	bool performIntegerDetection{false};
+	// Hidden predicates occurring more than once whose definitions have more nodes than this are kept
+	// as abbreviations instead of being eliminated (0 to always eliminate them)
+	size_t abbreviationThreshold{0};
 	MapToIntegersPolicy mapToIntegersPolicy{MapToIntegersPolicy::Auto};
+	size_t numberOfThreads{1};
+	// Parse and translate the two programs of an equivalence check on separate threads
+	bool parseConcurrently{false};
+	// Parse regular input files in place through memory mappings, which is only safe if they don’t change meanwhile
+	bool mapInputFiles{true};
 	Semantics semantics{Semantics::ClassicalLogic};
 
+	// Declarations must only be added through the findOrCreate functions to keep the indices up to date.
+	// The vectors own the declarations and determine their order, while the indices provide the lookup
 	std::vector<std::unique_ptr<ast::PredicateDeclaration>> predicateDeclarations;
+	DeclarationIndex<ast::PredicateDeclaration> predicateDeclarationIndex;
 	ast::PredicateDeclaration::Visibility defaultPredicateVisibility{ast::PredicateDeclaration::Visibility::Visible};
 
 	std::vector<std::unique_ptr<ast::FunctionDeclaration>> functionDeclarations;
+	DeclarationIndex<ast::FunctionDeclaration> functionDeclarationIndex;
 
 	bool externalStatementsUsed{false};
 	bool showStatementsUsed{false};
 
 	output::ParenthesisStyle parenthesisStyle{output::ParenthesisStyle::Normal};
+
+	bool collectStatistics{false};
+	Statistics statistics;
+
+	// Only set if profiling is requested, shared with the contexts of programs parsed concurrently
+	std::shared_ptr<Profiler> profiler;
+	// Only set if caching is requested, shared with the contexts of batch jobs
+	std::shared_ptr<TranslationCache> translationCache;
+	// Only set if the translations of statements are to be reused by the next translation
+	std::shared_ptr<StatementCache> statementCache;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
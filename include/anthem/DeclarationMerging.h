@@ -0,0 +1,31 @@
+#ifndef __ANTHEM__DECLARATION_MERGING_H
+#define __ANTHEM__DECLARATION_MERGING_H
+
+#include <vector>
+
+#include <anthem/AST.h>
+#include <anthem/Context.h>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// DeclarationMerging
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Moves the declarations of a program translated with a separate context into the given context and
+// redirects the program’s formulas to the merged declarations. The result is the same as if the program
+// had been translated with the given context after all programs that were already translated with it
+void mergeDeclarations(Context &context, Context &otherContext, std::vector<ast::ScopedFormula> &otherScopedFormulas);
+
+// Redirects the formula to the declarations of the given context with the same names and arities,
+// which are created if necessary
+void redirectDeclarations(ast::Formula &formula, Context &context);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
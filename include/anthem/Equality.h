@@ -1,8 +1,11 @@
 #ifndef __ANTHEM__EQUALITY_H
 #define __ANTHEM__EQUALITY_H
 
+#include <algorithm>
+
 #include <anthem/AST.h>
 #include <anthem/ASTUtils.h>
+#include <anthem/Fingerprint.h>
 #include <anthem/Utils.h>
 
 namespace anthem
@@ -16,64 +19,194 @@ namespace ast
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-Tristate equal(const Formula &lhs, const Formula &rhs);
-Tristate equal(const Term &lhs, const Term &rhs);
+// State of a comparison of two formulas
+struct EqualityContext
+{
+	FingerprintCache &fingerprintCache;
+	// The variables bound by the quantifiers enclosing the compared formulas on either side, which are
+	// identified with each other by their position
+	BoundVariableLayers boundVariableLayers;
+	BoundVariableLayers otherBoundVariableLayers;
+};
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct FormulaEqualityVisitor
+inline Tristate equal(const Formula &lhs, const Formula &rhs);
+inline Tristate equal(const Formula &lhs, const Formula &rhs, FingerprintCache &fingerprintCache);
+inline Tristate equal(const Formula &lhs, const Formula &rhs, EqualityContext &context);
+inline Tristate equal(const Term &lhs, const Term &rhs);
+inline Tristate equal(const Term &lhs, const Term &rhs, const EqualityContext &context);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Checks whether each argument has an equal counterpart among the other arguments and vice versa
+// Arguments are always compared on the left, as the context distinguishes the bound variables of both sides
+// Other arguments found to be the counterpart of an argument aren’t searched for again in the opposite direction
+inline bool argumentsMatchMutually(const std::vector<Formula> &arguments, const std::vector<Formula> &otherArguments,
+	EqualityContext &context)
 {
-	Tristate visit(const And &and_, const Formula &otherFormula)
-	{
-		if (!otherFormula.is<And>())
-			return Tristate::Unknown;
+	// Below this number of pairs, comparing all of them is cheaper than computing fingerprints
+	constexpr size_t MaximumNumberOfPairsComparedDirectly = 16;
 
-		const auto &otherAnd = otherFormula.get<And>();
+	std::vector<bool> isOtherArgumentMatched(otherArguments.size(), false);
 
-		for (const auto &argument : and_.arguments)
+	if (arguments.size() * otherArguments.size() <= MaximumNumberOfPairsComparedDirectly)
+	{
+		for (const auto &argument : arguments)
 		{
-			const auto match = std::find_if(
-				otherAnd.arguments.cbegin(), otherAnd.arguments.cend(),
-				[&](const auto &otherArgument)
+			bool isArgumentMatched = false;
+
+			for (size_t i = 0; i < otherArguments.size() && !isArgumentMatched; i++)
+				if (equal(argument, otherArguments[i], context) == Tristate::True)
 				{
-					return equal(argument, otherArgument) == Tristate::True;
-				});
+					isOtherArgumentMatched[i] = true;
+					isArgumentMatched = true;
+				}
 
-			if (match == otherAnd.arguments.cend())
-				return Tristate::Unknown;
+			if (!isArgumentMatched)
+				return false;
 		}
 
-		for (const auto &otherArgument : otherAnd.arguments)
+		for (size_t i = 0; i < otherArguments.size(); i++)
 		{
-			const auto match = std::find_if(
-				and_.arguments.cbegin(), and_.arguments.cend(),
+			if (isOtherArgumentMatched[i])
+				continue;
+
+			const auto match = std::find_if(arguments.cbegin(), arguments.cend(),
 				[&](const auto &argument)
 				{
-					return equal(otherArgument, argument) == Tristate::True;
+					return equal(argument, otherArguments[i], context) == Tristate::True;
 				});
 
-			if (match == and_.arguments.cend())
-				return Tristate::Unknown;
+			if (match == arguments.cend())
+				return false;
 		}
 
+		return true;
+	}
+
+	// Otherwise, only arguments with identical fingerprints are compared, which are found by sorting them
+	using FingerprintedArgument = std::pair<Fingerprint, size_t>;
+
+	const auto sortByFingerprint =
+		[&](const std::vector<Formula> &arguments, const BoundVariableLayers &boundVariableLayers)
+		{
+			std::vector<FingerprintedArgument> fingerprintedArguments;
+			fingerprintedArguments.reserve(arguments.size());
+
+			for (size_t i = 0; i < arguments.size(); i++)
+				fingerprintedArguments.emplace_back(context.fingerprintCache.fingerprint(arguments[i], boundVariableLayers), i);
+
+			std::sort(fingerprintedArguments.begin(), fingerprintedArguments.end());
+
+			return fingerprintedArguments;
+		};
+
+	const auto fingerprintedArguments = sortByFingerprint(arguments, context.boundVariableLayers);
+	const auto otherFingerprintedArguments = sortByFingerprint(otherArguments, context.otherBoundVariableLayers);
+
+	const auto candidates =
+		[](const std::vector<FingerprintedArgument> &fingerprintedArguments, Fingerprint fingerprint)
+		{
+			return std::equal_range(fingerprintedArguments.cbegin(), fingerprintedArguments.cend(),
+				FingerprintedArgument{fingerprint, 0},
+				[](const auto &lhs, const auto &rhs)
+				{
+					return lhs.first < rhs.first;
+				});
+		};
+
+	for (const auto &[argumentFingerprint, argumentIndex] : fingerprintedArguments)
+	{
+		const auto [begin, end] = candidates(otherFingerprintedArguments, argumentFingerprint);
+
+		const auto match = std::find_if(begin, end,
+			[&](const auto &candidate)
+			{
+				return equal(arguments[argumentIndex], otherArguments[candidate.second], context) == Tristate::True;
+			});
+
+		if (match == end)
+			return false;
+
+		isOtherArgumentMatched[match->second] = true;
+	}
+
+	for (const auto &[otherArgumentFingerprint, otherArgumentIndex] : otherFingerprintedArguments)
+	{
+		if (isOtherArgumentMatched[otherArgumentIndex])
+			continue;
+
+		const auto [begin, end] = candidates(fingerprintedArguments, otherArgumentFingerprint);
+
+		const auto match = std::find_if(begin, end,
+			[&](const auto &candidate)
+			{
+				return equal(arguments[candidate.second], otherArguments[otherArgumentIndex], context) == Tristate::True;
+			});
+
+		if (match == end)
+			return false;
+	}
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Checks whether two quantified formulas are equal up to renaming the bound variables, which are matched by their position
+inline Tristate quantifiedFormulasMatch(const VariableDeclarationPointers &variables, const Formula &argument,
+	const VariableDeclarationPointers &otherVariables, const Formula &otherArgument, EqualityContext &context)
+{
+	if (variables.size() != otherVariables.size())
+		return Tristate::Unknown;
+
+	context.boundVariableLayers.push_back(&variables);
+	context.otherBoundVariableLayers.push_back(&otherVariables);
+
+	const auto result = equal(argument, otherArgument, context);
+
+	context.boundVariableLayers.pop_back();
+	context.otherBoundVariableLayers.pop_back();
+
+	// Different bound variables may still take the same values, so only equality carries over
+	return (result == Tristate::True)
+		? Tristate::True
+		: Tristate::Unknown;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct FormulaEqualityVisitor
+{
+	Tristate visit(const And &and_, const Formula &otherFormula, EqualityContext &context)
+	{
+		if (!otherFormula.is<And>())
+			return Tristate::Unknown;
+
+		const auto &otherAnd = otherFormula.get<And>();
+
+		if (!argumentsMatchMutually(and_.arguments, otherAnd.arguments, context))
+			return Tristate::Unknown;
+
 		return Tristate::True;
 	}
 
-	Tristate visit(const Biconditional &biconditional, const Formula &otherFormula)
+	Tristate visit(const Biconditional &biconditional, const Formula &otherFormula, EqualityContext &context)
 	{
 		if (!otherFormula.is<Biconditional>())
 			return Tristate::Unknown;
 
 		const auto &otherBiconditional = otherFormula.get<Biconditional>();
 
-		if (equal(biconditional.left, otherBiconditional.left) == Tristate::True
-		    && equal(biconditional.right, otherBiconditional.right) == Tristate::True)
+		if (equal(biconditional.left, otherBiconditional.left, context) == Tristate::True
+		    && equal(biconditional.right, otherBiconditional.right, context) == Tristate::True)
 		{
 			return Tristate::True;
 		}
 
-		if (equal(biconditional.left, otherBiconditional.right) == Tristate::True
-		    && equal(biconditional.right, otherBiconditional.left) == Tristate::True)
+		if (equal(biconditional.left, otherBiconditional.right, context) == Tristate::True
+		    && equal(biconditional.right, otherBiconditional.left, context) == Tristate::True)
 		{
 			return Tristate::True;
 		}
@@ -81,7 +214,7 @@ struct FormulaEqualityVisitor
 		return Tristate::Unknown;
 	}
 
-	Tristate visit(const Boolean &boolean, const Formula &otherFormula)
+	Tristate visit(const Boolean &boolean, const Formula &otherFormula, EqualityContext &)
 	{
 		if (!otherFormula.is<Boolean>())
 			return Tristate::Unknown;
@@ -93,7 +226,7 @@ struct FormulaEqualityVisitor
 			: Tristate::False;
 	}
 
-	Tristate visit(const Comparison &comparison, const Formula &otherFormula)
+	Tristate visit(const Comparison &comparison, const Formula &otherFormula, EqualityContext &context)
 	{
 		if (!otherFormula.is<Comparison>())
 			return Tristate::Unknown;
@@ -103,8 +236,8 @@ struct FormulaEqualityVisitor
 		if (comparison.operator_ != otherComparison.operator_)
 			return Tristate::Unknown;
 
-		if (equal(comparison.left, otherComparison.left) == Tristate::True
-		    && equal(comparison.right, otherComparison.right) == Tristate::True)
+		if (equal(comparison.left, otherComparison.left, context) == Tristate::True
+		    && equal(comparison.right, otherComparison.right, context) == Tristate::True)
 		{
 			return Tristate::True;
 		}
@@ -116,8 +249,8 @@ struct FormulaEqualityVisitor
 			return Tristate::Unknown;
 		}
 
-		if (equal(comparison.left, otherComparison.right) == Tristate::True
-		    && equal(comparison.right, otherComparison.left) == Tristate::True)
+		if (equal(comparison.left, otherComparison.right, context) == Tristate::True
+		    && equal(comparison.right, otherComparison.left, context) == Tristate::True)
 		{
 			return Tristate::True;
 		}
@@ -125,33 +258,35 @@ struct FormulaEqualityVisitor
 		return Tristate::Unknown;
 	}
 
-	Tristate visit(const Exists &, const Formula &otherFormula)
+	Tristate visit(const Exists &exists, const Formula &otherFormula, EqualityContext &context)
 	{
 		if (!otherFormula.is<Exists>())
 			return Tristate::Unknown;
 
-		// TODO: implement stronger check
-		return Tristate::Unknown;
+		const auto &otherExists = otherFormula.get<Exists>();
+
+		return quantifiedFormulasMatch(exists.variables, exists.argument, otherExists.variables, otherExists.argument, context);
 	}
 
-	Tristate visit(const ForAll &, const Formula &otherFormula)
+	Tristate visit(const ForAll &forAll, const Formula &otherFormula, EqualityContext &context)
 	{
 		if (!otherFormula.is<ForAll>())
 			return Tristate::Unknown;
 
-		// TODO: implement stronger check
-		return Tristate::Unknown;
+		const auto &otherForAll = otherFormula.get<ForAll>();
+
+		return quantifiedFormulasMatch(forAll.variables, forAll.argument, otherForAll.variables, otherForAll.argument, context);
 	}
 
-	Tristate visit(const Implies &implies, const Formula &otherFormula)
+	Tristate visit(const Implies &implies, const Formula &otherFormula, EqualityContext &context)
 	{
 		if (!otherFormula.is<Implies>())
 			return Tristate::Unknown;
 
 		const auto &otherImplies = otherFormula.get<Implies>();
 
-		if (equal(implies.antecedent, otherImplies.antecedent) == Tristate::True
-		    && equal(implies.consequent, otherImplies.consequent) == Tristate::True)
+		if (equal(implies.antecedent, otherImplies.antecedent, context) == Tristate::True
+		    && equal(implies.consequent, otherImplies.consequent, context) == Tristate::True)
 		{
 			return Tristate::True;
 		}
@@ -159,15 +294,15 @@ struct FormulaEqualityVisitor
 		return Tristate::Unknown;
 	}
 
-	Tristate visit(const In &in, const Formula &otherFormula)
+	Tristate visit(const In &in, const Formula &otherFormula, EqualityContext &context)
 	{
 		if (!otherFormula.is<In>())
 			return Tristate::Unknown;
 
 		const auto &otherIn = otherFormula.get<In>();
 
-		if (equal(in.element, otherIn.element) == Tristate::True
-		    && equal(in.set, otherIn.set) == Tristate::True)
+		if (equal(in.element, otherIn.element, context) == Tristate::True
+		    && equal(in.set, otherIn.set, context) == Tristate::True)
 		{
 			return Tristate::True;
 		}
@@ -175,53 +310,30 @@ struct FormulaEqualityVisitor
 		return Tristate::Unknown;
 	}
 
-	Tristate visit(const Not &not_, const Formula &otherFormula)
+	Tristate visit(const Not &not_, const Formula &otherFormula, EqualityContext &context)
 	{
 		if (!otherFormula.is<Not>())
 			return Tristate::Unknown;
 
 		const auto &otherNot = otherFormula.get<Not>();
 
-		return equal(not_.argument, otherNot.argument);
+		return equal(not_.argument, otherNot.argument, context);
 	}
 
-	Tristate visit(const Or &or_, const Formula &otherFormula)
+	Tristate visit(const Or &or_, const Formula &otherFormula, EqualityContext &context)
 	{
 		if (!otherFormula.is<Or>())
 			return Tristate::Unknown;
 
 		const auto &otherOr = otherFormula.get<Or>();
 
-		for (const auto &argument : or_.arguments)
-		{
-			const auto match = std::find_if(
-				otherOr.arguments.cbegin(), otherOr.arguments.cend(),
-				[&](const auto &otherArgument)
-				{
-					return equal(argument, otherArgument) == Tristate::True;
-				});
-
-			if (match == otherOr.arguments.cend())
-				return Tristate::Unknown;
-		}
-
-		for (const auto &otherArgument : otherOr.arguments)
-		{
-			const auto match = std::find_if(
-				or_.arguments.cbegin(), or_.arguments.cend(),
-				[&](const auto &argument)
-				{
-					return equal(otherArgument, argument) == Tristate::True;
-				});
-
-			if (match == or_.arguments.cend())
-				return Tristate::Unknown;
-		}
+		if (!argumentsMatchMutually(or_.arguments, otherOr.arguments, context))
+			return Tristate::Unknown;
 
 		return Tristate::True;
 	}
 
-	Tristate visit(const Predicate &predicate, const Formula &otherFormula)
+	Tristate visit(const Predicate &predicate, const Formula &otherFormula, EqualityContext &context)
 	{
 		if (!otherFormula.is<Predicate>())
 			return Tristate::Unknown;
@@ -234,7 +346,7 @@ struct FormulaEqualityVisitor
 		assert(predicate.arguments.size() == otherPredicate.arguments.size());
 
 		for (size_t i = 0; i < predicate.arguments.size(); i++)
-			if (equal(predicate.arguments[i], otherPredicate.arguments[i]) != Tristate::True)
+			if (equal(predicate.arguments[i], otherPredicate.arguments[i], context) != Tristate::True)
 				return Tristate::Unknown;
 
 		return Tristate::True;
@@ -245,7 +357,7 @@ struct FormulaEqualityVisitor
 
 struct TermEqualityVisitor
 {
-	Tristate visit(const BinaryOperation &binaryOperation, const Term &otherTerm)
+	Tristate visit(const BinaryOperation &binaryOperation, const Term &otherTerm, const EqualityContext &context)
 	{
 		if (!otherTerm.is<BinaryOperation>())
 			return Tristate::Unknown;
@@ -255,8 +367,8 @@ struct TermEqualityVisitor
 		if (binaryOperation.operator_ != otherBinaryOperation.operator_)
 			return Tristate::Unknown;
 
-		if (equal(binaryOperation.left, otherBinaryOperation.left) == Tristate::True
-		    && equal(binaryOperation.right, otherBinaryOperation.right) == Tristate::True)
+		if (equal(binaryOperation.left, otherBinaryOperation.left, context) == Tristate::True
+		    && equal(binaryOperation.right, otherBinaryOperation.right, context) == Tristate::True)
 		{
 			return Tristate::True;
 		}
@@ -268,8 +380,8 @@ struct TermEqualityVisitor
 			return Tristate::Unknown;
 		}
 
-		if (equal(binaryOperation.left, otherBinaryOperation.right) == Tristate::True
-		    && equal(binaryOperation.right, otherBinaryOperation.left) == Tristate::True)
+		if (equal(binaryOperation.left, otherBinaryOperation.right, context) == Tristate::True
+		    && equal(binaryOperation.right, otherBinaryOperation.left, context) == Tristate::True)
 		{
 			return Tristate::True;
 		}
@@ -277,7 +389,7 @@ struct TermEqualityVisitor
 		return Tristate::Unknown;
 	}
 
-	Tristate visit(const Boolean &boolean, const Term &otherTerm)
+	Tristate visit(const Boolean &boolean, const Term &otherTerm, const EqualityContext &)
 	{
 		if (!otherTerm.is<Boolean>())
 			return Tristate::Unknown;
@@ -289,7 +401,7 @@ struct TermEqualityVisitor
 			: Tristate::False;
 	}
 
-	Tristate visit(const Function &function, const Term &otherTerm)
+	Tristate visit(const Function &function, const Term &otherTerm, const EqualityContext &context)
 	{
 		if (!otherTerm.is<Function>())
 			return Tristate::Unknown;
@@ -303,13 +415,13 @@ struct TermEqualityVisitor
 			return Tristate::False;
 
 		for (size_t i = 0; i < function.arguments.size(); i++)
-			if (equal(function.arguments[i], otherFunction.arguments[i]) != Tristate::True)
+			if (equal(function.arguments[i], otherFunction.arguments[i], context) != Tristate::True)
 				return Tristate::Unknown;
 
 		return Tristate::True;
 	}
 
-	Tristate visit(const Integer &integer, const Term &otherTerm)
+	Tristate visit(const Integer &integer, const Term &otherTerm, const EqualityContext &)
 	{
 		if (!otherTerm.is<Integer>())
 			return Tristate::Unknown;
@@ -321,23 +433,23 @@ struct TermEqualityVisitor
 			: Tristate::False;
 	}
 
-	Tristate visit(const Interval &interval, const Term &otherTerm)
+	Tristate visit(const Interval &interval, const Term &otherTerm, const EqualityContext &context)
 	{
 		if (!otherTerm.is<Interval>())
 			return Tristate::Unknown;
 
 		const auto &otherInterval = otherTerm.get<Interval>();
 
-		if (equal(interval.from, otherInterval.from) != Tristate::True)
+		if (equal(interval.from, otherInterval.from, context) != Tristate::True)
 			return Tristate::Unknown;
 
-		if (equal(interval.to, otherInterval.to) != Tristate::True)
+		if (equal(interval.to, otherInterval.to, context) != Tristate::True)
 			return Tristate::Unknown;
 
 		return Tristate::True;
 	}
 
-	Tristate visit(const SpecialInteger &specialInteger, const Term &otherTerm)
+	Tristate visit(const SpecialInteger &specialInteger, const Term &otherTerm, const EqualityContext &)
 	{
 		if (!otherTerm.is<SpecialInteger>())
 			return Tristate::Unknown;
@@ -349,7 +461,7 @@ struct TermEqualityVisitor
 			: Tristate::False;
 	}
 
-	Tristate visit(const String &string, const Term &otherTerm)
+	Tristate visit(const String &string, const Term &otherTerm, const EqualityContext &)
 	{
 		if (!otherTerm.is<String>())
 			return Tristate::Unknown;
@@ -361,7 +473,7 @@ struct TermEqualityVisitor
 			: Tristate::False;
 	}
 
-	Tristate visit(const UnaryOperation &unaryOperation, const Term &otherTerm)
+	Tristate visit(const UnaryOperation &unaryOperation, const Term &otherTerm, const EqualityContext &context)
 	{
 		if (!otherTerm.is<UnaryOperation>())
 			return Tristate::Unknown;
@@ -371,16 +483,25 @@ struct TermEqualityVisitor
 		if (unaryOperation.operator_ != otherUnaryOperation.operator_)
 			return Tristate::Unknown;
 
-		return equal(unaryOperation.argument, otherUnaryOperation.argument);
+		return equal(unaryOperation.argument, otherUnaryOperation.argument, context);
 	}
 
-	Tristate visit(const Variable &variable, const Term &otherTerm)
+	Tristate visit(const Variable &variable, const Term &otherTerm, const EqualityContext &context)
 	{
 		if (!otherTerm.is<Variable>())
 			return Tristate::Unknown;
 
 		const auto &otherVariable = otherTerm.get<Variable>();
 
+		const auto boundVariablePosition = findBoundVariable(variable.declaration, context.boundVariableLayers);
+		const auto otherBoundVariablePosition = findBoundVariable(otherVariable.declaration, context.otherBoundVariableLayers);
+
+		// Bound variables are equal if they are bound at the same position by corresponding quantifiers
+		if (boundVariablePosition || otherBoundVariablePosition)
+			return (boundVariablePosition == otherBoundVariablePosition)
+				? Tristate::True
+				: Tristate::Unknown;
+
 		return (variable.declaration == otherVariable.declaration)
 			? Tristate::True
 			: Tristate::False;
@@ -389,16 +510,53 @@ struct TermEqualityVisitor
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-Tristate equal(const Formula &lhs, const Formula &rhs)
+inline Tristate equal(const Formula &lhs, const Formula &rhs)
+{
+	FingerprintCache fingerprintCache;
+
+	return equal(lhs, rhs, fingerprintCache);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Compares two formulas, reusing the fingerprints computed by earlier comparisons of the same formulas
+inline Tristate equal(const Formula &lhs, const Formula &rhs, FingerprintCache &fingerprintCache)
 {
-	return lhs.accept(FormulaEqualityVisitor(), rhs);
+	EqualityContext context{fingerprintCache, {}, {}};
+
+	return equal(lhs, rhs, context);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline Tristate equal(const Formula &lhs, const Formula &rhs, EqualityContext &context)
+{
+	// Outside of quantifiers, fingerprints are remembered, so differing quantified formulas are rejected without
+	// comparing them again
+	if (context.boundVariableLayers.empty() && (lhs.is<Exists>() || lhs.is<ForAll>())
+	    && context.fingerprintCache.fingerprint(lhs) != context.fingerprintCache.fingerprint(rhs))
+	{
+		return Tristate::Unknown;
+	}
+
+	return lhs.accept(FormulaEqualityVisitor(), rhs, context);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline Tristate equal(const Term &lhs, const Term &rhs)
+{
+	FingerprintCache fingerprintCache;
+	const EqualityContext context{fingerprintCache, {}, {}};
+
+	return equal(lhs, rhs, context);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-Tristate equal(const Term &lhs, const Term &rhs)
+inline Tristate equal(const Term &lhs, const Term &rhs, const EqualityContext &context)
 {
-	return lhs.accept(TermEqualityVisitor(), rhs);
+	return lhs.accept(TermEqualityVisitor(), rhs, context);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
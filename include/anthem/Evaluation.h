@@ -4,6 +4,8 @@
 #include <anthem/AST.h>
 #include <anthem/ASTUtils.h>
 #include <anthem/Exception.h>
+#include <anthem/FlatAST.h>
+#include <anthem/Type.h>
 #include <anthem/Utils.h>
 
 namespace anthem
@@ -15,41 +17,217 @@ namespace anthem
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-template <class VariableDomainAccessor = DefaultVariableDomainAccessor>
-struct EvaluateFormulaVisitor
+// The results of composite formulas are derived from the results and types of their operands, regardless
+// of the AST representation
+
+template <class ArgumentRange, class EvaluateArgument>
+EvaluationResult evaluateAnd(const ArgumentRange &arguments, EvaluateArgument evaluateArgument)
 {
-	template <class... Arguments>
-	static EvaluationResult visit(const ast::And &and_, Arguments &&... arguments)
+	bool someFalse = false;
+	bool someUnknown = false;
+
+	for (const auto &argument : arguments)
 	{
-		bool someFalse = false;
-		bool someUnknown = false;
+		const auto result = evaluateArgument(argument);
 
-		for (const auto &argument : and_.arguments)
+		switch (result)
 		{
-			const auto result = evaluate(argument, std::forward<Arguments>(arguments)...);
-
-			switch (result)
-			{
-				case EvaluationResult::Error:
-					return EvaluationResult::Error;
-				case EvaluationResult::True:
-					break;
-				case EvaluationResult::False:
-					someFalse = true;
-					break;
-				case EvaluationResult::Unknown:
-					someUnknown = true;
-					break;
-			}
+			case EvaluationResult::Error:
+				return EvaluationResult::Error;
+			case EvaluationResult::True:
+				break;
+			case EvaluationResult::False:
+				someFalse = true;
+				break;
+			case EvaluationResult::Unknown:
+				someUnknown = true;
+				break;
 		}
+	}
+
+	if (someFalse)
+		return EvaluationResult::False;
+
+	if (someUnknown)
+		return EvaluationResult::Unknown;
+
+	return EvaluationResult::True;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline EvaluationResult evaluateBiconditional(EvaluationResult leftResult, EvaluationResult rightResult)
+{
+	if (leftResult == EvaluationResult::Error || rightResult == EvaluationResult::Error)
+		return EvaluationResult::Error;
+
+	if (leftResult == EvaluationResult::Unknown || rightResult == EvaluationResult::Unknown)
+		return EvaluationResult::Unknown;
+
+	return (leftResult == rightResult ? EvaluationResult::True : EvaluationResult::False);
+}
 
-		if (someFalse)
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline EvaluationResult evaluateComparison(ast::Comparison::Operator operator_, const Type &leftType, const Type &rightType)
+{
+	// Comparisons with empty sets always return false
+	if (leftType.setSize == SetSize::Empty || rightType.setSize == SetSize::Empty)
+		return EvaluationResult::False;
+
+	// If either side has an unknown domain, the result is unknown
+	if (leftType.domain == Domain::Unknown || rightType.domain == Domain::Unknown)
+		return EvaluationResult::Unknown;
+
+	// If both sides have the same domain, the result is unknown
+	if (leftType.domain == rightType.domain)
+		return EvaluationResult::Unknown;
+
+	// If one side is integer, but the other one isn’t, they are not equal
+	switch (operator_)
+	{
+		case ast::Comparison::Operator::Equal:
 			return EvaluationResult::False;
+		case ast::Comparison::Operator::NotEqual:
+			return EvaluationResult::True;
+		// Integers are smaller than symbolic constants
+		case ast::Comparison::Operator::LessThan:
+			return (leftType.domain == Domain::Integer) ? EvaluationResult::True : EvaluationResult::False;
+		case ast::Comparison::Operator::LessEqual:
+			return (leftType.domain == Domain::Integer) ? EvaluationResult::True : EvaluationResult::False;
+		case ast::Comparison::Operator::GreaterEqual:
+			return (rightType.domain == Domain::Integer) ? EvaluationResult::True : EvaluationResult::False;
+		case ast::Comparison::Operator::GreaterThan:
+			return (rightType.domain == Domain::Integer) ? EvaluationResult::True : EvaluationResult::False;
+	}
+
+	throw TranslationException("unknown operator, please report to bug tracker");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline EvaluationResult evaluateImplies(EvaluationResult antecedentResult, EvaluationResult consequentResult)
+{
+	if (antecedentResult == EvaluationResult::Error || consequentResult == EvaluationResult::Error)
+		return EvaluationResult::Error;
 
-		if (someUnknown)
-			return EvaluationResult::Unknown;
+	if (antecedentResult == EvaluationResult::False)
+		return EvaluationResult::True;
 
+	if (consequentResult == EvaluationResult::True)
 		return EvaluationResult::True;
+
+	if (antecedentResult == EvaluationResult::True && consequentResult == EvaluationResult::False)
+		return EvaluationResult::False;
+
+	return EvaluationResult::Unknown;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline EvaluationResult evaluateIn(const Type &elementType, const Type &setType)
+{
+	// The element to test shouldn’t be empty or a proper set by itself
+	assert(elementType.setSize != SetSize::Empty && elementType.setSize != SetSize::Multi);
+
+	// If the set is empty, no element can be selected
+	if (setType.setSize == SetSize::Empty)
+		return EvaluationResult::False;
+
+	// If one of the sides has an unknown type, the result is unknown
+	if (elementType.domain == Domain::Unknown || setType.domain == Domain::Unknown)
+		return EvaluationResult::Unknown;
+
+	// If both sides have the same domain, the result is unknown
+	if (elementType.domain == setType.domain)
+		return EvaluationResult::Unknown;
+
+	// If one side is integer, but the other one isn’t, set inclusion is never satisfied
+	return EvaluationResult::False;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline EvaluationResult evaluateNot(EvaluationResult result)
+{
+	if (result == EvaluationResult::Error || result == EvaluationResult::Unknown)
+		return result;
+
+	return (result == EvaluationResult::True ? EvaluationResult::False : EvaluationResult::True);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class ArgumentRange, class EvaluateArgument>
+EvaluationResult evaluateOr(const ArgumentRange &arguments, EvaluateArgument evaluateArgument)
+{
+	bool someTrue = false;
+	bool someUnknown = false;
+
+	for (const auto &argument : arguments)
+	{
+		const auto result = evaluateArgument(argument);
+
+		switch (result)
+		{
+			case EvaluationResult::Error:
+				return EvaluationResult::Error;
+			case EvaluationResult::True:
+				someTrue = true;
+				break;
+			case EvaluationResult::False:
+				break;
+			case EvaluationResult::Unknown:
+				someUnknown = true;
+				break;
+		}
+	}
+
+	if (someTrue)
+		return EvaluationResult::True;
+
+	if (someUnknown)
+		return EvaluationResult::Unknown;
+
+	return EvaluationResult::False;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class ArgumentRange, class TypeOfArgument>
+EvaluationResult evaluatePredicate(const ast::PredicateDeclaration &declaration, const ArgumentRange &arguments, TypeOfArgument typeOfArgument)
+{
+	assert(arguments.size() == declaration.arity());
+
+	for (size_t i = 0; i < arguments.size(); i++)
+	{
+		const auto &parameter = declaration.parameters[i];
+
+		if (parameter.domain != Domain::Integer)
+			continue;
+
+		const auto argumentType = typeOfArgument(arguments[i]);
+
+		if (argumentType.domain == Domain::Symbolic || argumentType.setSize == SetSize::Empty)
+			return EvaluationResult::Error;
+	}
+
+	return EvaluationResult::Unknown;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <class VariableDomainAccessor = DefaultVariableDomainAccessor>
+struct EvaluateFormulaVisitor
+{
+	template <class... Arguments>
+	static EvaluationResult visit(const ast::And &and_, Arguments &&... arguments)
+	{
+		return evaluateAnd(and_.arguments,
+			[&](const auto &argument)
+			{
+				return evaluate(argument, std::forward<Arguments>(arguments)...);
+			});
 	}
 
 	template <class... Arguments>
@@ -58,13 +236,7 @@ struct EvaluateFormulaVisitor
 		const auto leftResult = evaluate(biconditional.left, std::forward<Arguments>(arguments)...);
 		const auto rightResult = evaluate(biconditional.right, std::forward<Arguments>(arguments)...);
 
-		if (leftResult == EvaluationResult::Error || rightResult == EvaluationResult::Error)
-			return EvaluationResult::Error;
-
-		if (leftResult == EvaluationResult::Unknown || rightResult == EvaluationResult::Unknown)
-			return EvaluationResult::Unknown;
-
-		return (leftResult == rightResult ? EvaluationResult::True : EvaluationResult::False);
+		return evaluateBiconditional(leftResult, rightResult);
 	}
 
 	template <class... Arguments>
@@ -79,37 +251,7 @@ struct EvaluateFormulaVisitor
 		const auto leftType = type(comparison.left, std::forward<Arguments>(arguments)...);
 		const auto rightType = type(comparison.right, std::forward<Arguments>(arguments)...);
 
-		// Comparisons with empty sets always return false
-		if (leftType.setSize == SetSize::Empty || rightType.setSize == SetSize::Empty)
-			return EvaluationResult::False;
-
-		// If either side has an unknown domain, the result is unknown
-		if (leftType.domain == Domain::Unknown || rightType.domain == Domain::Unknown)
-			return EvaluationResult::Unknown;
-
-		// If both sides have the same domain, the result is unknown
-		if (leftType.domain == rightType.domain)
-			return EvaluationResult::Unknown;
-
-		// If one side is integer, but the other one isn’t, they are not equal
-		switch (comparison.operator_)
-		{
-			case ast::Comparison::Operator::Equal:
-				return EvaluationResult::False;
-			case ast::Comparison::Operator::NotEqual:
-				return EvaluationResult::True;
-			// Integers are smaller than symbolic constants
-			case ast::Comparison::Operator::LessThan:
-				return (leftType.domain == Domain::Integer) ? EvaluationResult::True : EvaluationResult::False;
-			case ast::Comparison::Operator::LessEqual:
-				return (leftType.domain == Domain::Integer) ? EvaluationResult::True : EvaluationResult::False;
-			case ast::Comparison::Operator::GreaterEqual:
-				return (rightType.domain == Domain::Integer) ? EvaluationResult::True : EvaluationResult::False;
-			case ast::Comparison::Operator::GreaterThan:
-				return (rightType.domain == Domain::Integer) ? EvaluationResult::True : EvaluationResult::False;
-		}
-
-		throw TranslationException("unknown operator, please report to bug tracker");
+		return evaluateComparison(comparison.operator_, leftType, rightType);
 	}
 
 	template <class... Arguments>
@@ -130,19 +272,7 @@ struct EvaluateFormulaVisitor
 		const auto antecedentResult = evaluate(implies.antecedent, std::forward<Arguments>(arguments)...);
 		const auto consequentResult = evaluate(implies.consequent, std::forward<Arguments>(arguments)...);
 
-		if (antecedentResult == EvaluationResult::Error || consequentResult == EvaluationResult::Error)
-			return EvaluationResult::Error;
-
-		if (antecedentResult == EvaluationResult::False)
-			return EvaluationResult::True;
-
-		if (consequentResult == EvaluationResult::True)
-			return EvaluationResult::True;
-
-		if (antecedentResult == EvaluationResult::True && consequentResult == EvaluationResult::False)
-			return EvaluationResult::False;
-
-		return EvaluationResult::Unknown;
+		return evaluateImplies(antecedentResult, consequentResult);
 	}
 
 	template <class... Arguments>
@@ -151,23 +281,7 @@ struct EvaluateFormulaVisitor
 		const auto elementType = type(in.element, std::forward<Arguments>(arguments)...);
 		const auto setType = type(in.set, std::forward<Arguments>(arguments)...);
 
-		// The element to test shouldn’t be empty or a proper set by itself
-		assert(elementType.setSize != SetSize::Empty && elementType.setSize != SetSize::Multi);
-
-		// If the set is empty, no element can be selected
-		if (setType.setSize == SetSize::Empty)
-			return EvaluationResult::False;
-
-		// If one of the sides has an unknown type, the result is unknown
-		if (elementType.domain == Domain::Unknown || setType.domain == Domain::Unknown)
-			return EvaluationResult::Unknown;
-
-		// If both sides have the same domain, the result is unknown
-		if (elementType.domain == setType.domain)
-			return EvaluationResult::Unknown;
-
-		// If one side is integer, but the other one isn’t, set inclusion is never satisfied
-		return EvaluationResult::False;
+		return evaluateIn(elementType, setType);
 	}
 
 	template <class... Arguments>
@@ -175,66 +289,27 @@ struct EvaluateFormulaVisitor
 	{
 		const auto result = evaluate(not_.argument, std::forward<Arguments>(arguments)...);
 
-		if (result == EvaluationResult::Error || result == EvaluationResult::Unknown)
-			return result;
-
-		return (result == EvaluationResult::True ? EvaluationResult::False : EvaluationResult::True);
+		return evaluateNot(result);
 	}
 
 	template <class... Arguments>
 	static EvaluationResult visit(const ast::Or &or_, Arguments &&... arguments)
 	{
-		bool someTrue = false;
-		bool someUnknown = false;
-
-		for (const auto &argument : or_.arguments)
-		{
-			const auto result = evaluate(argument, std::forward<Arguments>(arguments)...);
-
-			switch (result)
+		return evaluateOr(or_.arguments,
+			[&](const auto &argument)
 			{
-				case EvaluationResult::Error:
-					return EvaluationResult::Error;
-				case EvaluationResult::True:
-					someTrue = true;
-					break;
-				case EvaluationResult::False:
-					break;
-				case EvaluationResult::Unknown:
-					someUnknown = true;
-					break;
-			}
-		}
-
-		if (someTrue)
-			return EvaluationResult::True;
-
-		if (someUnknown)
-			return EvaluationResult::Unknown;
-
-		return EvaluationResult::False;
+				return evaluate(argument, std::forward<Arguments>(arguments)...);
+			});
 	}
 
 	template <class... Arguments>
 	static EvaluationResult visit(const ast::Predicate &predicate, Arguments &&... arguments)
 	{
-		assert(predicate.arguments.size() == predicate.declaration->arity());
-
-		for (size_t i = 0; i < predicate.arguments.size(); i++)
-		{
-			const auto &argument = predicate.arguments[i];
-			const auto &parameter = predicate.declaration->parameters[i];
-
-			if (parameter.domain != Domain::Integer)
-				continue;
-
-			const auto argumentType = type(argument, std::forward<Arguments>(arguments)...);
-
-			if (argumentType.domain == Domain::Symbolic || argumentType.setSize == SetSize::Empty)
-				return EvaluationResult::Error;
-		}
-
-		return EvaluationResult::Unknown;
+		return evaluatePredicate(*predicate.declaration, predicate.arguments,
+			[&](const auto &argument)
+			{
+				return type(argument, std::forward<Arguments>(arguments)...);
+			});
 	}
 };
 
@@ -248,6 +323,61 @@ EvaluationResult evaluate(const ast::Formula &formula, Arguments &&... arguments
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+template <class VariableDomainAccessor = DefaultVariableDomainAccessor, class... Arguments>
+EvaluationResult evaluate(const flat::Tree &tree, flat::NodeIndex node, Arguments &&... arguments)
+{
+	const auto children = tree.children(node);
+
+	const auto evaluateChild =
+		[&](flat::NodeIndex child)
+		{
+			return evaluate<VariableDomainAccessor>(tree, child, std::forward<Arguments>(arguments)...);
+		};
+
+	const auto typeOfChild =
+		[&](flat::NodeIndex child)
+		{
+			return type<VariableDomainAccessor>(tree, child, std::forward<Arguments>(arguments)...);
+		};
+
+	switch (tree.type(node))
+	{
+		case flat::NodeType::And:
+			return evaluateAnd(children, evaluateChild);
+		case flat::NodeType::Biconditional:
+			return evaluateBiconditional(evaluateChild(children[0]), evaluateChild(children[1]));
+		case flat::NodeType::Boolean:
+			return (tree.booleanValue(node) ? EvaluationResult::True : EvaluationResult::False);
+		case flat::NodeType::Comparison:
+			return evaluateComparison(tree.operator_<ast::Comparison::Operator>(node), typeOfChild(children[0]), typeOfChild(children[1]));
+		// The argument of a quantified formula is its last child
+		case flat::NodeType::Exists:
+		case flat::NodeType::ForAll:
+			return evaluateChild(children.back());
+		case flat::NodeType::Implies:
+		{
+			const auto antecedentResult = evaluateChild(children[0]);
+			const auto consequentResult = evaluateChild(children[1]);
+
+			return evaluateImplies(antecedentResult, consequentResult);
+		}
+		case flat::NodeType::In:
+			return evaluateIn(typeOfChild(children[0]), typeOfChild(children[1]));
+		case flat::NodeType::Not:
+			return evaluateNot(evaluateChild(children[0]));
+		case flat::NodeType::Or:
+			return evaluateOr(children, evaluateChild);
+		case flat::NodeType::Predicate:
+			return evaluatePredicate(*tree.predicateDeclaration(node), children, typeOfChild);
+		default:
+			break;
+	}
+
+	throw LogicException("flat AST node is not a formula, please report to bug tracker");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 }
 
 #endif
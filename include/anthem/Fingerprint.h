@@ -0,0 +1,69 @@
+#ifndef __ANTHEM__FINGERPRINT_H
+#define __ANTHEM__FINGERPRINT_H
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <anthem/AST.h>
+
+namespace anthem
+{
+namespace ast
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Fingerprint
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Structural hashes of formulas and terms
+// Formulas and terms that are equal according to ast::equal always have the same fingerprint, so differing
+// fingerprints rule out equality without a full comparison. Fingerprints respect the same symmetries as
+// ast::equal (such as the order of conjunctions and disjunctions). Bound variables are identified by the
+// position they are bound at rather than by their declaration, so renaming bound variables leaves the
+// fingerprint unchanged. Fingerprints are not stored in the AST, as they would be invalidated whenever a
+// formula is modified in place
+using Fingerprint = uint64_t;
+
+Fingerprint fingerprint(const Formula &formula);
+Fingerprint fingerprint(const Term &term);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The variables bound by the enclosing quantifiers, innermost last
+using BoundVariableLayers = std::vector<const VariableDeclarationPointers *>;
+
+// Position of a bound variable, given by the distance to its quantifier and the index within that quantifier
+using BoundVariablePosition = std::pair<size_t, size_t>;
+
+std::optional<BoundVariablePosition> findBoundVariable(const VariableDeclaration *variableDeclaration,
+	const BoundVariableLayers &boundVariableLayers);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Remembers the fingerprints of formulas and of all formulas nested in them outside of quantifiers, so
+// that each of them is computed only once. Only valid as long as none of these formulas is modified or
+// destroyed, so users rewriting formulas in place need to clear the cache after each rewrite. The table is
+// only allocated once the first fingerprint is requested
+class FingerprintCache
+{
+	public:
+		Fingerprint fingerprint(const Formula &formula);
+		// Fingerprint of a formula nested in the given quantifiers, which is not remembered
+		Fingerprint fingerprint(const Formula &formula, const BoundVariableLayers &boundVariableLayers);
+
+		void clear();
+
+	private:
+		std::optional<std::unordered_map<const Formula *, Fingerprint>> m_fingerprints;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#endif
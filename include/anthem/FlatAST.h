@@ -0,0 +1,244 @@
+#ifndef __ANTHEM__FLAT_AST_H
+#define __ANTHEM__FLAT_AST_H
+
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <anthem/AST.h>
+
+namespace anthem
+{
+namespace flat
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Flat AST
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Compact alternative to the pointer-linked AST, storing all nodes of a tree in parallel arrays
+// Nodes are stored in preorder, and the children of each node occupy a contiguous range. Formulas and
+// terms share the same node types, whether a Boolean is a formula or a term follows from its parent
+
+using NodeIndex = uint32_t;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+enum class NodeType : uint8_t
+{
+	// Formulas
+	And,
+	Biconditional,
+	Comparison,
+	Exists,
+	ForAll,
+	Implies,
+	In,
+	Not,
+	Or,
+	Predicate,
+	// Formulas and terms
+	Boolean,
+	// Terms
+	BinaryOperation,
+	Function,
+	Integer,
+	Interval,
+	SpecialInteger,
+	String,
+	UnaryOperation,
+	Variable
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class Children
+{
+	public:
+		Children(const NodeIndex *begin, const NodeIndex *end)
+		:	m_begin{begin},
+			m_end{end}
+		{
+		}
+
+		const NodeIndex *begin() const
+		{
+			return m_begin;
+		}
+
+		const NodeIndex *end() const
+		{
+			return m_end;
+		}
+
+		size_t size() const
+		{
+			return m_end - m_begin;
+		}
+
+		bool empty() const
+		{
+			return m_begin == m_end;
+		}
+
+		NodeIndex operator[](size_t index) const
+		{
+			return m_begin[index];
+		}
+
+		NodeIndex back() const
+		{
+			return *(m_end - 1);
+		}
+
+	private:
+		const NodeIndex *m_begin;
+		const NodeIndex *m_end;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The children of the node types are laid out as follows:
+// - BinaryOperation, Biconditional, Comparison, Implies, In, Interval: left and right operand
+// - And, Or: arguments
+// - Exists, ForAll: one Variable node per bound variable, followed by the argument
+// - Function, Predicate: arguments
+// - Not, UnaryOperation: argument
+// - all other node types are leaves
+//
+// Bound variables are owned by the tree, while variables bound outside of the converted formula (such as
+// the free variables of scoped formulas) are referenced and need to outlive the tree
+class Tree
+{
+	public:
+		Tree() = default;
+
+		Tree(const Tree &other) = delete;
+		Tree &operator=(const Tree &other) = delete;
+		Tree(Tree &&other) = default;
+		Tree &operator=(Tree &&other) = default;
+
+		// Append a copy of an AST formula or term and return the index of its root node
+		NodeIndex add(const ast::Formula &formula);
+		NodeIndex add(const ast::Term &term);
+
+		// Convert nodes back into the pointer-linked AST, bound variables are declared anew
+		ast::Formula toFormula(NodeIndex node) const;
+		ast::Term toTerm(NodeIndex node) const;
+
+		size_t size() const noexcept
+		{
+			return m_types.size();
+		}
+
+		NodeType type(NodeIndex node) const
+		{
+			return m_types[node];
+		}
+
+		Children children(NodeIndex node) const
+		{
+			const auto *begin = m_children.data() + m_firstChildren[node];
+			return Children(begin, begin + m_numbersOfChildren[node]);
+		}
+
+		// Operator of a BinaryOperation, Comparison, or UnaryOperation node
+		template<class Operator>
+		Operator operator_(NodeIndex node) const
+		{
+			return static_cast<Operator>(m_values[node]);
+		}
+
+		bool booleanValue(NodeIndex node) const
+		{
+			assert(m_types[node] == NodeType::Boolean);
+			return (m_values[node] != 0);
+		}
+
+		int integerValue(NodeIndex node) const
+		{
+			assert(m_types[node] == NodeType::Integer);
+			return m_values[node];
+		}
+
+		ast::SpecialInteger::Type specialIntegerType(NodeIndex node) const
+		{
+			assert(m_types[node] == NodeType::SpecialInteger);
+			return static_cast<ast::SpecialInteger::Type>(m_values[node]);
+		}
+
+		const std::string &string(NodeIndex node) const
+		{
+			assert(m_types[node] == NodeType::String);
+			return m_strings[m_values[node]];
+		}
+
+		ast::FunctionDeclaration *functionDeclaration(NodeIndex node) const
+		{
+			assert(m_types[node] == NodeType::Function);
+			return m_functionDeclarations[m_values[node]];
+		}
+
+		ast::PredicateDeclaration *predicateDeclaration(NodeIndex node) const
+		{
+			assert(m_types[node] == NodeType::Predicate);
+			return m_predicateDeclarations[m_values[node]];
+		}
+
+		ast::VariableDeclaration *variableDeclaration(NodeIndex node) const
+		{
+			assert(m_types[node] == NodeType::Variable);
+			return m_variableDeclarations[m_values[node]];
+		}
+
+	private:
+		using VariableDeclarationMap = std::unordered_map<const ast::VariableDeclaration *, ast::VariableDeclaration *>;
+
+		struct FormulaConverter;
+		struct TermConverter;
+
+		NodeIndex addNode(NodeType type, int32_t value, size_t numberOfChildren);
+		NodeIndex addVariable(ast::VariableDeclaration *variableDeclaration);
+		NodeIndex addFormula(const ast::Formula &formula, VariableDeclarationMap &boundVariables);
+		NodeIndex addTerm(const ast::Term &term, const VariableDeclarationMap &boundVariables);
+
+		ast::Formula toFormula(NodeIndex node, VariableDeclarationMap &boundVariables) const;
+		ast::Term toTerm(NodeIndex node, const VariableDeclarationMap &boundVariables) const;
+
+		// Per node
+		std::vector<NodeType> m_types;
+		std::vector<uint32_t> m_firstChildren;
+		std::vector<uint32_t> m_numbersOfChildren;
+		// Operators, Boolean and integer values, or indices into the side tables
+		std::vector<int32_t> m_values;
+
+		std::vector<NodeIndex> m_children;
+
+		// Side tables
+		std::vector<ast::FunctionDeclaration *> m_functionDeclarations;
+		std::vector<ast::PredicateDeclaration *> m_predicateDeclarations;
+		std::vector<ast::VariableDeclaration *> m_variableDeclarations;
+		std::vector<std::string> m_strings;
+
+		ast::VariableDeclarationPointers m_boundVariableDeclarations;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Refers to a node in a tree, for example to print it
+struct Node
+{
+	const Tree &tree;
+	NodeIndex index;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#endif
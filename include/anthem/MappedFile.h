@@ -0,0 +1,52 @@
+#ifndef __ANTHEM__MAPPED_FILE_H
+#define __ANTHEM__MAPPED_FILE_H
+
+#include <cstddef>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// MappedFile
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Read-only memory mapping of a regular file, terminated by a null character like a C string
+// The mapping doesn’t take a snapshot of the file, which must thus not change while it is mapped
+class MappedFile
+{
+	public:
+		// Leaves the file unmapped if it is not a regular file (such as a pipe) or cannot be mapped
+		explicit MappedFile(const char *fileName);
+		~MappedFile();
+
+		MappedFile(const MappedFile &other) = delete;
+		MappedFile &operator=(const MappedFile &other) = delete;
+
+		bool isMapped() const
+		{
+			return m_data != nullptr;
+		}
+
+		const char *data() const
+		{
+			return m_data;
+		}
+
+		size_t size() const
+		{
+			return m_size;
+		}
+
+	private:
+		const char *m_data{nullptr};
+		size_t m_size{0};
+		size_t m_mappingSize{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef __ANTHEM__PROFILER_H
+#define __ANTHEM__PROFILER_H
+
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <anthem/ASTForward.h>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Profiler
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Records the duration of translation phases and the size of the AST in the Chrome trace event format
+class Profiler
+{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		// Records a span from construction to destruction, does nothing if no profiler is given
+		class Span
+		{
+			public:
+				Span(Profiler *profiler, std::string &&name);
+				~Span();
+
+				Span(const Span &other) = delete;
+				Span &operator=(const Span &other) = delete;
+
+			private:
+				Profiler *m_profiler;
+				std::string m_name;
+				Clock::time_point m_startTime;
+		};
+
+	public:
+		// If requested, also record spans for individual predicates and formulas
+		explicit Profiler(bool recordDetails);
+
+		// Returns the profiler only if it records spans for individual predicates and formulas
+		static Profiler *details(Profiler *profiler);
+
+		void recordSpan(std::string &&name, Clock::time_point startTime, Clock::time_point endTime);
+		void recordCounter(const char *name, size_t value);
+
+		void write(std::ostream &stream) const;
+
+	private:
+		struct Event
+		{
+			std::string name;
+			char phase;
+			size_t threadID;
+			Clock::time_point time;
+			Clock::duration duration;
+			size_t value;
+		};
+
+		const bool m_recordDetails;
+		const Clock::time_point m_startTime;
+
+		mutable std::mutex m_mutex;
+		std::vector<Event> m_events;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Records the total number of AST nodes after a translation phase, does nothing if no profiler is given
+void recordNumberOfNodes(Profiler *profiler, std::vector<ast::Formula> &formulas);
+void recordNumberOfNodes(Profiler *profiler, std::vector<ast::ScopedFormula> &scopedFormulas);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
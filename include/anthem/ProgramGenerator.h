@@ -0,0 +1,45 @@
+#ifndef __ANTHEM__PROGRAM_GENERATOR_H
+#define __ANTHEM__PROGRAM_GENERATOR_H
+
+#include <cstdint>
+#include <string>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// ProgramGenerator
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct ProgramGeneratorOptions
+{
+	size_t numberOfPredicates{10};
+	size_t rulesPerPredicate{3};
+	size_t bodyLength{2};
+	size_t arity{2};
+
+	// Shares of rules that are choice rules and of arguments that are pools or intervals
+	double choiceRuleShare{0.1};
+	double poolShare{0.05};
+	double intervalShare{0.1};
+
+	// Shares of predicates that are shown and that are declared #external
+	double showDensity{1.0};
+	double externalDensity{0.1};
+
+	uint32_t seed{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Generates a random program for load testing. Predicates only depend on predicates generated before
+// them, the first ones of which are declared #external. The same options always yield the same program
+std::string generateProgram(const ProgramGeneratorOptions &options);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
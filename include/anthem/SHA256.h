@@ -0,0 +1,46 @@
+#ifndef __ANTHEM__SHA256_H
+#define __ANTHEM__SHA256_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// SHA256
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Incremental computation of SHA-256 hashes (FIPS 180-4)
+class SHA256
+{
+	public:
+		SHA256();
+
+		void update(const void *data, size_t size);
+		void update(const std::string &string)
+		{
+			update(string.data(), string.size());
+		}
+
+		// Finishes the computation and returns the hash as a string of 64 hexadecimal digits
+		std::string hexadecimalDigest();
+
+	private:
+		void processBlock(const uint8_t *block);
+
+		std::array<uint32_t, 8> m_state;
+		std::array<uint8_t, 64> m_block;
+		size_t m_blockSize{0};
+		uint64_t m_totalSize{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef __ANTHEM__SERVER_H
+#define __ANTHEM__SERVER_H
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <anthem/Arena.h>
+#include <anthem/Context.h>
+
+namespace anthem
+{
+
+class StatementCache;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Server
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Answers translation requests with a fresh context per request, configured like the given one.
+// Memory allocated for a request and the translations of its statements are kept for the next ones
+class Server
+{
+	public:
+		explicit Server(Context &context);
+
+		// Translates the program of a request given as a JSON object on one line, and returns the reply
+		// as a JSON object on one line
+		std::string handleRequest(const std::string &request);
+
+		// Answers the requests read from the stream, one per line, until it ends
+		void serve(std::istream &requests, std::ostream &replies);
+		// Listens on a Unix domain socket that only the owner may connect to and answers the requests of one connection after the other
+		void serveOnSocket(const std::string &socketPath);
+
+	private:
+		Context &m_context;
+
+		// Holds the memory of the previous request’s arena, up to the amount that arena used
+		Arena m_spareArena;
+		std::shared_ptr<StatementCache> m_statementCache;
+		std::stringstream m_output;
+		std::stringstream m_diagnostics;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
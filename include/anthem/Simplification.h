@@ -1,6 +1,9 @@
 #ifndef __ANTHEM__SIMPLIFICATION_H
 #define __ANTHEM__SIMPLIFICATION_H
 
+#include <chrono>
+#include <vector>
+
 #include <anthem/AST.h>
 
 namespace anthem
@@ -12,7 +15,29 @@ namespace anthem
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+struct SimplificationRuleStatistics
+{
+	const char *description;
+	size_t numberOfAttempts{0};
+	size_t numberOfRewrites{0};
+	std::chrono::nanoseconds time{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Statistics collected while simplifying a single formula
+struct SimplificationStatistics
+{
+	// One entry per simplification rule, in the order in which the rules are tried
+	std::vector<SimplificationRuleStatistics> rules;
+	// Number of times the simplification rules were applied to a (sub)formula until reaching the fixpoint
+	size_t numberOfIterations{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void simplify(ast::Formula &formula);
+void simplify(ast::Formula &formula, SimplificationStatistics &statistics);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -16,103 +16,121 @@ namespace ast
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Simplifies formulas bottom-up, where T::accept applies the simplification rules to a single formula
+// Subformulas are simplified to a local fixpoint before their parents are considered. After a successful rewrite,
+// only the rewritten formula is examined again, so that rewrites never require restarting from the root
 template<class T>
 struct FormulaSimplificationVisitor
 {
 	template <class... Arguments>
-	OperationResult visit(And &and_, Formula &formula, Arguments &&... arguments)
+	static OperationResult simplify(Formula &formula, Arguments &... arguments)
 	{
-		for (auto &argument : and_.arguments)
-			if (argument.accept(*this, argument, std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-				return OperationResult::Changed;
+		auto result = formula.accept(FormulaSimplificationVisitor(), formula, arguments...);
+
+		while (T::accept(formula, arguments...) == OperationResult::Changed)
+		{
+			result = OperationResult::Changed;
 
-		return T::accept(formula, std::forward<Arguments>(arguments)...);
+			// The rewritten formula may contain new subformulas that need to be simplified first
+			formula.accept(FormulaSimplificationVisitor(), formula, arguments...);
+		}
+
+		return result;
 	}
 
+	// The visit functions simplify the subformulas of the visited formula
 	template <class... Arguments>
-	OperationResult visit(Biconditional &biconditional, Formula &formula, Arguments &&... arguments)
+	OperationResult visit(And &and_, Formula &, Arguments &... arguments)
 	{
-		if (biconditional.left.accept(*this, biconditional.left, std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-			return OperationResult::Changed;
+		auto result = OperationResult::Unchanged;
 
-		if (biconditional.right.accept(*this, biconditional.right, std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-			return OperationResult::Changed;
+		for (auto &argument : and_.arguments)
+			if (simplify(argument, arguments...) == OperationResult::Changed)
+				result = OperationResult::Changed;
 
-		return T::accept(formula, std::forward<Arguments>(arguments)...);
+		return result;
 	}
 
 	template <class... Arguments>
-	OperationResult visit(Boolean &, Formula &formula, Arguments &&... arguments)
+	OperationResult visit(Biconditional &biconditional, Formula &, Arguments &... arguments)
 	{
-		return T::accept(formula, std::forward<Arguments>(arguments)...);
+		const auto leftResult = simplify(biconditional.left, arguments...);
+		const auto rightResult = simplify(biconditional.right, arguments...);
+
+		return combine(leftResult, rightResult);
 	}
 
 	template <class... Arguments>
-	OperationResult visit(Comparison &, Formula &formula, Arguments &&... arguments)
+	OperationResult visit(Boolean &, Formula &, Arguments &...)
 	{
-		return T::accept(formula, std::forward<Arguments>(arguments)...);
+		return OperationResult::Unchanged;
 	}
 
 	template <class... Arguments>
-	OperationResult visit(Exists &exists, Formula &formula, Arguments &&... arguments)
+	OperationResult visit(Comparison &, Formula &, Arguments &...)
 	{
-		if (exists.argument.accept(*this, exists.argument, std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-			return OperationResult::Changed;
-
-		return T::accept(formula, std::forward<Arguments>(arguments)...);
+		return OperationResult::Unchanged;
 	}
 
 	template <class... Arguments>
-	OperationResult visit(ForAll &forAll, Formula &formula, Arguments &&... arguments)
+	OperationResult visit(Exists &exists, Formula &, Arguments &... arguments)
 	{
-		if (forAll.argument.accept(*this, forAll.argument, std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-			return OperationResult::Changed;
-
-		return T::accept(formula, std::forward<Arguments>(arguments)...);
+		return simplify(exists.argument, arguments...);
 	}
 
 	template <class... Arguments>
-	OperationResult visit(Implies &implies, Formula &formula, Arguments &&... arguments)
+	OperationResult visit(ForAll &forAll, Formula &, Arguments &... arguments)
 	{
-		if (implies.antecedent.accept(*this, implies.antecedent, std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-			return OperationResult::Changed;
+		return simplify(forAll.argument, arguments...);
+	}
 
-		if (implies.consequent.accept(*this, implies.consequent, std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-			return OperationResult::Changed;
+	template <class... Arguments>
+	OperationResult visit(Implies &implies, Formula &, Arguments &... arguments)
+	{
+		const auto antecedentResult = simplify(implies.antecedent, arguments...);
+		const auto consequentResult = simplify(implies.consequent, arguments...);
 
-		return T::accept(formula, std::forward<Arguments>(arguments)...);
+		return combine(antecedentResult, consequentResult);
 	}
 
 	template <class... Arguments>
-	OperationResult visit(In &, Formula &formula, Arguments &&... arguments)
+	OperationResult visit(In &, Formula &, Arguments &...)
 	{
-		return T::accept(formula, std::forward<Arguments>(arguments)...);
+		return OperationResult::Unchanged;
 	}
 
 	template <class... Arguments>
-	OperationResult visit(Not &not_, Formula &formula, Arguments &&... arguments)
+	OperationResult visit(Not &not_, Formula &, Arguments &... arguments)
 	{
-		if (not_.argument.accept(*this, not_.argument, std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-			return OperationResult::Changed;
-
-		return T::accept(formula, std::forward<Arguments>(arguments)...);
+		return simplify(not_.argument, arguments...);
 	}
 
 	template <class... Arguments>
-	OperationResult visit(Or &or_, Formula &formula, Arguments &&... arguments)
+	OperationResult visit(Or &or_, Formula &, Arguments &... arguments)
 	{
+		auto result = OperationResult::Unchanged;
+
 		for (auto &argument : or_.arguments)
-			if (argument.accept(*this, argument, std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-				return OperationResult::Changed;
+			if (simplify(argument, arguments...) == OperationResult::Changed)
+				result = OperationResult::Changed;
 
-		return T::accept(formula, std::forward<Arguments>(arguments)...);
+		return result;
 	}
 
 	template <class... Arguments>
-	OperationResult visit(Predicate &, Formula &formula, Arguments &&... arguments)
+	OperationResult visit(Predicate &, Formula &, Arguments &...)
 	{
-		return T::accept(formula, std::forward<Arguments>(arguments)...);
+		return OperationResult::Unchanged;
 	}
+
+	private:
+		static OperationResult combine(OperationResult first, OperationResult second)
+		{
+			if (first == OperationResult::Changed || second == OperationResult::Changed)
+				return OperationResult::Changed;
+
+			return OperationResult::Unchanged;
+		}
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,132 @@
+#ifndef __ANTHEM__STATEMENT_CACHE_H
+#define __ANTHEM__STATEMENT_CACHE_H
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <clingo.hh>
+
+#include <anthem/AST.h>
+#include <anthem/Arena.h>
+#include <anthem/Context.h>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// StatementCache
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Keeps the translations of statements and the completed definitions of predicates between the
+// translations of a program that is edited in the meantime, so that only the statements that changed
+// are translated again and only the predicates whose rules changed are completed again. Statements
+// are identified by their text, and messages about a statement are only logged when it is translated
+class StatementCache
+{
+	public:
+		StatementCache();
+		~StatementCache();
+
+		StatementCache(const StatementCache &other) = delete;
+		StatementCache &operator=(const StatementCache &other) = delete;
+
+		// Starts reading a program. Entries that neither of the two previous programs used are discarded,
+		// which keeps those of both programs of an equivalence check
+		void beginProgram(Context &context);
+
+		// Appends the translation of the statement to the formulas, translating it only if it isn’t cached yet
+		void translateStatement(const Clingo::AST::Statement &statement, std::vector<ast::ScopedFormula> &scopedFormulas,
+			Context &context);
+
+		// Returns a copy of the predicate’s completed definition if it was completed from the same rules
+		// before. The definitions are pointers to the formulas of the current program
+		std::optional<ast::Formula> loadCompletedDefinition(const ast::PredicateDeclaration &predicateDeclaration,
+			const std::vector<ast::ScopedFormula *> &definitions, const std::vector<ast::ScopedFormula> &scopedFormulas,
+			Context &context);
+		void storeCompletedDefinition(const ast::PredicateDeclaration &predicateDeclaration,
+			const std::vector<ast::ScopedFormula *> &definitions, const std::vector<ast::ScopedFormula> &scopedFormulas,
+			const ast::Formula &completedDefinition);
+
+		// Statements of the current program, and how many of them weren’t cached
+		size_t numberOfStatements() const
+		{
+			return m_numberOfStatements;
+		}
+
+		size_t numberOfTranslatedStatements() const
+		{
+			return m_numberOfTranslatedStatements;
+		}
+
+		// The same for all programs read so far, for reporting how many statements a translation reused
+		size_t totalNumberOfStatements() const
+		{
+			return m_totalNumberOfStatements;
+		}
+
+		size_t totalNumberOfTranslatedStatements() const
+		{
+			return m_totalNumberOfTranslatedStatements;
+		}
+
+		// Memory held for the cached formulas
+		size_t arenaCapacity() const noexcept
+		{
+			return m_arena.capacity();
+		}
+
+	private:
+		struct Statement
+		{
+			size_t id;
+			// The declarations that the statement introduced and the changes it made to them
+			std::unique_ptr<Context> context;
+			std::vector<ast::ScopedFormula> scopedFormulas;
+			size_t lastUsed;
+		};
+
+		// Formulas of the current program are identified by the statement they stem from and their
+		// position among the statement’s formulas
+		using FormulaOrigin = std::pair<size_t, size_t>;
+
+		struct CompletedDefinition
+		{
+			std::vector<FormulaOrigin> definitions;
+			// Refers to the cache’s own declarations
+			ast::Formula formula;
+			size_t lastUsed;
+		};
+
+		std::optional<std::vector<FormulaOrigin>> formulaOrigins(const std::vector<ast::ScopedFormula *> &definitions,
+			const std::vector<ast::ScopedFormula> &scopedFormulas) const;
+
+		// Holds the AST nodes of the cached formulas and must thus outlive them
+		Arena m_arena;
+		// Only holds the declarations that the cached completed definitions refer to
+		std::unique_ptr<Context> m_declarations;
+
+		TranslationMode m_translationMode{TranslationMode::HereAndThere};
+		std::unordered_map<std::string, Statement> m_statements;
+		std::unordered_map<std::string, CompletedDefinition> m_completedDefinitions;
+
+		// The origins of the formulas of the current program in order
+		std::vector<FormulaOrigin> m_formulaOrigins;
+
+		size_t m_numberOfPrograms{0};
+		size_t m_nextStatementID{0};
+		size_t m_numberOfStatements{0};
+		size_t m_numberOfTranslatedStatements{0};
+		size_t m_totalNumberOfStatements{0};
+		size_t m_totalNumberOfTranslatedStatements{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
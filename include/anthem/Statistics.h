@@ -0,0 +1,50 @@
+#ifndef __ANTHEM__STATISTICS_H
+#define __ANTHEM__STATISTICS_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <anthem/Simplification.h>
+#include <anthem/output/ColorStream.h>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Statistics
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Reading and parsing a single input program
+struct InputStatistics
+{
+	std::string fileName;
+	size_t size;
+	bool isMemoryMapped;
+	std::chrono::nanoseconds time;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Performance statistics collected during a translation if requested
+struct Statistics
+{
+	void add(const SimplificationStatistics &simplificationStatistics);
+	// Summarizes the fixpoint iterations over all formulas, and lists them per formula only if details are requested
+	void print(output::ColorStream &stream, bool printDetails = false) const;
+
+	// In the order in which the input programs were read
+	std::vector<InputStatistics> inputs;
+	// Accumulated over all simplified formulas
+	std::vector<SimplificationRuleStatistics> simplificationRules;
+	// Fixpoint iterations for each simplified formula, in the order of the output
+	std::vector<size_t> numberOfSimplificationIterations;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef __ANTHEM__THREAD_POOL_H
+#define __ANTHEM__THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <anthem/Arena.h>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// ThreadPool
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Work-stealing thread pool for independent tasks identified by consecutive indices
+class ThreadPool
+{
+	public:
+		// The calling thread counts as one of the threads, so a pool with one thread runs all tasks sequentially.
+		// If a list of arenas is given, each of the other threads allocates from an arena of its own, which is
+		// appended to the list on destruction, as the objects allocated from it may outlive the pool
+		explicit ThreadPool(size_t numberOfThreads, std::vector<std::unique_ptr<Arena>> *arenas = nullptr);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool &other) = delete;
+		ThreadPool &operator=(const ThreadPool &other) = delete;
+
+		size_t numberOfThreads() const noexcept;
+
+		// Calls task(i) for all i in [0, count) and returns when all calls are finished. If tasks throw,
+		// the exception of the task with the lowest index is rethrown, just like with sequential execution
+		void forEachIndex(size_t count, const std::function<void(size_t)> &task);
+
+	private:
+		struct Worker
+		{
+			std::mutex mutex;
+			std::deque<size_t> indices;
+			std::unique_ptr<Arena> arena;
+		};
+
+		void run(size_t workerIndex);
+		void processIndices(size_t workerIndex);
+		bool takeIndex(size_t workerIndex, size_t &index);
+
+		std::vector<std::unique_ptr<Worker>> m_workers;
+		std::vector<std::thread> m_threads;
+		std::vector<std::unique_ptr<Arena>> *m_arenas;
+
+		std::mutex m_mutex;
+		std::condition_variable m_workAvailable;
+		std::condition_variable m_workFinished;
+		size_t m_batchID{0};
+		bool m_isStopping{false};
+
+		const std::function<void(size_t)> *m_task{nullptr};
+		std::atomic<size_t> m_numberOfRemainingIndices{0};
+
+		std::mutex m_exceptionMutex;
+		std::exception_ptr m_exception;
+		size_t m_exceptionIndex{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
@@ -15,7 +15,17 @@ namespace anthem
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// A program given as text, along with the name under which it appears in messages
+struct ProgramText
+{
+	std::string name;
+	std::string text;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void translate(const std::vector<std::string> &fileNames, Context &context);
+void translate(const std::vector<ProgramText> &programs, Context &context);
 void translate(const char *fileName, std::istream &stream, Context &context);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,68 @@
+#ifndef __ANTHEM__TRANSLATION_CACHE_H
+#define __ANTHEM__TRANSLATION_CACHE_H
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <anthem/output/ColorStream.h>
+
+namespace anthem
+{
+
+struct Context;
+struct ProgramText;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// TranslationCache
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Directory of translation outputs, each stored in a file named after the hash of the input
+// programs and the options that affect the output. The least recently used outputs are removed
+// once the directory exceeds the maximum size. Several processes may share the same directory
+class TranslationCache
+{
+	public:
+		TranslationCache(std::string directory, size_t maximumSize);
+
+		std::string key(const std::vector<ProgramText> &programs, Context &context) const;
+
+		// Copies the cached output to the stream, returns false if there is none
+		bool load(const std::string &key, std::ostream &stream);
+		void store(const std::string &key, const std::string &output);
+
+		void printStatistics(output::ColorStream &stream) const;
+
+	private:
+		struct Entry
+		{
+			std::string fileName;
+			size_t size;
+			int64_t lastUsed;
+		};
+
+		std::vector<Entry> entries() const;
+		void evict();
+
+		const std::string m_directory;
+		const size_t m_maximumSize;
+
+		// Serializes evictions of the threads of this process
+		std::mutex m_evictionMutex;
+
+		std::atomic<size_t> m_numberOfHits{0};
+		std::atomic<size_t> m_numberOfMisses{0};
+		std::atomic<size_t> m_numberOfStoredEntries{0};
+		std::atomic<size_t> m_numberOfEvictedEntries{0};
+		std::atomic<size_t> m_evictedSize{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
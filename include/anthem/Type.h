@@ -3,6 +3,8 @@
 
 #include <anthem/AST.h>
 #include <anthem/ASTUtils.h>
+#include <anthem/Exception.h>
+#include <anthem/FlatAST.h>
 #include <anthem/Utils.h>
 
 namespace anthem
@@ -19,6 +21,80 @@ Type type(const ast::Term &term, Arguments &&... arguments);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// The types of composite terms are derived from the types of their operands, regardless of the AST representation
+
+inline Type binaryOperationType(ast::BinaryOperation::Operator operator_, const Type &leftType, const Type &rightType)
+{
+	// Binary operations on empty sets return an empty set (also with division)
+	if (leftType.setSize == SetSize::Empty || rightType.setSize == SetSize::Empty)
+		return {Domain::Unknown, SetSize::Empty};
+
+	// Binary operations on symbolic variables return an empty set (also with division)
+	if (leftType.domain == Domain::Symbolic || rightType.domain == Domain::Symbolic)
+		return {Domain::Unknown, SetSize::Empty};
+
+	// Binary operations on unknown types return an unknown set
+	if (leftType.domain == Domain::Unknown || rightType.domain == Domain::Unknown)
+		return {Domain::Unknown, SetSize::Unknown};
+
+	// Divisions return an unknown set
+	if (operator_ == ast::BinaryOperation::Operator::Division)
+		return {Domain::Integer, SetSize::Unknown};
+
+	// Binary operations on integer sets of unknown size return an integer set of unknown size
+	if (leftType.setSize == SetSize::Unknown || rightType.setSize == SetSize::Unknown)
+		return {Domain::Integer, SetSize::Unknown};
+
+	// Binary operations on integer sets with multiple elements return an integer set with multiple elements
+	if (leftType.setSize == SetSize::Multi || rightType.setSize == SetSize::Multi)
+		return {Domain::Integer, SetSize::Multi};
+
+	// Binary operations on plain integers return a plain integer
+	return {Domain::Integer, SetSize::Unit};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline Type intervalType(const Type &fromType, const Type &toType)
+{
+	// Intervals with empty sets return an empty set
+	if (fromType.setSize == SetSize::Empty || toType.setSize == SetSize::Empty)
+		return {Domain::Unknown, SetSize::Empty};
+
+	// Intervals with symbolic variables return an empty set
+	if (fromType.domain == Domain::Symbolic || toType.domain == Domain::Symbolic)
+		return {Domain::Unknown, SetSize::Empty};
+
+	// Intervals with unknown types return an unknown set
+	if (fromType.domain == Domain::Unknown || toType.domain == Domain::Unknown)
+		return {Domain::Unknown, SetSize::Unknown};
+
+	// Intervals with integers generally return integer sets
+	// TODO: handle 1-element intervals such as 1..1 and empty intervals such as 2..1
+	return {Domain::Integer, SetSize::Unknown};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline Type unaryOperationType(const Type &argumentType)
+{
+	// Absolute/negative value of an empty set returns an empty set
+	if (argumentType.setSize == SetSize::Empty)
+		return {Domain::Unknown, SetSize::Empty};
+
+	// Absolute/negative value of symbolic variables returns an empty set
+	if (argumentType.domain == Domain::Symbolic)
+		return {Domain::Unknown, SetSize::Empty};
+
+	// Absolute/negative value of integers returns the same type
+	if (argumentType.domain == Domain::Integer)
+		return argumentType;
+
+	return {Domain::Unknown, SetSize::Unknown};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 template <class VariableDomainAccessor = DefaultVariableDomainAccessor>
 struct TermTypeVisitor
 {
@@ -28,32 +104,7 @@ struct TermTypeVisitor
 		const auto leftType = type<VariableDomainAccessor>(binaryOperation.left, std::forward<Arguments>(arguments)...);
 		const auto rightType = type<VariableDomainAccessor>(binaryOperation.right, std::forward<Arguments>(arguments)...);
 
-		// Binary operations on empty sets return an empty set (also with division)
-		if (leftType.setSize == SetSize::Empty || rightType.setSize == SetSize::Empty)
-			return {Domain::Unknown, SetSize::Empty};
-
-		// Binary operations on symbolic variables return an empty set (also with division)
-		if (leftType.domain == Domain::Symbolic || rightType.domain == Domain::Symbolic)
-			return {Domain::Unknown, SetSize::Empty};
-
-		// Binary operations on unknown types return an unknown set
-		if (leftType.domain == Domain::Unknown || rightType.domain == Domain::Unknown)
-			return {Domain::Unknown, SetSize::Unknown};
-
-		// Divisions return an unknown set
-		if (binaryOperation.operator_ == ast::BinaryOperation::Operator::Division)
-			return {Domain::Integer, SetSize::Unknown};
-
-		// Binary operations on integer sets of unknown size return an integer set of unknown size
-		if (leftType.setSize == SetSize::Unknown || rightType.setSize == SetSize::Unknown)
-			return {Domain::Integer, SetSize::Unknown};
-
-		// Binary operations on integer sets with multiple elements return an integer set with multiple elements
-		if (leftType.setSize == SetSize::Multi || rightType.setSize == SetSize::Multi)
-			return {Domain::Integer, SetSize::Multi};
-
-		// Binary operations on plain integers return a plain integer
-		return {Domain::Integer, SetSize::Unit};
+		return binaryOperationType(binaryOperation.operator_, leftType, rightType);
 	}
 
 	template <class... Arguments>
@@ -80,21 +131,7 @@ struct TermTypeVisitor
 		const auto fromType = type<VariableDomainAccessor>(interval.from, std::forward<Arguments>(arguments)...);
 		const auto toType = type<VariableDomainAccessor>(interval.to, std::forward<Arguments>(arguments)...);
 
-		// Intervals with empty sets return an empty set
-		if (fromType.setSize == SetSize::Empty || toType.setSize == SetSize::Empty)
-			return {Domain::Unknown, SetSize::Empty};
-
-		// Intervals with symbolic variables return an empty set
-		if (fromType.domain == Domain::Symbolic || toType.domain == Domain::Symbolic)
-			return {Domain::Unknown, SetSize::Empty};
-
-		// Intervals with unknown types return an unknown set
-		if (fromType.domain == Domain::Unknown || toType.domain == Domain::Unknown)
-			return {Domain::Unknown, SetSize::Unknown};
-
-		// Intervals with integers generally return integer sets
-		// TODO: handle 1-element intervals such as 1..1 and empty intervals such as 2..1
-		return {Domain::Integer, SetSize::Unknown};
+		return intervalType(fromType, toType);
 	}
 
 	template <class... Arguments>
@@ -117,19 +154,7 @@ struct TermTypeVisitor
 
 		const auto argumentType = type<VariableDomainAccessor>(unaryOperation.argument, std::forward<Arguments>(arguments)...);
 
-		// Absolute/negative value of an empty set returns an empty set
-		if (argumentType.setSize == SetSize::Empty)
-			return {Domain::Unknown, SetSize::Empty};
-
-		// Absolute/negative value of symbolic variables returns an empty set
-		if (argumentType.domain == Domain::Symbolic)
-			return {Domain::Unknown, SetSize::Empty};
-
-		// Absolute/negative value of integers returns the same type
-		if (argumentType.domain == Domain::Integer)
-			return argumentType;
-
-		return {Domain::Unknown, SetSize::Unknown};
+		return unaryOperationType(argumentType);
 	}
 
 	template <class... Arguments>
@@ -151,6 +176,58 @@ Type type(const ast::Term &term, Arguments &&... arguments)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+template <class VariableDomainAccessor = DefaultVariableDomainAccessor, class... Arguments>
+Type type(const flat::Tree &tree, flat::NodeIndex node, Arguments &&... arguments)
+{
+	const auto children = tree.children(node);
+
+	switch (tree.type(node))
+	{
+		case flat::NodeType::BinaryOperation:
+		{
+			const auto leftType = type<VariableDomainAccessor>(tree, children[0], std::forward<Arguments>(arguments)...);
+			const auto rightType = type<VariableDomainAccessor>(tree, children[1], std::forward<Arguments>(arguments)...);
+
+			return binaryOperationType(tree.operator_<ast::BinaryOperation::Operator>(node), leftType, rightType);
+		}
+		case flat::NodeType::Boolean:
+		case flat::NodeType::SpecialInteger:
+		case flat::NodeType::String:
+			return {Domain::Symbolic, SetSize::Unit};
+		case flat::NodeType::Function:
+			return {tree.functionDeclaration(node)->domain, SetSize::Unit};
+		case flat::NodeType::Integer:
+			return {Domain::Integer, SetSize::Unit};
+		case flat::NodeType::Interval:
+		{
+			const auto fromType = type<VariableDomainAccessor>(tree, children[0], std::forward<Arguments>(arguments)...);
+			const auto toType = type<VariableDomainAccessor>(tree, children[1], std::forward<Arguments>(arguments)...);
+
+			return intervalType(fromType, toType);
+		}
+		case flat::NodeType::UnaryOperation:
+		{
+			const auto argumentType = type<VariableDomainAccessor>(tree, children[0], std::forward<Arguments>(arguments)...);
+
+			return unaryOperationType(argumentType);
+		}
+		case flat::NodeType::Variable:
+		{
+			// Variable domain accessors operate on AST variables, which merely wrap the declaration
+			const ast::Variable variable(tree.variableDeclaration(node));
+			const auto domain = VariableDomainAccessor()(variable, std::forward<Arguments>(arguments)...);
+
+			return {domain, SetSize::Unit};
+		}
+		default:
+			break;
+	}
+
+	throw LogicException("flat AST node is not a term, please report to bug tracker");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 }
 
 #endif
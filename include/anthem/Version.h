@@ -0,0 +1,19 @@
+#ifndef __ANTHEM__VERSION_H
+#define __ANTHEM__VERSION_H
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Version
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+constexpr const char *Version = "0.1.9+git";
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
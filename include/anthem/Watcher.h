@@ -0,0 +1,63 @@
+#ifndef __ANTHEM__WATCHER_H
+#define __ANTHEM__WATCHER_H
+
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <anthem/Arena.h>
+#include <anthem/Context.h>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Watcher
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Translates input files again whenever they change, each time with a fresh context configured like
+// the given one. The translations of unchanged statements and the completed definitions of
+// predicates with unchanged rules are reused, as is the memory of previous translations
+class Watcher
+{
+	public:
+		Watcher(std::vector<std::string> fileNames, Context &context);
+		~Watcher();
+
+		Watcher(const Watcher &other) = delete;
+		Watcher &operator=(const Watcher &other) = delete;
+
+		// Translates the files, writing the output to the context’s output stream. Errors are logged
+		// instead of thrown so that watching can go on
+		void translate();
+		// Waits until one of the files is written or replaced, at most for the given time unless it is
+		// negative, and returns whether one was
+		bool waitForChange(int timeoutMilliseconds = -1);
+
+		// Translates the files and then again after every change, until the process is terminated
+		void watch();
+
+	private:
+		bool readEvents();
+
+		std::vector<std::string> m_fileNames;
+		Context &m_context;
+
+		int m_inotifyFileDescriptor{-1};
+		// Pairs of watched directories and names of the files in them
+		std::set<std::pair<int, std::string>> m_watchedFiles;
+
+		// Holds the memory of the previous translation’s arena, up to the amount that arena used
+		Arena m_spareArena;
+		std::shared_ptr<StatementCache> m_statementCache;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
@@ -2,8 +2,11 @@
 #define __ANTHEM__OUTPUT__COLOR_STREAM_H
 
 #include <iostream>
+#include <memory>
 #include <unistd.h>
 
+#include <anthem/output/OutputBuffer.h>
+
 namespace anthem
 {
 namespace output
@@ -31,36 +34,49 @@ class ColorStream
 
 	public:
 		ColorStream(std::ostream &stream)
-		:	m_stream{stream},
-			m_colorPolicy{ColorPolicy::Auto}
+		:	m_stream{&stream},
+			m_targetStream{&stream},
+			m_colorPolicy{ColorPolicy::Auto},
+			m_supportsColor{detectColorSupport(stream, m_colorPolicy)}
 		{
 		}
 
+		ColorStream(ColorStream &&other) = default;
+		ColorStream &operator=(ColorStream &&other) = default;
+
+		ColorStream(const ColorStream &other) = delete;
+		ColorStream &operator=(const ColorStream &other) = delete;
+
 		void setColorPolicy(ColorPolicy colorPolicy)
 		{
 			m_colorPolicy = colorPolicy;
+			m_supportsColor = detectColorSupport(*m_targetStream, m_colorPolicy);
 		}
 
+		// Decided once when the stream or the color policy changes, as this is queried for every token
 		bool supportsColor() const
 		{
-			if (m_colorPolicy == ColorPolicy::Never)
-				return false;
-
-			if (m_colorPolicy == ColorPolicy::Always)
-				return true;
+			return m_supportsColor;
+		}
 
-			if (&m_stream == &std::cout)
-				return isatty(fileno(stdout));
+		// Collects all output in a large buffer that is only written to the underlying stream in chunks
+		void enableBuffering(size_t bufferSize = OutputBuffer::DefaultSize)
+		{
+			if (m_buffering)
+				return;
 
-			if (&m_stream == &std::cerr)
-				return isatty(fileno(stderr));
+			m_buffering = std::make_unique<Buffering>(*m_targetStream, bufferSize);
+			m_stream = &m_buffering->stream;
+		}
 
-			return false;
+		void flush()
+		{
+			m_stream->flush();
 		}
 
 		std::ostream &stream()
 		{
-			return m_stream;
+			return *m_stream;
 		}
 
 		inline ColorStream &operator<<(short value);
@@ -89,15 +105,50 @@ class ColorStream
 		inline ColorStream &operator<<(unsigned char value);
 
 	private:
-		std::ostream &m_stream;
+		struct Buffering
+		{
+			Buffering(std::ostream &targetStream, size_t bufferSize)
+			:	buffer{targetStream.rdbuf(), bufferSize},
+				stream{&buffer}
+			{
+				stream.copyfmt(targetStream);
+			}
+
+			OutputBuffer buffer;
+			std::ostream stream;
+		};
+
+		static bool detectColorSupport(const std::ostream &stream, ColorPolicy colorPolicy)
+		{
+			if (colorPolicy == ColorPolicy::Never)
+				return false;
+
+			if (colorPolicy == ColorPolicy::Always)
+				return true;
+
+			if (&stream == &std::cout)
+				return isatty(fileno(stdout));
+
+			if (&stream == &std::cerr)
+				return isatty(fileno(stderr));
+
+			return false;
+		}
+
+		// The stream written to, which is the internal buffer if buffering is enabled
+		std::ostream *m_stream;
+		std::ostream *m_targetStream;
+		std::unique_ptr<Buffering> m_buffering;
+
 		ColorPolicy m_colorPolicy;
+		bool m_supportsColor;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 ColorStream &ColorStream::operator<<(short value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -105,7 +156,7 @@ ColorStream &ColorStream::operator<<(short value)
 
 ColorStream &ColorStream::operator<<(unsigned short value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -113,7 +164,7 @@ ColorStream &ColorStream::operator<<(unsigned short value)
 
 ColorStream &ColorStream::operator<<(int value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -121,7 +172,7 @@ ColorStream &ColorStream::operator<<(int value)
 
 ColorStream &ColorStream::operator<<(unsigned int value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -129,7 +180,7 @@ ColorStream &ColorStream::operator<<(unsigned int value)
 
 ColorStream &ColorStream::operator<<(long value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -137,7 +188,7 @@ ColorStream &ColorStream::operator<<(long value)
 
 ColorStream &ColorStream::operator<<(unsigned long value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -145,7 +196,7 @@ ColorStream &ColorStream::operator<<(unsigned long value)
 
 ColorStream &ColorStream::operator<<(long long value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -153,7 +204,7 @@ ColorStream &ColorStream::operator<<(long long value)
 
 ColorStream &ColorStream::operator<<(unsigned long long value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -161,7 +212,7 @@ ColorStream &ColorStream::operator<<(unsigned long long value)
 
 ColorStream &ColorStream::operator<<(float value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -169,7 +220,7 @@ ColorStream &ColorStream::operator<<(float value)
 
 ColorStream &ColorStream::operator<<(double value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -177,7 +228,7 @@ ColorStream &ColorStream::operator<<(double value)
 
 ColorStream &ColorStream::operator<<(long double value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -185,7 +236,7 @@ ColorStream &ColorStream::operator<<(long double value)
 
 ColorStream &ColorStream::operator<<(bool value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -193,7 +244,7 @@ ColorStream &ColorStream::operator<<(bool value)
 
 ColorStream &ColorStream::operator<<(const void *value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -201,7 +252,7 @@ ColorStream &ColorStream::operator<<(const void *value)
 
 ColorStream &ColorStream::operator<<(const char *value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -209,7 +260,7 @@ ColorStream &ColorStream::operator<<(const char *value)
 
 ColorStream &ColorStream::operator<<(const signed char *value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -217,7 +268,7 @@ ColorStream &ColorStream::operator<<(const signed char *value)
 
 ColorStream &ColorStream::operator<<(const unsigned char *value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -225,7 +276,7 @@ ColorStream &ColorStream::operator<<(const unsigned char *value)
 
 ColorStream &ColorStream::operator<<(std::basic_streambuf<CharacterType, TraitsType>* sb)
 {
-	m_stream << sb;
+	*m_stream << sb;
 	return *this;
 }
 
@@ -233,7 +284,7 @@ ColorStream &ColorStream::operator<<(std::basic_streambuf<CharacterType, TraitsT
 
 ColorStream &ColorStream::operator<<(std::ios_base &(*func)(std::ios_base &))
 {
-	m_stream << func;
+	*m_stream << func;
 	return *this;
 }
 
@@ -241,7 +292,7 @@ ColorStream &ColorStream::operator<<(std::ios_base &(*func)(std::ios_base &))
 
 ColorStream &ColorStream::operator<<(std::basic_ios<CharacterType, TraitsType> &(*func)(std::basic_ios<CharacterType, TraitsType> &))
 {
-	m_stream << func;
+	*m_stream << func;
 	return *this;
 }
 
@@ -249,7 +300,7 @@ ColorStream &ColorStream::operator<<(std::basic_ios<CharacterType, TraitsType> &
 
 ColorStream &ColorStream::operator<<(std::basic_ostream<CharacterType, TraitsType> &(*func)(std::basic_ostream<CharacterType, TraitsType> &))
 {
-	m_stream << func;
+	*m_stream << func;
 	return *this;
 }
 
@@ -266,7 +317,7 @@ inline ColorStream &operator<<(ColorStream &colorStream, const std::basic_string
 
 ColorStream &ColorStream::operator<<(char value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -274,7 +325,7 @@ ColorStream &ColorStream::operator<<(char value)
 
 ColorStream &ColorStream::operator<<(signed char value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -282,7 +333,7 @@ ColorStream &ColorStream::operator<<(signed char value)
 
 ColorStream &ColorStream::operator<<(unsigned char value)
 {
-	m_stream << value;
+	*m_stream << value;
 	return *this;
 }
 
@@ -1,9 +1,11 @@
 #ifndef __ANTHEM__OUTPUT__FORMATTER_H
 #define __ANTHEM__OUTPUT__FORMATTER_H
 
-#include <map>
+#include <array>
+#include <unordered_map>
 
 #include <anthem/AST.h>
+#include <anthem/FlatAST.h>
 #include <anthem/output/ColorStream.h>
 
 namespace anthem
@@ -17,6 +19,29 @@ namespace output
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Variables are numbered separately for each category, which determines their prefix when printed
+enum class VariableCategory : size_t
+{
+	UserDefined,
+	Head,
+	Body,
+	Integer
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct VariableIDKeyHash
+{
+	size_t operator()(const std::pair<const ast::VariableDeclaration *, VariableCategory> &key) const
+	{
+		return std::hash<const ast::VariableDeclaration *>()(key.first) * 4 + static_cast<size_t>(key.second);
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Variable numbers are only stored in the print context, so that declarations shared between translations
+// may be printed with several print contexts, also concurrently
 struct PrintContext
 {
 	PrintContext(const Context &context)
@@ -29,10 +54,20 @@ struct PrintContext
 	PrintContext(PrintContext &&other) = delete;
 	PrintContext &operator=(PrintContext &&other) = delete;
 
-	std::map<const ast::VariableDeclaration *, size_t> userVariableIDs;
-	std::map<const ast::VariableDeclaration *, size_t> headVariableIDs;
-	std::map<const ast::VariableDeclaration *, size_t> bodyVariableIDs;
-	std::map<const ast::VariableDeclaration *, size_t> integerVariableIDs;
+	// Numbers variables by their first occurrence, starting with 1 in each category
+	size_t variableID(const ast::VariableDeclaration &variableDeclaration, VariableCategory category)
+	{
+		const auto [matchingVariableID, isNewVariable] = variableIDs.try_emplace({&variableDeclaration, category}, 0);
+
+		if (isNewVariable)
+			matchingVariableID->second = ++numbersOfVariables[static_cast<size_t>(category)];
+
+		return matchingVariableID->second;
+	}
+
+	std::array<size_t, 4> numbersOfVariables{};
+	// Declarations printed in more than one category (after their domain changed) keep separate numbers
+	std::unordered_map<std::pair<const ast::VariableDeclaration *, VariableCategory>, size_t, VariableIDKeyHash> variableIDs;
 	size_t currentFormulaID{0};
 	size_t currentTypeID{0};
 
@@ -61,6 +96,110 @@ struct VariantPrintVisitor
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Formatters print compound nodes once for both AST representations, accessing the arguments of the
+// nodes through one of the following accessors
+template<class Formatter>
+struct ASTNodeAccessor
+{
+	template<class Argument>
+	output::ColorStream &print(const Argument &argument, bool omitParentheses) const
+	{
+		return Formatter::print(stream, argument, printContext, omitParentheses);
+	}
+
+	const ast::VariableDeclaration &variableDeclaration(const ast::VariableDeclarationPointer &variable) const
+	{
+		return *variable;
+	}
+
+	output::ColorStream &stream;
+	PrintContext &printContext;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class Formatter>
+struct FlatNodeAccessor
+{
+	output::ColorStream &print(flat::NodeIndex argument, bool omitParentheses) const
+	{
+		return Formatter::print(stream, flat::Node{tree, argument}, printContext, omitParentheses);
+	}
+
+	const ast::VariableDeclaration &variableDeclaration(flat::NodeIndex variable) const
+	{
+		return *tree.variableDeclaration(variable);
+	}
+
+	output::ColorStream &stream;
+	const flat::Tree &tree;
+	PrintContext &printContext;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class Formatter>
+output::ColorStream &printFlat(output::ColorStream &stream, const flat::Node &node, PrintContext &printContext, bool omitParentheses)
+{
+	const auto &tree = node.tree;
+	const auto children = tree.children(node.index);
+	const FlatNodeAccessor<Formatter> accessor{stream, tree, printContext};
+
+	switch (tree.type(node.index))
+	{
+		case flat::NodeType::And:
+			return Formatter::printAnd(stream, children, accessor, printContext, omitParentheses);
+		case flat::NodeType::BinaryOperation:
+			return Formatter::printBinaryOperation(stream, tree.operator_<ast::BinaryOperation::Operator>(node.index),
+				children[0], children[1], accessor, printContext, omitParentheses);
+		case flat::NodeType::Biconditional:
+			return Formatter::printBiconditional(stream, children[0], children[1], accessor, printContext, omitParentheses);
+		case flat::NodeType::Boolean:
+			return Formatter::print(stream, ast::Boolean(tree.booleanValue(node.index)), printContext, omitParentheses);
+		case flat::NodeType::Comparison:
+			return Formatter::printComparison(stream, tree.operator_<ast::Comparison::Operator>(node.index),
+				children[0], children[1], accessor, printContext, omitParentheses);
+		// The bound variables of a quantified formula precede its argument
+		case flat::NodeType::Exists:
+			return Formatter::printExists(stream, flat::Children(children.begin(), children.end() - 1), children.back(),
+				accessor, printContext, omitParentheses);
+		case flat::NodeType::ForAll:
+			return Formatter::printForAll(stream, flat::Children(children.begin(), children.end() - 1), children.back(),
+				accessor, printContext, omitParentheses);
+		case flat::NodeType::Function:
+			return Formatter::printFunction(stream, *tree.functionDeclaration(node.index), children, accessor, printContext,
+				omitParentheses);
+		case flat::NodeType::Implies:
+			return Formatter::printImplies(stream, children[0], children[1], accessor, printContext, omitParentheses);
+		case flat::NodeType::In:
+			return Formatter::printIn(stream, children[0], children[1], accessor, printContext, omitParentheses);
+		case flat::NodeType::Integer:
+			return Formatter::print(stream, ast::Integer(tree.integerValue(node.index)), printContext, omitParentheses);
+		case flat::NodeType::Interval:
+			return Formatter::printInterval(stream, children[0], children[1], accessor, printContext, omitParentheses);
+		case flat::NodeType::Not:
+			return Formatter::printNot(stream, children[0], accessor, printContext, omitParentheses);
+		case flat::NodeType::Or:
+			return Formatter::printOr(stream, children, accessor, printContext, omitParentheses);
+		case flat::NodeType::Predicate:
+			return Formatter::printPredicate(stream, *tree.predicateDeclaration(node.index), children, accessor, printContext,
+				omitParentheses);
+		case flat::NodeType::SpecialInteger:
+			return Formatter::print(stream, ast::SpecialInteger(tree.specialIntegerType(node.index)), printContext, omitParentheses);
+		case flat::NodeType::String:
+			return Formatter::print(stream, ast::String(std::string(tree.string(node.index))), printContext, omitParentheses);
+		case flat::NodeType::UnaryOperation:
+			return Formatter::printUnaryOperation(stream, tree.operator_<ast::UnaryOperation::Operator>(node.index),
+				children[0], accessor, printContext, omitParentheses);
+		case flat::NodeType::Variable:
+			return Formatter::print(stream, *tree.variableDeclaration(node.index), printContext, omitParentheses);
+	}
+
+	return stream;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 }
 }
 
@@ -4,6 +4,7 @@
 #include <cassert>
 
 #include <anthem/AST.h>
+#include <anthem/FlatAST.h>
 #include <anthem/Utils.h>
 #include <anthem/output/ColorStream.h>
 #include <anthem/output/Formatter.h>
@@ -48,15 +49,23 @@ struct FormatterHumanReadable
 	}
 
 	static output::ColorStream &print(output::ColorStream &stream, const ast::BinaryOperation &binaryOperation, PrintContext &printContext, bool omitParentheses)
+	{
+		return printBinaryOperation(stream, binaryOperation.operator_, binaryOperation.left, binaryOperation.right,
+			ASTNodeAccessor<FormatterHumanReadable>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class Argument, class NodeAccessor>
+	static output::ColorStream &printBinaryOperation(output::ColorStream &stream, ast::BinaryOperation::Operator operator_,
+		const Argument &left, const Argument &right, const NodeAccessor &accessor, PrintContext &printContext, bool omitParentheses)
 	{
 		if (!omitParentheses || printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << "(";
 
-		print(stream, binaryOperation.left, printContext, false);
+		accessor.print(left, false);
 		stream << " ";
-		print(stream, binaryOperation.operator_, printContext, true);
+		print(stream, operator_, printContext, true);
 		stream << " ";
-		print(stream, binaryOperation.right, printContext, false);
+		accessor.print(right, false);
 
 		if (!omitParentheses || printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << ")";
@@ -72,16 +81,24 @@ struct FormatterHumanReadable
 		return (stream << output::Boolean("#false"));
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::Comparison &comparison, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::Comparison &comparison, PrintContext &printContext, bool omitParentheses)
+	{
+		return printComparison(stream, comparison.operator_, comparison.left, comparison.right, ASTNodeAccessor<FormatterHumanReadable>{stream, printContext},
+			printContext, omitParentheses);
+	}
+
+	template<class Argument, class NodeAccessor>
+	static output::ColorStream &printComparison(output::ColorStream &stream, ast::Comparison::Operator operator_,
+		const Argument &left, const Argument &right, const NodeAccessor &accessor, PrintContext &printContext, bool)
 	{
 		if (printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << "(";
 
-		print(stream, comparison.left, printContext, false);
+		accessor.print(left, false);
 		stream << " ";
-		print(stream, comparison.operator_, printContext, true);
+		print(stream, operator_, printContext, true);
 		stream << " ";
-		print(stream, comparison.right, printContext, false);
+		accessor.print(right, false);
 
 		if (printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << ")";
@@ -110,24 +127,32 @@ struct FormatterHumanReadable
 		return stream;
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::Function &function, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::Function &function, PrintContext &printContext, bool omitParentheses)
 	{
-		stream << function.declaration->name;
+		return printFunction(stream, *function.declaration, function.arguments, ASTNodeAccessor<FormatterHumanReadable>{stream, printContext}, printContext,
+			omitParentheses);
+	}
 
-		if (function.arguments.empty())
+	template<class ArgumentRange, class NodeAccessor>
+	static output::ColorStream &printFunction(output::ColorStream &stream, const ast::FunctionDeclaration &declaration,
+		const ArgumentRange &arguments, const NodeAccessor &accessor, PrintContext &, bool)
+	{
+		stream << declaration.name;
+
+		if (arguments.empty())
 			return stream;
 
 		stream << "(";
 
-		for (auto i = function.arguments.cbegin(); i != function.arguments.cend(); i++)
+		for (auto i = arguments.begin(); i != arguments.end(); i++)
 		{
-			if (i != function.arguments.cbegin())
+			if (i != arguments.begin())
 				stream << ", ";
 
-			print(stream, *i, printContext, true);
+			accessor.print(*i, true);
 		}
 
-		if (function.declaration->name.empty() && function.arguments.size() == 1)
+		if (declaration.name.empty() && arguments.size() == 1)
 			stream << ",";
 
 		stream << ")";
@@ -135,14 +160,21 @@ struct FormatterHumanReadable
 		return stream;
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::In &in, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::In &in, PrintContext &printContext, bool omitParentheses)
+	{
+		return printIn(stream, in.element, in.set, ASTNodeAccessor<FormatterHumanReadable>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class Argument, class NodeAccessor>
+	static output::ColorStream &printIn(output::ColorStream &stream, const Argument &element, const Argument &set,
+		const NodeAccessor &accessor, PrintContext &printContext, bool)
 	{
 		if (printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << "(";
 
-		print(stream, in.element, printContext, false);
+		accessor.print(element, false);
 		stream << " " << output::Keyword("in") << " ";
-		print(stream, in.set, printContext, false);
+		accessor.print(set, false);
 
 		if (printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << ")";
@@ -156,13 +188,20 @@ struct FormatterHumanReadable
 	}
 
 	static output::ColorStream &print(output::ColorStream &stream, const ast::Interval &interval, PrintContext &printContext, bool omitParentheses)
+	{
+		return printInterval(stream, interval.from, interval.to, ASTNodeAccessor<FormatterHumanReadable>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class Argument, class NodeAccessor>
+	static output::ColorStream &printInterval(output::ColorStream &stream, const Argument &from, const Argument &to,
+		const NodeAccessor &accessor, PrintContext &printContext, bool omitParentheses)
 	{
 		if (!omitParentheses || printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << "(";
 
-		print(stream, interval.from, printContext, false);
+		accessor.print(from, false);
 		stream << "..";
-		print(stream, interval.to, printContext, false);
+		accessor.print(to, false);
 
 		if (!omitParentheses || printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << ")";
@@ -170,21 +209,29 @@ struct FormatterHumanReadable
 		return stream;
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::Predicate &predicate, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::Predicate &predicate, PrintContext &printContext, bool omitParentheses)
 	{
-		stream << predicate.declaration->name;
+		return printPredicate(stream, *predicate.declaration, predicate.arguments, ASTNodeAccessor<FormatterHumanReadable>{stream, printContext}, printContext,
+			omitParentheses);
+	}
 
-		if (predicate.arguments.empty())
+	template<class ArgumentRange, class NodeAccessor>
+	static output::ColorStream &printPredicate(output::ColorStream &stream, const ast::PredicateDeclaration &declaration,
+		const ArgumentRange &arguments, const NodeAccessor &accessor, PrintContext &, bool)
+	{
+		stream << declaration.name;
+
+		if (arguments.empty())
 			return stream;
 
 		stream << "(";
 
-		for (auto i = predicate.arguments.cbegin(); i != predicate.arguments.cend(); i++)
+		for (auto i = arguments.begin(); i != arguments.end(); i++)
 		{
-			if (i != predicate.arguments.cbegin())
+			if (i != arguments.begin())
 				stream << ", ";
 
-			print(stream, *i, printContext, true);
+			accessor.print(*i, true);
 		}
 
 		stream << ")";
@@ -215,9 +262,17 @@ struct FormatterHumanReadable
 		return (stream << output::String(string.text.c_str()));
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::UnaryOperation &unaryOperation, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::UnaryOperation &unaryOperation, PrintContext &printContext, bool omitParentheses)
 	{
-		switch (unaryOperation.operator_)
+		return printUnaryOperation(stream, unaryOperation.operator_, unaryOperation.argument, ASTNodeAccessor<FormatterHumanReadable>{stream, printContext},
+			printContext, omitParentheses);
+	}
+
+	template<class Argument, class NodeAccessor>
+	static output::ColorStream &printUnaryOperation(output::ColorStream &stream, ast::UnaryOperation::Operator operator_,
+		const Argument &argument, const NodeAccessor &accessor, PrintContext &, bool)
+	{
+		switch (operator_)
 		{
 			case ast::UnaryOperation::Operator::Absolute:
 				stream << "|";
@@ -227,9 +282,9 @@ struct FormatterHumanReadable
 				break;
 		}
 
-		print(stream, unaryOperation.argument, printContext, true);
+		accessor.print(argument, true);
 
-		switch (unaryOperation.operator_)
+		switch (operator_)
 		{
 			case ast::UnaryOperation::Operator::Absolute:
 				stream << "|";
@@ -251,33 +306,25 @@ struct FormatterHumanReadable
 	static output::ColorStream &print(output::ColorStream &stream, const ast::VariableDeclaration &variableDeclaration, PrintContext &printContext, bool)
 	{
 		const auto printVariableDeclaration =
-			[&stream, &variableDeclaration](const auto *prefix, auto &variableIDs) -> output::ColorStream &
+			[&stream, &variableDeclaration, &printContext](const auto *prefix, VariableCategory category) -> output::ColorStream &
 			{
-				auto matchingVariableID = variableIDs.find(&variableDeclaration);
-
-				if (matchingVariableID == variableIDs.cend())
-				{
-					auto emplaceResult = variableIDs.emplace(std::make_pair(&variableDeclaration, variableIDs.size() + 1));
-					assert(emplaceResult.second);
-					matchingVariableID = emplaceResult.first;
-				}
-
-				const auto variableName = std::string(prefix) + std::to_string(matchingVariableID->second);
+				const auto variableID = printContext.variableID(variableDeclaration, category);
+				const auto variableName = std::string(prefix) + std::to_string(variableID);
 
 				return (stream << output::Variable(variableName.c_str()));
 			};
 
 		if (variableDeclaration.domain == Domain::Integer)
-			return printVariableDeclaration(IntegerVariablePrefix, printContext.integerVariableIDs);
+			return printVariableDeclaration(IntegerVariablePrefix, VariableCategory::Integer);
 
 		switch (variableDeclaration.type)
 		{
 			case ast::VariableDeclaration::Type::UserDefined:
-				return printVariableDeclaration(UserVariablePrefix, printContext.userVariableIDs);
+				return printVariableDeclaration(UserVariablePrefix, VariableCategory::UserDefined);
 			case ast::VariableDeclaration::Type::Head:
-				return printVariableDeclaration(HeadVariablePrefix, printContext.headVariableIDs);
+				return printVariableDeclaration(HeadVariablePrefix, VariableCategory::Head);
 			case ast::VariableDeclaration::Type::Body:
-				return printVariableDeclaration(BodyVariablePrefix, printContext.bodyVariableIDs);
+				return printVariableDeclaration(BodyVariablePrefix, VariableCategory::Body);
 		}
 
 		return stream;
@@ -288,16 +335,23 @@ struct FormatterHumanReadable
 	////////////////////////////////////////////////////////////////////////////////////////////////
 
 	static output::ColorStream &print(output::ColorStream &stream, const ast::And &and_, PrintContext &printContext, bool omitParentheses)
+	{
+		return printAnd(stream, and_.arguments, ASTNodeAccessor<FormatterHumanReadable>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class ArgumentRange, class NodeAccessor>
+	static output::ColorStream &printAnd(output::ColorStream &stream, const ArgumentRange &arguments, const NodeAccessor &accessor,
+		PrintContext &printContext, bool omitParentheses)
 	{
 		if (!omitParentheses || printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << "(";
 
-		for (auto i = and_.arguments.cbegin(); i != and_.arguments.cend(); i++)
+		for (auto i = arguments.begin(); i != arguments.end(); i++)
 		{
-			if (i != and_.arguments.cbegin())
+			if (i != arguments.begin())
 				stream << " " << output::Keyword("and") << " ";
 
-			print(stream, *i, printContext, false);
+			accessor.print(*i, false);
 		}
 
 		if (!omitParentheses || printContext.context.parenthesisStyle == ParenthesisStyle::Full)
@@ -307,13 +361,20 @@ struct FormatterHumanReadable
 	}
 
 	static output::ColorStream &print(output::ColorStream &stream, const ast::Biconditional &biconditional, PrintContext &printContext, bool omitParentheses)
+	{
+		return printBiconditional(stream, biconditional.left, biconditional.right, ASTNodeAccessor<FormatterHumanReadable>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class Argument, class NodeAccessor>
+	static output::ColorStream &printBiconditional(output::ColorStream &stream, const Argument &left, const Argument &right,
+		const NodeAccessor &accessor, PrintContext &printContext, bool omitParentheses)
 	{
 		if (!omitParentheses || printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << "(";
 
-		print(stream, biconditional.left, printContext, false);
+		accessor.print(left, false);
 		stream << " <-> ";
-		print(stream, biconditional.right, printContext, false);
+		accessor.print(right, false);
 
 		if (!omitParentheses || printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << ")";
@@ -321,23 +382,30 @@ struct FormatterHumanReadable
 		return stream;
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::Exists &exists, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::Exists &exists, PrintContext &printContext, bool omitParentheses)
+	{
+		return printExists(stream, exists.variables, exists.argument, ASTNodeAccessor<FormatterHumanReadable>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class VariableRange, class Argument, class NodeAccessor>
+	static output::ColorStream &printExists(output::ColorStream &stream, const VariableRange &variables, const Argument &argument,
+		const NodeAccessor &accessor, PrintContext &printContext, bool)
 	{
 		if (printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << "(";
 
 		stream << output::Keyword("exists") << " ";
 
-		for (auto i = exists.variables.cbegin(); i != exists.variables.cend(); i++)
+		for (auto i = variables.begin(); i != variables.end(); i++)
 		{
-			if (i != exists.variables.cbegin())
+			if (i != variables.begin())
 				stream << ", ";
 
-			print(stream, **i, printContext, true);
+			print(stream, accessor.variableDeclaration(*i), printContext, true);
 		}
 
 		stream << " ";
-		print(stream, exists.argument, printContext, false);
+		accessor.print(argument, false);
 
 		if (printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << ")";
@@ -345,23 +413,30 @@ struct FormatterHumanReadable
 		return stream;
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::ForAll &forAll, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::ForAll &forAll, PrintContext &printContext, bool omitParentheses)
+	{
+		return printForAll(stream, forAll.variables, forAll.argument, ASTNodeAccessor<FormatterHumanReadable>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class VariableRange, class Argument, class NodeAccessor>
+	static output::ColorStream &printForAll(output::ColorStream &stream, const VariableRange &variables, const Argument &argument,
+		const NodeAccessor &accessor, PrintContext &printContext, bool)
 	{
 		if (printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << "(";
 
 		stream << output::Keyword("forall") << " ";
 
-		for (auto i = forAll.variables.cbegin(); i != forAll.variables.cend(); i++)
+		for (auto i = variables.begin(); i != variables.end(); i++)
 		{
-			if (i != forAll.variables.cbegin())
+			if (i != variables.begin())
 				stream << ", ";
 
-			print(stream, **i, printContext, true);
+			print(stream, accessor.variableDeclaration(*i), printContext, true);
 		}
 
 		stream << " ";
-		print(stream, forAll.argument, printContext, false);
+		accessor.print(argument, false);
 
 		if (printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << ")";
@@ -370,13 +445,20 @@ struct FormatterHumanReadable
 	}
 
 	static output::ColorStream &print(output::ColorStream &stream, const ast::Implies &implies, PrintContext &printContext, bool omitParentheses)
+	{
+		return printImplies(stream, implies.antecedent, implies.consequent, ASTNodeAccessor<FormatterHumanReadable>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class Argument, class NodeAccessor>
+	static output::ColorStream &printImplies(output::ColorStream &stream, const Argument &antecedent, const Argument &consequent,
+		const NodeAccessor &accessor, PrintContext &printContext, bool omitParentheses)
 	{
 		if (!omitParentheses || printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << "(";
 
-		print(stream, implies.antecedent, printContext, false);
+		accessor.print(antecedent, false);
 		stream << " -> ";
-		print(stream, implies.consequent, printContext, false);
+		accessor.print(consequent, false);
 
 		if (!omitParentheses || printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << ")";
@@ -384,13 +466,20 @@ struct FormatterHumanReadable
 		return stream;
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::Not &not_, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::Not &not_, PrintContext &printContext, bool omitParentheses)
+	{
+		return printNot(stream, not_.argument, ASTNodeAccessor<FormatterHumanReadable>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class Argument, class NodeAccessor>
+	static output::ColorStream &printNot(output::ColorStream &stream, const Argument &argument, const NodeAccessor &accessor,
+		PrintContext &printContext, bool)
 	{
 		if (printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << "(";
 
 		stream << output::Keyword("not") << " ";
-		print(stream, not_.argument, printContext, false);
+		accessor.print(argument, false);
 
 		if (printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << ")";
@@ -399,16 +488,23 @@ struct FormatterHumanReadable
 	}
 
 	static output::ColorStream &print(output::ColorStream &stream, const ast::Or &or_, PrintContext &printContext, bool omitParentheses)
+	{
+		return printOr(stream, or_.arguments, ASTNodeAccessor<FormatterHumanReadable>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class ArgumentRange, class NodeAccessor>
+	static output::ColorStream &printOr(output::ColorStream &stream, const ArgumentRange &arguments, const NodeAccessor &accessor,
+		PrintContext &printContext, bool omitParentheses)
 	{
 		if (!omitParentheses || printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << "(";
 
-		for (auto i = or_.arguments.cbegin(); i != or_.arguments.cend(); i++)
+		for (auto i = arguments.begin(); i != arguments.end(); i++)
 		{
-			if (i != or_.arguments.cbegin())
+			if (i != arguments.begin())
 				stream << " " << output::Keyword("or") << " ";
 
-			print(stream, *i, printContext, false);
+			accessor.print(*i, false);
 		}
 
 		if (!omitParentheses || printContext.context.parenthesisStyle == ParenthesisStyle::Full)
@@ -430,6 +526,15 @@ struct FormatterHumanReadable
 	{
 		return term.accept(VariantPrintVisitor<FormatterHumanReadable, ast::Term>(), stream, printContext, omitParentheses);
 	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////
+	// Flat AST
+	////////////////////////////////////////////////////////////////////////////////////////////////
+
+	static output::ColorStream &print(output::ColorStream &stream, const flat::Node &node, PrintContext &printContext, bool omitParentheses)
+	{
+		return printFlat<FormatterHumanReadable>(stream, node, printContext, omitParentheses);
+	}
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
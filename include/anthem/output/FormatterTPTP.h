@@ -5,6 +5,7 @@
 
 #include <anthem/AST.h>
 #include <anthem/Exception.h>
+#include <anthem/FlatAST.h>
 #include <anthem/Utils.h>
 #include <anthem/output/ColorStream.h>
 #include <anthem/output/Formatter.h>
@@ -48,13 +49,21 @@ struct FormatterTPTP
 		return stream;
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::BinaryOperation &binaryOperation, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::BinaryOperation &binaryOperation, PrintContext &printContext, bool omitParentheses)
 	{
-		print(stream, binaryOperation.operator_, printContext, true);
+		return printBinaryOperation(stream, binaryOperation.operator_, binaryOperation.left, binaryOperation.right,
+			ASTNodeAccessor<FormatterTPTP>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class Argument, class NodeAccessor>
+	static output::ColorStream &printBinaryOperation(output::ColorStream &stream, ast::BinaryOperation::Operator operator_,
+		const Argument &left, const Argument &right, const NodeAccessor &accessor, PrintContext &printContext, bool)
+	{
+		print(stream, operator_, printContext, true);
 		stream << "(";
-		print(stream, binaryOperation.left, printContext, false);
+		accessor.print(left, false);
 		stream << ", ";
-		print(stream, binaryOperation.right, printContext, false);
+		accessor.print(right, false);
 		stream << ")";
 
 		return stream;
@@ -68,25 +77,33 @@ struct FormatterTPTP
 		return (stream << output::Boolean("$false"));
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::Comparison &comparison, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::Comparison &comparison, PrintContext &printContext, bool omitParentheses)
 	{
-		if (comparison.operator_ == ast::Comparison::Operator::Equal || comparison.operator_ == ast::Comparison::Operator::NotEqual)
+		return printComparison(stream, comparison.operator_, comparison.left, comparison.right, ASTNodeAccessor<FormatterTPTP>{stream, printContext},
+			printContext, omitParentheses);
+	}
+
+	template<class Argument, class NodeAccessor>
+	static output::ColorStream &printComparison(output::ColorStream &stream, ast::Comparison::Operator operator_,
+		const Argument &left, const Argument &right, const NodeAccessor &accessor, PrintContext &, bool)
+	{
+		if (operator_ == ast::Comparison::Operator::Equal || operator_ == ast::Comparison::Operator::NotEqual)
 		{
 			stream << "(";
-			print(stream, comparison.left, printContext, false);
+			accessor.print(left, false);
 
-			if (comparison.operator_ == ast::Comparison::Operator::Equal)
+			if (operator_ == ast::Comparison::Operator::Equal)
 				stream << " = ";
-			else if (comparison.operator_ == ast::Comparison::Operator::NotEqual)
+			else if (operator_ == ast::Comparison::Operator::NotEqual)
 				stream << " != ";
 
-			print(stream, comparison.right, printContext, false);
+			accessor.print(right, false);
 			stream << ")";
 
 			return stream;
 		}
 
-		switch (comparison.operator_)
+		switch (operator_)
 		{
 			// TODO: rename and reorder for consistency
 			case ast::Comparison::Operator::GreaterThan:
@@ -106,32 +123,40 @@ struct FormatterTPTP
 		}
 
 		stream << "(";
-		print(stream, comparison.left, printContext, false);
+		accessor.print(left, false);
 		stream << ", ";
-		print(stream, comparison.right, printContext, false);
+		accessor.print(right, false);
 		stream << ")";
 
 		return stream;
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::Function &function, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::Function &function, PrintContext &printContext, bool omitParentheses)
 	{
-		stream << function.declaration->name;
+		return printFunction(stream, *function.declaration, function.arguments, ASTNodeAccessor<FormatterTPTP>{stream, printContext}, printContext,
+			omitParentheses);
+	}
+
+	template<class ArgumentRange, class NodeAccessor>
+	static output::ColorStream &printFunction(output::ColorStream &stream, const ast::FunctionDeclaration &declaration,
+		const ArgumentRange &arguments, const NodeAccessor &accessor, PrintContext &, bool)
+	{
+		stream << declaration.name;
 
-		if (function.arguments.empty())
+		if (arguments.empty())
 			return stream;
 
 		stream << "(";
 
-		for (auto i = function.arguments.cbegin(); i != function.arguments.cend(); i++)
+		for (auto i = arguments.begin(); i != arguments.end(); i++)
 		{
-			if (i != function.arguments.cbegin())
+			if (i != arguments.begin())
 				stream << ", ";
 
-			print(stream, *i, printContext, true);
+			accessor.print(*i, true);
 		}
 
-		if (function.declaration->name.empty() && function.arguments.size() == 1)
+		if (declaration.name.empty() && arguments.size() == 1)
 			stream << ",";
 
 		stream << ")";
@@ -139,7 +164,14 @@ struct FormatterTPTP
 		return stream;
 	}
 
-	static output::ColorStream &print(output::ColorStream &, const ast::In &, PrintContext &, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::In &in, PrintContext &printContext, bool omitParentheses)
+	{
+		return printIn(stream, in.element, in.set, ASTNodeAccessor<FormatterTPTP>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class Argument, class NodeAccessor>
+	static output::ColorStream &printIn(output::ColorStream &, const Argument &, const Argument &, const NodeAccessor &,
+		PrintContext &, bool)
 	{
 		throw TranslationException("set inclusion operator not implemented with TPTP, please report to bug tracker");
 	}
@@ -152,26 +184,41 @@ struct FormatterTPTP
 		return (stream << output::Number<int>(integer.value));
 	}
 
-	static output::ColorStream &print(output::ColorStream &, const ast::Interval &, PrintContext &, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::Interval &interval, PrintContext &printContext, bool omitParentheses)
+	{
+		return printInterval(stream, interval.from, interval.to, ASTNodeAccessor<FormatterTPTP>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class Argument, class NodeAccessor>
+	static output::ColorStream &printInterval(output::ColorStream &, const Argument &, const Argument &, const NodeAccessor &,
+		PrintContext &, bool)
 	{
 		throw TranslationException("intervals not implemented with TPTP, please report to bug tracker");
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::Predicate &predicate, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::Predicate &predicate, PrintContext &printContext, bool omitParentheses)
 	{
-		stream << predicate.declaration->name;
+		return printPredicate(stream, *predicate.declaration, predicate.arguments, ASTNodeAccessor<FormatterTPTP>{stream, printContext}, printContext,
+			omitParentheses);
+	}
 
-		if (predicate.arguments.empty())
+	template<class ArgumentRange, class NodeAccessor>
+	static output::ColorStream &printPredicate(output::ColorStream &stream, const ast::PredicateDeclaration &declaration,
+		const ArgumentRange &arguments, const NodeAccessor &accessor, PrintContext &, bool)
+	{
+		stream << declaration.name;
+
+		if (arguments.empty())
 			return stream;
 
 		stream << "(";
 
-		for (auto i = predicate.arguments.cbegin(); i != predicate.arguments.cend(); i++)
+		for (auto i = arguments.begin(); i != arguments.end(); i++)
 		{
-			if (i != predicate.arguments.cbegin())
+			if (i != arguments.begin())
 				stream << ", ";
 
-			print(stream, *i, printContext, false);
+			accessor.print(*i, false);
 		}
 
 		stream << ")";
@@ -194,9 +241,17 @@ struct FormatterTPTP
 		throw TranslationException("strings not implemented with TPTP");
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::UnaryOperation &unaryOperation, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::UnaryOperation &unaryOperation, PrintContext &printContext, bool omitParentheses)
+	{
+		return printUnaryOperation(stream, unaryOperation.operator_, unaryOperation.argument, ASTNodeAccessor<FormatterTPTP>{stream, printContext},
+			printContext, omitParentheses);
+	}
+
+	template<class Argument, class NodeAccessor>
+	static output::ColorStream &printUnaryOperation(output::ColorStream &stream, ast::UnaryOperation::Operator operator_,
+		const Argument &argument, const NodeAccessor &accessor, PrintContext &, bool)
 	{
-		switch (unaryOperation.operator_)
+		switch (operator_)
 		{
 			case ast::UnaryOperation::Operator::Absolute:
 				throw TranslationException("absolute value not implemented with TPTP");
@@ -205,9 +260,9 @@ struct FormatterTPTP
 				break;
 		}
 
-		print(stream, unaryOperation.argument, printContext, true);
+		accessor.print(argument, true);
 
-		switch (unaryOperation.operator_)
+		switch (operator_)
 		{
 			case ast::UnaryOperation::Operator::Absolute:
 				throw TranslationException("absolute value not implemented with TPTP");
@@ -229,18 +284,10 @@ struct FormatterTPTP
 	static output::ColorStream &print(output::ColorStream &stream, const ast::VariableDeclaration &variableDeclaration, PrintContext &printContext, bool)
 	{
 		const auto printVariableDeclaration =
-			[&stream, &variableDeclaration](const auto *prefix, auto &variableIDs) -> output::ColorStream &
+			[&stream, &variableDeclaration, &printContext](const auto *prefix, VariableCategory category) -> output::ColorStream &
 			{
-				auto matchingVariableID = variableIDs.find(&variableDeclaration);
-
-				if (matchingVariableID == variableIDs.cend())
-				{
-					auto emplaceResult = variableIDs.emplace(std::make_pair(&variableDeclaration, variableIDs.size() + 1));
-					assert(emplaceResult.second);
-					matchingVariableID = emplaceResult.first;
-				}
-
-				const auto variableName = std::string(prefix) + std::to_string(matchingVariableID->second);
+				const auto variableID = printContext.variableID(variableDeclaration, category);
+				const auto variableName = std::string(prefix) + std::to_string(variableID);
 
 				return (stream << output::Variable(variableName.c_str()));
 			};
@@ -251,10 +298,10 @@ struct FormatterTPTP
 		switch (variableDeclaration.type)
 		{
 			case ast::VariableDeclaration::Type::UserDefined:
-				printVariableDeclaration(UserVariablePrefix, printContext.userVariableIDs);
+				printVariableDeclaration(UserVariablePrefix, VariableCategory::UserDefined);
 				break;
 			default:
-				printVariableDeclaration(BodyVariablePrefix, printContext.bodyVariableIDs);
+				printVariableDeclaration(BodyVariablePrefix, VariableCategory::Body);
 				break;
 		}
 
@@ -265,16 +312,23 @@ struct FormatterTPTP
 	// Expressions
 	////////////////////////////////////////////////////////////////////////////////////////////////
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::And &and_, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::And &and_, PrintContext &printContext, bool omitParentheses)
+	{
+		return printAnd(stream, and_.arguments, ASTNodeAccessor<FormatterTPTP>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class ArgumentRange, class NodeAccessor>
+	static output::ColorStream &printAnd(output::ColorStream &stream, const ArgumentRange &arguments, const NodeAccessor &accessor,
+		PrintContext &, bool)
 	{
 		stream << "(";
 
-		for (auto i = and_.arguments.cbegin(); i != and_.arguments.cend(); i++)
+		for (auto i = arguments.begin(); i != arguments.end(); i++)
 		{
-			if (i != and_.arguments.cbegin())
+			if (i != arguments.begin())
 				stream << " " << output::Operator("&") << " ";
 
-			print(stream, *i, printContext, false);
+			accessor.print(*i, false);
 		}
 
 		stream << ")";
@@ -282,28 +336,40 @@ struct FormatterTPTP
 		return stream;
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::Biconditional &biconditional, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::Biconditional &biconditional, PrintContext &printContext, bool omitParentheses)
 	{
-		stream << "(";
+		return printBiconditional(stream, biconditional.left, biconditional.right, ASTNodeAccessor<FormatterTPTP>{stream, printContext}, printContext, omitParentheses);
+	}
 
-		print(stream, biconditional.left, printContext, false);
+	template<class Argument, class NodeAccessor>
+	static output::ColorStream &printBiconditional(output::ColorStream &stream, const Argument &left, const Argument &right,
+		const NodeAccessor &accessor, PrintContext &, bool)
+	{
+		stream << "(";
+		accessor.print(left, false);
 		stream << " <=> ";
-		print(stream, biconditional.right, printContext, false);
-
+		accessor.print(right, false);
 		stream << ")";
 
 		return stream;
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::Exists &exists, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::Exists &exists, PrintContext &printContext, bool omitParentheses)
+	{
+		return printExists(stream, exists.variables, exists.argument, ASTNodeAccessor<FormatterTPTP>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class VariableRange, class Argument, class NodeAccessor>
+	static output::ColorStream &printExists(output::ColorStream &stream, const VariableRange &variables, const Argument &argument,
+		const NodeAccessor &accessor, PrintContext &printContext, bool)
 	{
 		stream << "(" << output::Operator("?") << "[";
 
-		for (auto i = exists.variables.cbegin(); i != exists.variables.cend(); i++)
+		for (auto i = variables.begin(); i != variables.end(); i++)
 		{
-			const auto &variableDeclaration = **i;
+			const auto &variableDeclaration = accessor.variableDeclaration(*i);
 
-			if (i != exists.variables.cbegin())
+			if (i != variables.begin())
 				stream << ", ";
 
 			print(stream, variableDeclaration, printContext, true);
@@ -311,21 +377,28 @@ struct FormatterTPTP
 		}
 
 		stream << "]: ";
-		print(stream, exists.argument, printContext, false);
+		accessor.print(argument, false);
 		stream << ")";
 
 		return stream;
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::ForAll &forAll, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::ForAll &forAll, PrintContext &printContext, bool omitParentheses)
+	{
+		return printForAll(stream, forAll.variables, forAll.argument, ASTNodeAccessor<FormatterTPTP>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class VariableRange, class Argument, class NodeAccessor>
+	static output::ColorStream &printForAll(output::ColorStream &stream, const VariableRange &variables, const Argument &argument,
+		const NodeAccessor &accessor, PrintContext &printContext, bool)
 	{
 		stream << "(" << output::Operator("!") << "[";
 
-		for (auto i = forAll.variables.cbegin(); i != forAll.variables.cend(); i++)
+		for (auto i = variables.begin(); i != variables.end(); i++)
 		{
-			const auto &variableDeclaration = **i;
+			const auto &variableDeclaration = accessor.variableDeclaration(*i);
 
-			if (i != forAll.variables.cbegin())
+			if (i != variables.begin())
 				stream << ", ";
 
 			print(stream, variableDeclaration, printContext, true);
@@ -333,43 +406,64 @@ struct FormatterTPTP
 		}
 
 		stream << "]: ";
-		print(stream, forAll.argument, printContext, false);
+		accessor.print(argument, false);
 		stream << ")";
 
 		return stream;
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::Implies &implies, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::Implies &implies, PrintContext &printContext, bool omitParentheses)
+	{
+		return printImplies(stream, implies.antecedent, implies.consequent, ASTNodeAccessor<FormatterTPTP>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class Argument, class NodeAccessor>
+	static output::ColorStream &printImplies(output::ColorStream &stream, const Argument &antecedent, const Argument &consequent,
+		const NodeAccessor &accessor, PrintContext &, bool)
 	{
 		stream << "(";
-		print(stream, implies.antecedent, printContext, false);
+		accessor.print(antecedent, false);
 		stream << " => ";
-		print(stream, implies.consequent, printContext, false);
+		accessor.print(consequent, false);
 		stream << ")";
 
 		return stream;
 	}
 
-	static output::ColorStream &print(output::ColorStream &stream, const ast::Not &not_, PrintContext &printContext, bool)
+	static output::ColorStream &print(output::ColorStream &stream, const ast::Not &not_, PrintContext &printContext, bool omitParentheses)
+	{
+		return printNot(stream, not_.argument, ASTNodeAccessor<FormatterTPTP>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class Argument, class NodeAccessor>
+	static output::ColorStream &printNot(output::ColorStream &stream, const Argument &argument, const NodeAccessor &accessor,
+		PrintContext &, bool)
 	{
 		stream << "(" << output::Operator("~");
-		print(stream, not_.argument, printContext, false);
+		accessor.print(argument, false);
 		stream << ")";
 
 		return stream;
 	}
 
 	static output::ColorStream &print(output::ColorStream &stream, const ast::Or &or_, PrintContext &printContext, bool omitParentheses)
+	{
+		return printOr(stream, or_.arguments, ASTNodeAccessor<FormatterTPTP>{stream, printContext}, printContext, omitParentheses);
+	}
+
+	template<class ArgumentRange, class NodeAccessor>
+	static output::ColorStream &printOr(output::ColorStream &stream, const ArgumentRange &arguments, const NodeAccessor &accessor,
+		PrintContext &printContext, bool omitParentheses)
 	{
 		if (!omitParentheses || printContext.context.parenthesisStyle == ParenthesisStyle::Full)
 			stream << "(";
 
-		for (auto i = or_.arguments.cbegin(); i != or_.arguments.cend(); i++)
+		for (auto i = arguments.begin(); i != arguments.end(); i++)
 		{
-			if (i != or_.arguments.cbegin())
+			if (i != arguments.begin())
 				stream << " " << output::Operator("|") << " ";
 
-			print(stream, *i, printContext, true);
+			accessor.print(*i, true);
 		}
 
 		if (!omitParentheses || printContext.context.parenthesisStyle == ParenthesisStyle::Full)
@@ -391,6 +485,15 @@ struct FormatterTPTP
 	{
 		return term.accept(VariantPrintVisitor<FormatterTPTP, ast::Term>(), stream, printContext, omitParentheses);
 	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////
+	// Flat AST
+	////////////////////////////////////////////////////////////////////////////////////////////////
+
+	static output::ColorStream &print(output::ColorStream &stream, const flat::Node &node, PrintContext &printContext, bool omitParentheses)
+	{
+		return printFlat<FormatterTPTP>(stream, node, printContext, omitParentheses);
+	}
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
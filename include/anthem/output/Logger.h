@@ -30,6 +30,7 @@ class Logger
 		ColorStream &errorStream();
 
 		// The level from which on messages should be printed
+		Priority logPriority() const;
 		void setLogPriority(Priority logPriority);
 		void setColorPolicy(ColorStream::ColorPolicy colorPolicy);
 
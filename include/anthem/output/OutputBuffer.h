@@ -0,0 +1,47 @@
+#ifndef __ANTHEM__OUTPUT__OUTPUT_BUFFER_H
+#define __ANTHEM__OUTPUT__OUTPUT_BUFFER_H
+
+#include <iostream>
+#include <vector>
+
+namespace anthem
+{
+namespace output
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// OutputBuffer
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Collects writes in a contiguous buffer and passes them on to another stream buffer in large chunks
+class OutputBuffer : public std::streambuf
+{
+	public:
+		static constexpr const size_t DefaultSize = 1 << 20;
+
+		explicit OutputBuffer(std::streambuf *target, size_t size = DefaultSize);
+		~OutputBuffer() override;
+
+		OutputBuffer(const OutputBuffer &other) = delete;
+		OutputBuffer &operator=(const OutputBuffer &other) = delete;
+
+	protected:
+		int_type overflow(int_type character) override;
+		std::streamsize xsputn(const char_type *data, std::streamsize size) override;
+		int sync() override;
+
+	private:
+		bool writeBufferedData();
+
+		std::streambuf *m_target;
+		std::vector<char_type> m_buffer;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#endif
@@ -198,9 +198,12 @@ Exists prepareCopy(const Exists &other)
 {
 	Exists copy(prepareCopy(other.variables), prepareCopy(other.argument));
 
-	// TODO: refactor
+	VariableSubstitution substitution;
+
 	for (size_t i = 0; i < other.variables.size(); i++)
-		copy.argument.accept(ReplaceVariableInFormulaVisitor(), copy.argument, other.variables[i].get(), copy.variables[i].get());
+		substitution.add(*other.variables[i], *copy.variables[i]);
+
+	substitution.apply(copy.argument);
 
 	return copy;
 }
@@ -211,9 +214,12 @@ ForAll prepareCopy(const ForAll &other)
 {
 	ForAll copy(prepareCopy(other.variables), prepareCopy(other.argument));
 
-	// TODO: refactor
+	VariableSubstitution substitution;
+
 	for (size_t i = 0; i < other.variables.size(); i++)
-		copy.argument.accept(ReplaceVariableInFormulaVisitor(), copy.argument, other.variables[i].get(), copy.variables[i].get());
+		substitution.add(*other.variables[i], *copy.variables[i]);
+
+	substitution.apply(copy.argument);
 
 	return copy;
 }
@@ -443,6 +449,24 @@ void fixDanglingVariables(ScopedFormula &scopedFormula)
 		variableStack, replacements);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copying Scoped Formulas
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ScopedFormula copy(const ScopedFormula &scopedFormula)
+{
+	ScopedFormula copy(prepareCopy(scopedFormula.formula), prepareCopy(scopedFormula.freeVariables));
+
+	VariableSubstitution substitution;
+
+	for (size_t i = 0; i < scopedFormula.freeVariables.size(); i++)
+		substitution.add(*scopedFormula.freeVariables[i], *copy.freeVariables[i]);
+
+	substitution.apply(copy.formula);
+
+	return copy;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 }
@@ -1,5 +1,6 @@
 #include <anthem/ASTUtils.h>
 
+#include <anthem/ASTCopy.h>
 #include <anthem/ASTVisitors.h>
 
 namespace anthem
@@ -193,5 +194,202 @@ struct CollectFreeVariablesVisitor
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+struct CountNodesInTermVisitor : public RecursiveTermVisitor<CountNodesInTermVisitor>
+{
+	template<class T>
+	static void accept(T &, Term &, size_t &numberOfNodes)
+	{
+		numberOfNodes++;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct CountNodesInFormulaVisitor : public RecursiveFormulaVisitor<CountNodesInFormulaVisitor>
+{
+	static void accept(Comparison &comparison, Formula &, size_t &numberOfNodes)
+	{
+		comparison.left.accept(CountNodesInTermVisitor(), comparison.left, numberOfNodes);
+		comparison.right.accept(CountNodesInTermVisitor(), comparison.right, numberOfNodes);
+		numberOfNodes++;
+	}
+
+	static void accept(In &in, Formula &, size_t &numberOfNodes)
+	{
+		in.element.accept(CountNodesInTermVisitor(), in.element, numberOfNodes);
+		in.set.accept(CountNodesInTermVisitor(), in.set, numberOfNodes);
+		numberOfNodes++;
+	}
+
+	static void accept(Predicate &predicate, Formula &, size_t &numberOfNodes)
+	{
+		for (auto &argument : predicate.arguments)
+			argument.accept(CountNodesInTermVisitor(), argument, numberOfNodes);
+
+		numberOfNodes++;
+	}
+
+	template<class T>
+	static void accept(T &, Formula &, size_t &numberOfNodes)
+	{
+		numberOfNodes++;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t countNodes(Formula &formula)
+{
+	size_t numberOfNodes = 0;
+	formula.accept(CountNodesInFormulaVisitor(), formula, numberOfNodes);
+
+	return numberOfNodes;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Replaces the variables of a substitution, starting with the replacement in the given slot
+struct SubstituteVariablesInTermVisitor : public RecursiveTermVisitor<SubstituteVariablesInTermVisitor>
+{
+	static void accept(Variable &variable, Term &term, const VariableSubstitution &substitution, size_t firstSlot)
+	{
+		const auto slot = substitution.findSlot(*variable.declaration);
+
+		if (!slot || slot.value() < firstSlot)
+			return;
+
+		const auto &replacement = substitution.m_replacements[slot.value()].term;
+
+		// Variables are relinked in place instead of being copied
+		if (replacement.is<Variable>())
+			variable.declaration = replacement.get<Variable>().declaration;
+		else
+			term = prepareCopy(replacement);
+	}
+
+	// Ignore all other types of expressions
+	template<class T>
+	static void accept(T &, Term &, const VariableSubstitution &, size_t)
+	{
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct SubstituteVariablesInFormulaVisitor : public RecursiveFormulaVisitor<SubstituteVariablesInFormulaVisitor>
+{
+	static void accept(Comparison &comparison, Formula &, const VariableSubstitution &substitution)
+	{
+		comparison.left.accept(SubstituteVariablesInTermVisitor(), comparison.left, substitution, 0);
+		comparison.right.accept(SubstituteVariablesInTermVisitor(), comparison.right, substitution, 0);
+	}
+
+	static void accept(In &in, Formula &, const VariableSubstitution &substitution)
+	{
+		in.element.accept(SubstituteVariablesInTermVisitor(), in.element, substitution, 0);
+		in.set.accept(SubstituteVariablesInTermVisitor(), in.set, substitution, 0);
+	}
+
+	static void accept(Predicate &predicate, Formula &, const VariableSubstitution &substitution)
+	{
+		for (auto &argument : predicate.arguments)
+			argument.accept(SubstituteVariablesInTermVisitor(), argument, substitution, 0);
+	}
+
+	// Ignore all other types of expressions
+	template<class T>
+	static void accept(T &, Formula &, const VariableSubstitution &)
+	{
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void VariableSubstitution::add(const VariableDeclaration &original, VariableDeclaration &replacement)
+{
+	add(original, Variable(&replacement));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void VariableSubstitution::add(const VariableDeclaration &original, Term &&replacement)
+{
+	// Replacing a variable a second time has no effect, as none of its occurrences are left
+	if (findSlot(original))
+		return;
+
+	const auto slot = m_replacements.size();
+
+	m_replacements.push_back(Replacement{&original, std::move(replacement)});
+
+	if (m_replacements.size() > MaximumNumberOfReplacementsSearchedDirectly)
+	{
+		if (m_slots.empty())
+			for (size_t i = 0; i < m_replacements.size(); i++)
+				m_slots.emplace(m_replacements[i].original, i);
+		else
+			m_slots.emplace(&original, slot);
+	}
+
+	// Earlier replacements would have been affected by this one if the variables were replaced one by one
+	for (size_t i = 0; i < slot; i++)
+		m_replacements[i].term.accept(SubstituteVariablesInTermVisitor(), m_replacements[i].term, *this, slot);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const Term *VariableSubstitution::find(const VariableDeclaration &variableDeclaration) const
+{
+	const auto slot = findSlot(variableDeclaration);
+
+	if (!slot)
+		return nullptr;
+
+	return &m_replacements[slot.value()].term;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void VariableSubstitution::apply(Formula &formula) const
+{
+	if (m_replacements.empty())
+		return;
+
+	formula.accept(SubstituteVariablesInFormulaVisitor(), formula, *this);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void VariableSubstitution::apply(Term &term) const
+{
+	if (m_replacements.empty())
+		return;
+
+	term.accept(SubstituteVariablesInTermVisitor(), term, *this, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::optional<size_t> VariableSubstitution::findSlot(const VariableDeclaration &variableDeclaration) const
+{
+	if (m_replacements.size() <= MaximumNumberOfReplacementsSearchedDirectly)
+	{
+		for (size_t slot = 0; slot < m_replacements.size(); slot++)
+			if (m_replacements[slot].original == &variableDeclaration)
+				return slot;
+
+		return std::nullopt;
+	}
+
+	const auto match = m_slots.find(&variableDeclaration);
+
+	if (match == m_slots.end())
+		return std::nullopt;
+
+	return match->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 }
 }
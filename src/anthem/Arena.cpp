@@ -0,0 +1,169 @@
+#include <anthem/Arena.h>
+
+#include <cassert>
+#include <new>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Arena
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+thread_local Arena *activeArena = nullptr;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Arena *Arena::active()
+{
+	return activeArena;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void *Arena::allocate(size_t size)
+{
+	assert(size > 0 && size <= MaximumAllocationSize);
+
+	const auto sizeClass = (size + Granularity - 1) / Granularity;
+
+	// Recycle freed memory of the same size class first
+	if (auto *freeBlock = m_freeLists[sizeClass])
+	{
+		m_freeLists[sizeClass] = freeBlock->next;
+		return freeBlock;
+	}
+
+	const auto blockSize = sizeClass * Granularity;
+
+	if (m_chunkPosition == nullptr || static_cast<size_t>(m_chunkEnd - m_chunkPosition) < blockSize)
+	{
+		if (m_spareChunks.empty())
+			m_chunks.emplace_back(new std::byte[ChunkSize]);
+		else
+		{
+			m_chunks.emplace_back(std::move(m_spareChunks.back()));
+			m_spareChunks.pop_back();
+		}
+
+		m_chunkPosition = m_chunks.back().get();
+		m_chunkEnd = m_chunkPosition + ChunkSize;
+	}
+
+	auto *block = m_chunkPosition;
+	m_chunkPosition += blockSize;
+
+	return block;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Arena::deallocate(void *pointer, size_t size)
+{
+	const auto sizeClass = (size + Granularity - 1) / Granularity;
+
+	auto *freeBlock = static_cast<FreeBlock *>(pointer);
+	freeBlock->next = m_freeLists[sizeClass];
+	m_freeLists[sizeClass] = freeBlock;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Arena::reclaim(Arena &other)
+{
+	for (auto &chunk : other.m_chunks)
+		m_spareChunks.emplace_back(std::move(chunk));
+
+	for (auto &chunk : other.m_spareChunks)
+		m_spareChunks.emplace_back(std::move(chunk));
+
+	other.m_chunks.clear();
+	other.m_spareChunks.clear();
+	other.m_chunkPosition = nullptr;
+	other.m_chunkEnd = nullptr;
+	other.m_freeLists.fill(nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Arena::trim(size_t maximumCapacity)
+{
+	while (!m_spareChunks.empty() && capacity() > maximumCapacity)
+		m_spareChunks.pop_back();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t Arena::capacity() const noexcept
+{
+	return (m_chunks.size() + m_spareChunks.size()) * ChunkSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ArenaScope::ArenaScope(Arena *arena)
+:	m_previousArena{activeArena}
+{
+	activeArena = arena;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ArenaScope::~ArenaScope()
+{
+	activeArena = m_previousArena;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Every allocation is preceded by a header recording the arena it stems from (nullptr for the heap)
+struct alignas(std::max_align_t) AllocationHeader
+{
+	Arena *arena;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void *ArenaAllocated::operator new(size_t size)
+{
+	const auto totalSize = sizeof(AllocationHeader) + size;
+
+	auto *arena = activeArena;
+
+	if (totalSize > Arena::MaximumAllocationSize)
+		arena = nullptr;
+
+	void *memory = arena ? arena->allocate(totalSize) : ::operator new(totalSize);
+
+	auto *header = new (memory) AllocationHeader{arena};
+
+	return header + 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ArenaAllocated::operator delete(void *pointer, size_t size)
+{
+	if (!pointer)
+		return;
+
+	auto *header = static_cast<AllocationHeader *>(pointer) - 1;
+
+	if (!header->arena)
+	{
+		::operator delete(header);
+		return;
+	}
+
+	// Memory of other threads’ arenas cannot be recycled safely, it is released along with its arena
+	if (header->arena != activeArena)
+		return;
+
+	header->arena->deallocate(header, sizeof(AllocationHeader) + size);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
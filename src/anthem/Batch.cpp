@@ -0,0 +1,137 @@
+#include <anthem/Batch.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+#include <unistd.h>
+
+#include <anthem/Exception.h>
+#include <anthem/ThreadPool.h>
+#include <anthem/Translation.h>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Batch
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::vector<BatchJob> readBatchJobs(const char *manifestName, std::istream &stream)
+{
+	std::vector<BatchJob> jobs;
+
+	std::string line;
+	size_t lineNumber = 0;
+
+	while (std::getline(stream, line))
+	{
+		lineNumber++;
+
+		std::istringstream lineStream(line);
+		std::vector<std::string> fields;
+
+		for (std::string field; lineStream >> field;)
+			fields.emplace_back(std::move(field));
+
+		if (fields.empty() || fields.front().front() == '#')
+			continue;
+
+		if (fields.size() < 2)
+			throw LogicException(std::string(manifestName) + ":" + std::to_string(lineNumber)
+				+ ": expected input files followed by an output file");
+
+		BatchJob job;
+		job.outputFileName = std::move(fields.back());
+		fields.pop_back();
+		job.inputFileNames = std::move(fields);
+
+		jobs.emplace_back(std::move(job));
+	}
+
+	return jobs;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t runBatchJobs(const std::vector<BatchJob> &jobs, Context &context)
+{
+	std::atomic<size_t> numberOfFailedJobs{0};
+	std::mutex loggerMutex;
+
+	const auto runJob =
+		[&](size_t i)
+		{
+			const auto &job = jobs[i];
+
+			static std::atomic<size_t> numberOfTemporaryFiles{0};
+
+			// Output files only appear once they are complete, so failed jobs don’t leave truncated ones behind
+			const auto temporaryFileName = job.outputFileName + ".tmp-" + std::to_string(getpid()) + "-"
+				+ std::to_string(numberOfTemporaryFiles++);
+
+			std::ofstream outputFile(temporaryFileName, std::ios::out | std::ios::trunc);
+			// Messages are collected and printed at once so that those of parallel jobs aren’t interleaved
+			std::stringstream errors;
+
+			Context jobContext{output::Logger(output::ColorStream(outputFile), output::ColorStream(errors))};
+			jobContext.logger.errorStream().setColorPolicy(context.logger.errorStream().supportsColor()
+				? output::ColorStream::ColorPolicy::Always
+				: output::ColorStream::ColorPolicy::Never);
+			jobContext.logger.setLogPriority(context.logger.logPriority());
+			jobContext.logger.outputStream().enableBuffering();
+			jobContext.copyOptions(context);
+			// The jobs themselves are already distributed over all threads
+			jobContext.numberOfThreads = 1;
+			jobContext.profiler = context.profiler;
+			jobContext.translationCache = context.translationCache;
+
+			try
+			{
+				if (!outputFile.is_open())
+					throw LogicException("could not write file “" + job.outputFileName + "”");
+
+				translate(job.inputFileNames, jobContext);
+
+				if (jobContext.collectStatistics)
+					jobContext.statistics.print(jobContext.logger.errorStream());
+
+				jobContext.logger.outputStream().flush();
+				outputFile.close();
+
+				if (!outputFile)
+					throw LogicException("could not write file “" + job.outputFileName + "”");
+
+				if (rename(temporaryFileName.c_str(), job.outputFileName.c_str()) != 0)
+					throw LogicException("could not write file “" + job.outputFileName + "”: " + std::strerror(errno));
+			}
+			catch (const std::exception &exception)
+			{
+				outputFile.close();
+				unlink(temporaryFileName.c_str());
+
+				jobContext.logger.log(output::Priority::Error) << exception.what();
+				numberOfFailedJobs++;
+			}
+
+			std::lock_guard<std::mutex> lock(loggerMutex);
+
+			context.logger.log(output::Priority::Info) << "job " << (i + 1) << " of " << jobs.size() << ": " << job.outputFileName;
+			context.logger.errorStream() << errors.str();
+		};
+
+	ThreadPool threadPool(context.numberOfThreads);
+	threadPool.forEachIndex(jobs.size(), runJob);
+
+	return numberOfFailedJobs;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -1,11 +1,15 @@
 #include <anthem/Completion.h>
 
+#include <optional>
+#include <unordered_map>
+
 #include <anthem/AST.h>
 #include <anthem/ASTCopy.h>
 #include <anthem/ASTUtils.h>
 #include <anthem/ASTVisitors.h>
 #include <anthem/Exception.h>
 #include <anthem/HiddenPredicateElimination.h>
+#include <anthem/StatementCache.h>
 #include <anthem/Utils.h>
 
 namespace anthem
@@ -17,27 +21,67 @@ namespace anthem
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Formulas in normal form, grouped by their consequent (in the order of the original formulas)
+struct ScopedFormulaBuckets
+{
+	std::unordered_map<const ast::PredicateDeclaration *, std::vector<ast::ScopedFormula *>> definitions;
+	std::vector<ast::ScopedFormula *> integrityConstraints;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Sorts all formulas into buckets in a single pass over the formulas
+ScopedFormulaBuckets bucketScopedFormulas(std::vector<ast::ScopedFormula> &scopedFormulas)
+{
+	ScopedFormulaBuckets buckets;
+
+	for (auto &scopedFormula : scopedFormulas)
+	{
+		assert(scopedFormula.formula.is<ast::Implies>());
+		const auto &implies = scopedFormula.formula.get<ast::Implies>();
+
+		if (implies.consequent.is<ast::Predicate>())
+		{
+			const auto &predicate = implies.consequent.get<ast::Predicate>();
+			buckets.definitions[predicate.declaration].emplace_back(&scopedFormula);
+
+			continue;
+		}
+
+		assert(implies.consequent.is<ast::Boolean>());
+		const auto &boolean = implies.consequent.get<ast::Boolean>();
+
+		// Rules of the form “F -> #true” are useless
+		if (boolean.value == true)
+			continue;
+
+		buckets.integrityConstraints.emplace_back(&scopedFormula);
+	}
+
+	return buckets;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 // Builds the conjunction within the completed formula for a given predicate
-ast::Formula buildCompletedFormulaDisjunction(const ast::Predicate &predicate, const ast::VariableDeclarationPointers &parameters, std::vector<ast::ScopedFormula> &scopedFormulas)
+ast::Formula buildCompletedFormulaDisjunction(const ast::Predicate &predicate, const ast::VariableDeclarationPointers &parameters, const std::vector<ast::ScopedFormula *> &definitions)
 {
 	ast::Or or_;
 
 	assert(predicate.arguments.size() == parameters.size());
 
 	// Build the disjunction of all formulas with the predicate as consequent
-	for (auto &scopedFormula : scopedFormulas)
+	for (auto *scopedFormulaPointer : definitions)
 	{
+		auto &scopedFormula = *scopedFormulaPointer;
+
 		assert(scopedFormula.formula.is<ast::Implies>());
 		auto &implies = scopedFormula.formula.get<ast::Implies>();
 
-		if (!implies.consequent.is<ast::Predicate>())
-			continue;
-
+		assert(implies.consequent.is<ast::Predicate>());
 		auto &otherPredicate = implies.consequent.get<ast::Predicate>();
 
-		if (predicate.declaration != otherPredicate.declaration)
-			continue;
-
+		assert(predicate.declaration == otherPredicate.declaration);
 		assert(otherPredicate.arguments.size() == parameters.size());
 
 		auto &freeVariables = scopedFormula.freeVariables;
@@ -70,14 +114,18 @@ ast::Formula buildCompletedFormulaDisjunction(const ast::Predicate &predicate, c
 				throw CompletionException("cannot perform completion, only singleton rule heads supported currently");
 
 		// Second, link all occurrences of the deleted free variable to the new, unique parameter
+		ast::VariableSubstitution substitution;
+
 		for (size_t i = 0; i < parameters.size(); i++)
 		{
 			assert(otherPredicate.arguments[i].is<ast::Variable>());
 			const auto &otherVariable = otherPredicate.arguments[i].get<ast::Variable>();
 
-			scopedFormula.formula.accept(ast::ReplaceVariableInFormulaVisitor(), scopedFormula.formula, otherVariable.declaration, parameters[i].get());
+			substitution.add(*otherVariable.declaration, *parameters[i]);
 		}
 
+		substitution.apply(scopedFormula.formula);
+
 		if (freeVariables.empty())
 			or_.arguments.emplace_back(std::move(implies.antecedent));
 		else
@@ -118,7 +166,7 @@ ast::Formula buildCompletedFormulaQuantified(ast::Predicate &&predicate, ast::Fo
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-ast::Formula completePredicate(ast::PredicateDeclaration &predicateDeclaration, std::vector<ast::ScopedFormula> &scopedFormulas)
+ast::Formula completePredicate(ast::PredicateDeclaration &predicateDeclaration, const std::vector<ast::ScopedFormula *> &definitions)
 {
 	// Create new set of parameters for the completed definition for the predicate
 	ast::VariableDeclarationPointers parameters;
@@ -135,7 +183,7 @@ ast::Formula completePredicate(ast::PredicateDeclaration &predicateDeclaration,
 
 	ast::Predicate predicateCopy(&predicateDeclaration, std::move(arguments));
 
-	auto completedFormulaDisjunction = buildCompletedFormulaDisjunction(predicateCopy, parameters, scopedFormulas);
+	auto completedFormulaDisjunction = buildCompletedFormulaDisjunction(predicateCopy, parameters, definitions);
 	auto completedFormulaQuantified = buildCompletedFormulaQuantified(std::move(predicateCopy), std::move(completedFormulaDisjunction));
 
 	if (parameters.empty())
@@ -165,7 +213,7 @@ ast::Formula completeIntegrityConstraint(ast::ScopedFormula &scopedFormula)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-std::vector<ast::Formula> complete(std::vector<ast::ScopedFormula> &&scopedFormulas, Context &context)
+std::vector<ast::Formula> complete(std::vector<ast::ScopedFormula> &&scopedFormulas, Context &context, ThreadPool &threadPool)
 {
 	// Check whether formulas are in normal form
 	for (const auto &scopedFormula : scopedFormulas)
@@ -190,36 +238,86 @@ std::vector<ast::Formula> complete(std::vector<ast::ScopedFormula> &&scopedFormu
 			return lhs->arity() < rhs->arity();
 		});
 
-	std::vector<ast::Formula> completedFormulas;
+	const auto buckets = bucketScopedFormulas(scopedFormulas);
+	const std::vector<ast::ScopedFormula *> noDefinitions;
+
+	std::vector<std::pair<ast::PredicateDeclaration *, const std::vector<ast::ScopedFormula *> *>> predicatesToComplete;
 
-	// Complete predicates
 	for (auto &predicateDeclaration : context.predicateDeclarations)
 	{
 		if (!predicateDeclaration->isUsed || predicateDeclaration->isExternal)
 			continue;
 
-		completedFormulas.emplace_back(completePredicate(*predicateDeclaration, scopedFormulas));
+		const auto definitions = buckets.definitions.find(predicateDeclaration.get());
+
+		if (definitions == buckets.definitions.cend())
+			predicatesToComplete.emplace_back(predicateDeclaration.get(), &noDefinitions);
+		else
+			predicatesToComplete.emplace_back(predicateDeclaration.get(), &definitions->second);
 	}
 
-	// Complete integrity constraints
-	for (auto &scopedFormula : scopedFormulas)
-	{
-		auto &implies = scopedFormula.formula.get<ast::Implies>();
+	// Complete predicates, which are independent of each other because every formula is in exactly one bucket
+	std::vector<std::optional<ast::Formula>> completedPredicates(predicatesToComplete.size());
 
-		if (!implies.consequent.is<ast::Boolean>())
-			continue;
+	std::vector<bool> isReused(predicatesToComplete.size(), false);
 
-		const auto &boolean = implies.consequent.get<ast::Boolean>();
+	// Reuse the completed definitions of predicates whose rules didn’t change since the last translation
+	if (context.statementCache)
+		for (size_t i = 0; i < predicatesToComplete.size(); i++)
+		{
+			const auto &[predicateDeclaration, definitions] = predicatesToComplete[i];
+			completedPredicates[i] = context.statementCache->loadCompletedDefinition(*predicateDeclaration, *definitions,
+				scopedFormulas, context);
+			isReused[i] = completedPredicates[i].has_value();
+		}
 
-		// Rules of the form “F -> #true” are useless
-		if (boolean.value == true)
-			continue;
+	threadPool.forEachIndex(predicatesToComplete.size(),
+		[&](size_t i)
+		{
+			if (isReused[i])
+				return;
 
-		completedFormulas.emplace_back(completeIntegrityConstraint(scopedFormula));
-	}
+			const auto &[predicateDeclaration, definitions] = predicatesToComplete[i];
+
+			auto *profiler = Profiler::details(context.profiler.get());
+			Profiler::Span span(profiler, profiler
+				? "complete " + predicateDeclaration->name + "/" + std::to_string(predicateDeclaration->arity())
+				: std::string());
+
+			completedPredicates[i] = completePredicate(*predicateDeclaration, *definitions);
+		});
+
+	if (context.statementCache)
+		for (size_t i = 0; i < predicatesToComplete.size(); i++)
+		{
+			if (isReused[i])
+				continue;
+
+			const auto &[predicateDeclaration, definitions] = predicatesToComplete[i];
+			context.statementCache->storeCompletedDefinition(*predicateDeclaration, *definitions, scopedFormulas,
+				completedPredicates[i].value());
+		}
+
+	std::vector<ast::Formula> completedFormulas;
+	completedFormulas.reserve(completedPredicates.size() + buckets.integrityConstraints.size());
+
+	// Collect the results in the order of the sorted predicate declarations
+	for (auto &completedPredicate : completedPredicates)
+		completedFormulas.emplace_back(std::move(completedPredicate.value()));
+
+	// Complete integrity constraints
+	for (auto *scopedFormula : buckets.integrityConstraints)
+		completedFormulas.emplace_back(completeIntegrityConstraint(*scopedFormula));
+
+	recordNumberOfNodes(context.profiler.get(), completedFormulas);
 
 	// Eliminate all predicates that should not be visible in the output
-	eliminateHiddenPredicates(completedFormulas, context);
+	{
+		Profiler::Span span(context.profiler.get(), "hidden predicate elimination");
+		eliminateHiddenPredicates(completedFormulas, context);
+	}
+
+	recordNumberOfNodes(context.profiler.get(), completedFormulas);
 
 	return completedFormulas;
 }
@@ -0,0 +1,280 @@
+#include <anthem/DeclarationMerging.h>
+
+#include <unordered_map>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// DeclarationMerging
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Redirects to the declarations that those of another context were merged into
+struct MergedDeclarations
+{
+	ast::PredicateDeclaration *redirect(const ast::PredicateDeclaration *predicateDeclaration) const
+	{
+		return predicateDeclarations.at(predicateDeclaration);
+	}
+
+	ast::FunctionDeclaration *redirect(const ast::FunctionDeclaration *functionDeclaration) const
+	{
+		return functionDeclarations.at(functionDeclaration);
+	}
+
+	std::unordered_map<const ast::PredicateDeclaration *, ast::PredicateDeclaration *> predicateDeclarations;
+	std::unordered_map<const ast::FunctionDeclaration *, ast::FunctionDeclaration *> functionDeclarations;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Redirects to the declarations of a context with the same names and arities
+struct DeclarationsByName
+{
+	ast::PredicateDeclaration *redirect(const ast::PredicateDeclaration *predicateDeclaration) const
+	{
+		return context.findOrCreatePredicateDeclaration(predicateDeclaration->name.c_str(), predicateDeclaration->arity());
+	}
+
+	ast::FunctionDeclaration *redirect(const ast::FunctionDeclaration *functionDeclaration) const
+	{
+		return context.findOrCreateFunctionDeclaration(functionDeclaration->name.c_str(), functionDeclaration->arity());
+	}
+
+	Context &context;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class Redirection>
+void redirectDeclarations(ast::Formula &formula, const Redirection &redirection);
+template<class Redirection>
+void redirectDeclarations(ast::Term &term, const Redirection &redirection);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct FormulaRedirectDeclarationsVisitor
+{
+	template<class Redirection>
+	void visit(ast::And &and_, const Redirection &redirection)
+	{
+		for (auto &argument : and_.arguments)
+			redirectDeclarations(argument, redirection);
+	}
+
+	template<class Redirection>
+	void visit(ast::Biconditional &biconditional, const Redirection &redirection)
+	{
+		redirectDeclarations(biconditional.left, redirection);
+		redirectDeclarations(biconditional.right, redirection);
+	}
+
+	template<class Redirection>
+	void visit(ast::Boolean &, const Redirection &)
+	{
+	}
+
+	template<class Redirection>
+	void visit(ast::Comparison &comparison, const Redirection &redirection)
+	{
+		redirectDeclarations(comparison.left, redirection);
+		redirectDeclarations(comparison.right, redirection);
+	}
+
+	template<class Redirection>
+	void visit(ast::Exists &exists, const Redirection &redirection)
+	{
+		redirectDeclarations(exists.argument, redirection);
+	}
+
+	template<class Redirection>
+	void visit(ast::ForAll &forAll, const Redirection &redirection)
+	{
+		redirectDeclarations(forAll.argument, redirection);
+	}
+
+	template<class Redirection>
+	void visit(ast::Implies &implies, const Redirection &redirection)
+	{
+		redirectDeclarations(implies.antecedent, redirection);
+		redirectDeclarations(implies.consequent, redirection);
+	}
+
+	template<class Redirection>
+	void visit(ast::In &in, const Redirection &redirection)
+	{
+		redirectDeclarations(in.element, redirection);
+		redirectDeclarations(in.set, redirection);
+	}
+
+	template<class Redirection>
+	void visit(ast::Not &not_, const Redirection &redirection)
+	{
+		redirectDeclarations(not_.argument, redirection);
+	}
+
+	template<class Redirection>
+	void visit(ast::Or &or_, const Redirection &redirection)
+	{
+		for (auto &argument : or_.arguments)
+			redirectDeclarations(argument, redirection);
+	}
+
+	template<class Redirection>
+	void visit(ast::Predicate &predicate, const Redirection &redirection)
+	{
+		predicate.declaration = redirection.redirect(predicate.declaration);
+
+		for (auto &argument : predicate.arguments)
+			redirectDeclarations(argument, redirection);
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct TermRedirectDeclarationsVisitor
+{
+	template<class Redirection>
+	void visit(ast::BinaryOperation &binaryOperation, const Redirection &redirection)
+	{
+		redirectDeclarations(binaryOperation.left, redirection);
+		redirectDeclarations(binaryOperation.right, redirection);
+	}
+
+	template<class Redirection>
+	void visit(ast::Boolean &, const Redirection &)
+	{
+	}
+
+	template<class Redirection>
+	void visit(ast::Function &function, const Redirection &redirection)
+	{
+		function.declaration = redirection.redirect(function.declaration);
+
+		for (auto &argument : function.arguments)
+			redirectDeclarations(argument, redirection);
+	}
+
+	template<class Redirection>
+	void visit(ast::Integer &, const Redirection &)
+	{
+	}
+
+	template<class Redirection>
+	void visit(ast::Interval &interval, const Redirection &redirection)
+	{
+		redirectDeclarations(interval.from, redirection);
+		redirectDeclarations(interval.to, redirection);
+	}
+
+	template<class Redirection>
+	void visit(ast::SpecialInteger &, const Redirection &)
+	{
+	}
+
+	template<class Redirection>
+	void visit(ast::String &, const Redirection &)
+	{
+	}
+
+	template<class Redirection>
+	void visit(ast::UnaryOperation &unaryOperation, const Redirection &redirection)
+	{
+		redirectDeclarations(unaryOperation.argument, redirection);
+	}
+
+	template<class Redirection>
+	void visit(ast::Variable &, const Redirection &)
+	{
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class Redirection>
+void redirectDeclarations(ast::Formula &formula, const Redirection &redirection)
+{
+	formula.accept(FormulaRedirectDeclarationsVisitor(), redirection);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class Redirection>
+void redirectDeclarations(ast::Term &term, const Redirection &redirection)
+{
+	term.accept(TermRedirectDeclarationsVisitor(), redirection);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void redirectDeclarations(ast::Formula &formula, Context &context)
+{
+	redirectDeclarations(formula, DeclarationsByName{context});
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void mergeDeclarations(Context &context, Context &otherContext, std::vector<ast::ScopedFormula> &otherScopedFormulas)
+{
+	MergedDeclarations mergedDeclarations;
+
+	// Declarations not known yet are appended in the order in which the other program introduced them
+	for (const auto &otherPredicateDeclaration : otherContext.predicateDeclarations)
+	{
+		auto *predicateDeclaration = context.findOrCreatePredicateDeclaration(otherPredicateDeclaration->name.c_str(),
+			otherPredicateDeclaration->arity());
+
+		predicateDeclaration->isUsed |= otherPredicateDeclaration->isUsed;
+		predicateDeclaration->isExternal |= otherPredicateDeclaration->isExternal;
+
+		if (otherPredicateDeclaration->visibility != ast::PredicateDeclaration::Visibility::Default)
+			predicateDeclaration->visibility = otherPredicateDeclaration->visibility;
+
+		for (size_t i = 0; i < predicateDeclaration->parameters.size(); i++)
+			if (otherPredicateDeclaration->parameters[i].domain != Domain::Unknown)
+				predicateDeclaration->parameters[i].domain = otherPredicateDeclaration->parameters[i].domain;
+
+		mergedDeclarations.predicateDeclarations.emplace(otherPredicateDeclaration.get(), predicateDeclaration);
+	}
+
+	for (const auto &otherFunctionDeclaration : otherContext.functionDeclarations)
+	{
+		const auto isNew = !context.findFunctionDeclaration(otherFunctionDeclaration->name.c_str(), otherFunctionDeclaration->arity());
+
+		auto *functionDeclaration = context.findOrCreateFunctionDeclaration(otherFunctionDeclaration->name.c_str(),
+			otherFunctionDeclaration->arity());
+
+		// Rules translated for completion assign the symbolic domain to all functions they use, while
+		// programs translated directly only change the domain of known functions by declaring them integer
+		if (isNew || context.translationMode == TranslationMode::Completion
+			|| otherFunctionDeclaration->domain == Domain::Integer)
+		{
+			functionDeclaration->domain = otherFunctionDeclaration->domain;
+		}
+
+		mergedDeclarations.functionDeclarations.emplace(otherFunctionDeclaration.get(), functionDeclaration);
+	}
+
+	for (auto &scopedFormula : otherScopedFormulas)
+		redirectDeclarations(scopedFormula.formula, mergedDeclarations);
+
+	if (otherContext.semantics == Semantics::LogicOfHereAndThere)
+		context.semantics = Semantics::LogicOfHereAndThere;
+
+	if (otherContext.showStatementsUsed)
+	{
+		context.showStatementsUsed = true;
+		context.defaultPredicateVisibility = otherContext.defaultPredicateVisibility;
+	}
+
+	context.externalStatementsUsed |= otherContext.externalStatementsUsed;
+
+	context.statistics.inputs.insert(context.statistics.inputs.end(),
+		otherContext.statistics.inputs.begin(), otherContext.statistics.inputs.end());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,385 @@
+#include <anthem/Fingerprint.h>
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace anthem
+{
+namespace ast
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Fingerprint
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::optional<BoundVariablePosition> findBoundVariable(const VariableDeclaration *variableDeclaration,
+	const BoundVariableLayers &boundVariableLayers)
+{
+	for (size_t distance = 0; distance < boundVariableLayers.size(); distance++)
+	{
+		const auto &layer = *boundVariableLayers[boundVariableLayers.size() - 1 - distance];
+
+		const auto match = std::find_if(layer.cbegin(), layer.cend(),
+			[&](const auto &otherVariableDeclaration)
+			{
+				return otherVariableDeclaration.get() == variableDeclaration;
+			});
+
+		if (match != layer.cend())
+			return BoundVariablePosition{distance, static_cast<size_t>(match - layer.cbegin())};
+	}
+
+	return std::nullopt;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+enum class FingerprintTag : Fingerprint
+{
+	And = 1,
+	BinaryOperation,
+	Biconditional,
+	BooleanFormula,
+	BooleanTerm,
+	BoundVariable,
+	Comparison,
+	Exists,
+	ForAll,
+	FreeVariable,
+	Function,
+	Implies,
+	In,
+	Integer,
+	Interval,
+	Not,
+	Or,
+	Predicate,
+	SpecialInteger,
+	String,
+	UnaryOperation
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Fingerprint mixFingerprint(Fingerprint value)
+{
+	// Finalizer of the SplitMix64 generator
+	value += 0x9e3779b97f4a7c15;
+	value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+	value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+	return value ^ (value >> 31);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Fingerprint combineFingerprints(Fingerprint seed, Fingerprint value)
+{
+	return mixFingerprint(seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2)));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Fingerprint combineFingerprints(FingerprintTag tag, std::initializer_list<Fingerprint> values)
+{
+	auto result = mixFingerprint(static_cast<Fingerprint>(tag));
+
+	for (const auto value : values)
+		result = combineFingerprints(result, value);
+
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Combines the fingerprints of two operands independently of their order
+Fingerprint combineSymmetric(FingerprintTag tag, Fingerprint operator_, Fingerprint left, Fingerprint right)
+{
+	return combineFingerprints(tag, {operator_, std::min(left, right), std::max(left, right)});
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Combines the fingerprints of arguments independently of their order and multiplicity
+Fingerprint combineSet(FingerprintTag tag, std::vector<Fingerprint> &&fingerprints)
+{
+	std::sort(fingerprints.begin(), fingerprints.end());
+	fingerprints.erase(std::unique(fingerprints.begin(), fingerprints.end()), fingerprints.end());
+
+	auto result = mixFingerprint(static_cast<Fingerprint>(tag));
+
+	for (const auto fingerprint : fingerprints)
+		result = combineFingerprints(result, fingerprint);
+
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct FingerprintState
+{
+	BoundVariableLayers boundVariableLayers;
+	// Fingerprints of the formulas outside of quantifiers, recorded for reuse if requested
+	std::unordered_map<const Formula *, Fingerprint> *fingerprints{nullptr};
+};
+
+Fingerprint fingerprint(const Formula &formula, FingerprintState &state);
+Fingerprint fingerprint(const Term &term, FingerprintState &state);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct TermFingerprintVisitor
+{
+	Fingerprint visit(const BinaryOperation &binaryOperation, FingerprintState &state)
+	{
+		const auto operator_ = static_cast<Fingerprint>(binaryOperation.operator_);
+		const auto left = fingerprint(binaryOperation.left, state);
+		const auto right = fingerprint(binaryOperation.right, state);
+
+		// Only + and * are commutative operators
+		if (binaryOperation.operator_ == BinaryOperation::Operator::Plus
+			|| binaryOperation.operator_ == BinaryOperation::Operator::Multiplication)
+		{
+			return combineSymmetric(FingerprintTag::BinaryOperation, operator_, left, right);
+		}
+
+		return combineFingerprints(FingerprintTag::BinaryOperation, {operator_, left, right});
+	}
+
+	Fingerprint visit(const Boolean &boolean, FingerprintState &)
+	{
+		return combineFingerprints(FingerprintTag::BooleanTerm, {boolean.value});
+	}
+
+	Fingerprint visit(const Function &function, FingerprintState &state)
+	{
+		auto result = combineFingerprints(FingerprintTag::Function, {reinterpret_cast<uintptr_t>(function.declaration), function.arguments.size()});
+
+		for (const auto &argument : function.arguments)
+			result = combineFingerprints(result, fingerprint(argument, state));
+
+		return result;
+	}
+
+	Fingerprint visit(const Integer &integer, FingerprintState &)
+	{
+		return combineFingerprints(FingerprintTag::Integer, {static_cast<Fingerprint>(integer.value)});
+	}
+
+	Fingerprint visit(const Interval &interval, FingerprintState &state)
+	{
+		return combineFingerprints(FingerprintTag::Interval,
+			{fingerprint(interval.from, state), fingerprint(interval.to, state)});
+	}
+
+	Fingerprint visit(const SpecialInteger &specialInteger, FingerprintState &)
+	{
+		return combineFingerprints(FingerprintTag::SpecialInteger, {static_cast<Fingerprint>(specialInteger.type)});
+	}
+
+	Fingerprint visit(const String &string, FingerprintState &)
+	{
+		return combineFingerprints(FingerprintTag::String, {std::hash<std::string>()(string.text)});
+	}
+
+	Fingerprint visit(const UnaryOperation &unaryOperation, FingerprintState &state)
+	{
+		return combineFingerprints(FingerprintTag::UnaryOperation,
+			{static_cast<Fingerprint>(unaryOperation.operator_), fingerprint(unaryOperation.argument, state)});
+	}
+
+	Fingerprint visit(const Variable &variable, FingerprintState &state)
+	{
+		// Identify bound variables by the distance to their quantifier and their position within it
+		const auto boundVariablePosition = findBoundVariable(variable.declaration, state.boundVariableLayers);
+
+		if (boundVariablePosition)
+			return combineFingerprints(FingerprintTag::BoundVariable, {boundVariablePosition->first, boundVariablePosition->second});
+
+		return combineFingerprints(FingerprintTag::FreeVariable, {reinterpret_cast<uintptr_t>(variable.declaration)});
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct FormulaFingerprintVisitor
+{
+	Fingerprint visit(const And &and_, FingerprintState &state)
+	{
+		std::vector<Fingerprint> fingerprints;
+		fingerprints.reserve(and_.arguments.size());
+
+		for (const auto &argument : and_.arguments)
+			fingerprints.emplace_back(fingerprint(argument, state));
+
+		return combineSet(FingerprintTag::And, std::move(fingerprints));
+	}
+
+	Fingerprint visit(const Biconditional &biconditional, FingerprintState &state)
+	{
+		return combineSymmetric(FingerprintTag::Biconditional, 0,
+			fingerprint(biconditional.left, state), fingerprint(biconditional.right, state));
+	}
+
+	Fingerprint visit(const Boolean &boolean, FingerprintState &)
+	{
+		return combineFingerprints(FingerprintTag::BooleanFormula, {boolean.value});
+	}
+
+	Fingerprint visit(const Comparison &comparison, FingerprintState &state)
+	{
+		const auto operator_ = static_cast<Fingerprint>(comparison.operator_);
+		const auto left = fingerprint(comparison.left, state);
+		const auto right = fingerprint(comparison.right, state);
+
+		// Only = and != are commutative operators
+		if (comparison.operator_ == Comparison::Operator::Equal
+			|| comparison.operator_ == Comparison::Operator::NotEqual)
+		{
+			return combineSymmetric(FingerprintTag::Comparison, operator_, left, right);
+		}
+
+		return combineFingerprints(FingerprintTag::Comparison, {operator_, left, right});
+	}
+
+	Fingerprint visit(const Exists &exists, FingerprintState &state)
+	{
+		state.boundVariableLayers.push_back(&exists.variables);
+		const auto argument = fingerprint(exists.argument, state);
+		state.boundVariableLayers.pop_back();
+
+		return combineFingerprints(FingerprintTag::Exists, {exists.variables.size(), argument});
+	}
+
+	Fingerprint visit(const ForAll &forAll, FingerprintState &state)
+	{
+		state.boundVariableLayers.push_back(&forAll.variables);
+		const auto argument = fingerprint(forAll.argument, state);
+		state.boundVariableLayers.pop_back();
+
+		return combineFingerprints(FingerprintTag::ForAll, {forAll.variables.size(), argument});
+	}
+
+	Fingerprint visit(const Implies &implies, FingerprintState &state)
+	{
+		return combineFingerprints(FingerprintTag::Implies,
+			{fingerprint(implies.antecedent, state), fingerprint(implies.consequent, state)});
+	}
+
+	Fingerprint visit(const In &in, FingerprintState &state)
+	{
+		return combineFingerprints(FingerprintTag::In,
+			{fingerprint(in.element, state), fingerprint(in.set, state)});
+	}
+
+	Fingerprint visit(const Not &not_, FingerprintState &state)
+	{
+		return combineFingerprints(FingerprintTag::Not, {fingerprint(not_.argument, state)});
+	}
+
+	Fingerprint visit(const Or &or_, FingerprintState &state)
+	{
+		std::vector<Fingerprint> fingerprints;
+		fingerprints.reserve(or_.arguments.size());
+
+		for (const auto &argument : or_.arguments)
+			fingerprints.emplace_back(fingerprint(argument, state));
+
+		return combineSet(FingerprintTag::Or, std::move(fingerprints));
+	}
+
+	Fingerprint visit(const Predicate &predicate, FingerprintState &state)
+	{
+		auto result = combineFingerprints(FingerprintTag::Predicate, {reinterpret_cast<uintptr_t>(predicate.declaration)});
+
+		for (const auto &argument : predicate.arguments)
+			result = combineFingerprints(result, fingerprint(argument, state));
+
+		return result;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Fingerprint fingerprint(const Formula &formula, FingerprintState &state)
+{
+	// Fingerprints within quantifiers depend on the enclosing quantifiers and are thus not recorded
+	if (!state.fingerprints || !state.boundVariableLayers.empty())
+		return formula.accept(FormulaFingerprintVisitor(), state);
+
+	const auto match = state.fingerprints->find(&formula);
+
+	if (match != state.fingerprints->end())
+		return match->second;
+
+	const auto result = formula.accept(FormulaFingerprintVisitor(), state);
+	state.fingerprints->emplace(&formula, result);
+
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Fingerprint fingerprint(const Term &term, FingerprintState &state)
+{
+	return term.accept(TermFingerprintVisitor(), state);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Fingerprint fingerprint(const Formula &formula)
+{
+	FingerprintState state;
+
+	return fingerprint(formula, state);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Fingerprint fingerprint(const Term &term)
+{
+	FingerprintState state;
+
+	return fingerprint(term, state);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Fingerprint FingerprintCache::fingerprint(const Formula &formula)
+{
+	if (!m_fingerprints)
+		m_fingerprints.emplace();
+
+	FingerprintState state;
+	state.fingerprints = &m_fingerprints.value();
+
+	return ast::fingerprint(formula, state);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Fingerprint FingerprintCache::fingerprint(const Formula &formula, const BoundVariableLayers &boundVariableLayers)
+{
+	if (boundVariableLayers.empty())
+		return fingerprint(formula);
+
+	FingerprintState state;
+	state.boundVariableLayers = boundVariableLayers;
+
+	return ast::fingerprint(formula, state);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void FingerprintCache::clear()
+{
+	m_fingerprints.reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+}
@@ -0,0 +1,443 @@
+#include <anthem/FlatAST.h>
+
+#include <anthem/Exception.h>
+
+namespace anthem
+{
+namespace flat
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Flat AST
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Converting from the AST
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Tree::TermConverter
+{
+	static NodeIndex visit(const ast::BinaryOperation &binaryOperation, Tree &tree, const VariableDeclarationMap &boundVariables)
+	{
+		const auto node = tree.addNode(NodeType::BinaryOperation, static_cast<int32_t>(binaryOperation.operator_), 2);
+		const auto left = tree.addTerm(binaryOperation.left, boundVariables);
+		const auto right = tree.addTerm(binaryOperation.right, boundVariables);
+
+		tree.m_children[tree.m_firstChildren[node]] = left;
+		tree.m_children[tree.m_firstChildren[node] + 1] = right;
+
+		return node;
+	}
+
+	static NodeIndex visit(const ast::Boolean &boolean, Tree &tree, const VariableDeclarationMap &)
+	{
+		return tree.addNode(NodeType::Boolean, boolean.value ? 1 : 0, 0);
+	}
+
+	static NodeIndex visit(const ast::Function &function, Tree &tree, const VariableDeclarationMap &boundVariables)
+	{
+		tree.m_functionDeclarations.emplace_back(function.declaration);
+
+		const auto node = tree.addNode(NodeType::Function, tree.m_functionDeclarations.size() - 1, function.arguments.size());
+
+		for (size_t i = 0; i < function.arguments.size(); i++)
+		{
+			const auto argument = tree.addTerm(function.arguments[i], boundVariables);
+			tree.m_children[tree.m_firstChildren[node] + i] = argument;
+		}
+
+		return node;
+	}
+
+	static NodeIndex visit(const ast::Integer &integer, Tree &tree, const VariableDeclarationMap &)
+	{
+		return tree.addNode(NodeType::Integer, integer.value, 0);
+	}
+
+	static NodeIndex visit(const ast::Interval &interval, Tree &tree, const VariableDeclarationMap &boundVariables)
+	{
+		const auto node = tree.addNode(NodeType::Interval, 0, 2);
+		const auto from = tree.addTerm(interval.from, boundVariables);
+		const auto to = tree.addTerm(interval.to, boundVariables);
+
+		tree.m_children[tree.m_firstChildren[node]] = from;
+		tree.m_children[tree.m_firstChildren[node] + 1] = to;
+
+		return node;
+	}
+
+	static NodeIndex visit(const ast::SpecialInteger &specialInteger, Tree &tree, const VariableDeclarationMap &)
+	{
+		return tree.addNode(NodeType::SpecialInteger, static_cast<int32_t>(specialInteger.type), 0);
+	}
+
+	static NodeIndex visit(const ast::String &string, Tree &tree, const VariableDeclarationMap &)
+	{
+		tree.m_strings.emplace_back(string.text);
+
+		return tree.addNode(NodeType::String, tree.m_strings.size() - 1, 0);
+	}
+
+	static NodeIndex visit(const ast::UnaryOperation &unaryOperation, Tree &tree, const VariableDeclarationMap &boundVariables)
+	{
+		const auto node = tree.addNode(NodeType::UnaryOperation, static_cast<int32_t>(unaryOperation.operator_), 1);
+		const auto argument = tree.addTerm(unaryOperation.argument, boundVariables);
+
+		tree.m_children[tree.m_firstChildren[node]] = argument;
+
+		return node;
+	}
+
+	static NodeIndex visit(const ast::Variable &variable, Tree &tree, const VariableDeclarationMap &boundVariables)
+	{
+		// Variables bound within the converted formula refer to the tree’s own declarations
+		const auto matchingBoundVariable = boundVariables.find(variable.declaration);
+
+		if (matchingBoundVariable != boundVariables.cend())
+			return tree.addVariable(matchingBoundVariable->second);
+
+		return tree.addVariable(variable.declaration);
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Tree::FormulaConverter
+{
+	template<class T>
+	static NodeIndex addBinary(NodeType type, const T &left, const T &right, Tree &tree, VariableDeclarationMap &boundVariables)
+	{
+		const auto node = tree.addNode(type, 0, 2);
+		const auto leftNode = add(left, tree, boundVariables);
+		const auto rightNode = add(right, tree, boundVariables);
+
+		tree.m_children[tree.m_firstChildren[node]] = leftNode;
+		tree.m_children[tree.m_firstChildren[node] + 1] = rightNode;
+
+		return node;
+	}
+
+	template<class T>
+	static NodeIndex addNAry(NodeType type, const std::vector<T> &arguments, Tree &tree, VariableDeclarationMap &boundVariables)
+	{
+		const auto node = tree.addNode(type, 0, arguments.size());
+
+		for (size_t i = 0; i < arguments.size(); i++)
+		{
+			const auto argument = add(arguments[i], tree, boundVariables);
+			tree.m_children[tree.m_firstChildren[node] + i] = argument;
+		}
+
+		return node;
+	}
+
+	static NodeIndex addQuantifier(NodeType type, const ast::VariableDeclarationPointers &variables, const ast::Formula &argument, Tree &tree, VariableDeclarationMap &boundVariables)
+	{
+		const auto node = tree.addNode(type, 0, variables.size() + 1);
+
+		for (size_t i = 0; i < variables.size(); i++)
+		{
+			const auto &variable = *variables[i];
+
+			tree.m_boundVariableDeclarations.emplace_back(std::make_unique<ast::VariableDeclaration>(variable.type, variable.domain, std::string(variable.name)));
+			auto *boundVariable = tree.m_boundVariableDeclarations.back().get();
+			boundVariables[&variable] = boundVariable;
+
+			const auto variableNode = tree.addVariable(boundVariable);
+			tree.m_children[tree.m_firstChildren[node] + i] = variableNode;
+		}
+
+		const auto argumentNode = tree.addFormula(argument, boundVariables);
+		tree.m_children[tree.m_firstChildren[node] + variables.size()] = argumentNode;
+
+		return node;
+	}
+
+	static NodeIndex add(const ast::Formula &formula, Tree &tree, VariableDeclarationMap &boundVariables)
+	{
+		return tree.addFormula(formula, boundVariables);
+	}
+
+	static NodeIndex add(const ast::Term &term, Tree &tree, VariableDeclarationMap &boundVariables)
+	{
+		return tree.addTerm(term, boundVariables);
+	}
+
+	static NodeIndex visit(const ast::And &and_, Tree &tree, VariableDeclarationMap &boundVariables)
+	{
+		return addNAry(NodeType::And, and_.arguments, tree, boundVariables);
+	}
+
+	static NodeIndex visit(const ast::Biconditional &biconditional, Tree &tree, VariableDeclarationMap &boundVariables)
+	{
+		return addBinary(NodeType::Biconditional, biconditional.left, biconditional.right, tree, boundVariables);
+	}
+
+	static NodeIndex visit(const ast::Boolean &boolean, Tree &tree, VariableDeclarationMap &)
+	{
+		return tree.addNode(NodeType::Boolean, boolean.value ? 1 : 0, 0);
+	}
+
+	static NodeIndex visit(const ast::Comparison &comparison, Tree &tree, VariableDeclarationMap &boundVariables)
+	{
+		const auto node = addBinary(NodeType::Comparison, comparison.left, comparison.right, tree, boundVariables);
+		tree.m_values[node] = static_cast<int32_t>(comparison.operator_);
+
+		return node;
+	}
+
+	static NodeIndex visit(const ast::Exists &exists, Tree &tree, VariableDeclarationMap &boundVariables)
+	{
+		return addQuantifier(NodeType::Exists, exists.variables, exists.argument, tree, boundVariables);
+	}
+
+	static NodeIndex visit(const ast::ForAll &forAll, Tree &tree, VariableDeclarationMap &boundVariables)
+	{
+		return addQuantifier(NodeType::ForAll, forAll.variables, forAll.argument, tree, boundVariables);
+	}
+
+	static NodeIndex visit(const ast::Implies &implies, Tree &tree, VariableDeclarationMap &boundVariables)
+	{
+		return addBinary(NodeType::Implies, implies.antecedent, implies.consequent, tree, boundVariables);
+	}
+
+	static NodeIndex visit(const ast::In &in, Tree &tree, VariableDeclarationMap &boundVariables)
+	{
+		return addBinary(NodeType::In, in.element, in.set, tree, boundVariables);
+	}
+
+	static NodeIndex visit(const ast::Not &not_, Tree &tree, VariableDeclarationMap &boundVariables)
+	{
+		const auto node = tree.addNode(NodeType::Not, 0, 1);
+		const auto argument = tree.addFormula(not_.argument, boundVariables);
+
+		tree.m_children[tree.m_firstChildren[node]] = argument;
+
+		return node;
+	}
+
+	static NodeIndex visit(const ast::Or &or_, Tree &tree, VariableDeclarationMap &boundVariables)
+	{
+		return addNAry(NodeType::Or, or_.arguments, tree, boundVariables);
+	}
+
+	static NodeIndex visit(const ast::Predicate &predicate, Tree &tree, VariableDeclarationMap &boundVariables)
+	{
+		const auto node = addNAry(NodeType::Predicate, predicate.arguments, tree, boundVariables);
+
+		tree.m_predicateDeclarations.emplace_back(predicate.declaration);
+		tree.m_values[node] = tree.m_predicateDeclarations.size() - 1;
+
+		return node;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+NodeIndex Tree::add(const ast::Formula &formula)
+{
+	VariableDeclarationMap boundVariables;
+
+	return addFormula(formula, boundVariables);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+NodeIndex Tree::add(const ast::Term &term)
+{
+	return addTerm(term, VariableDeclarationMap());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+NodeIndex Tree::addNode(NodeType type, int32_t value, size_t numberOfChildren)
+{
+	const auto node = static_cast<NodeIndex>(m_types.size());
+
+	m_types.emplace_back(type);
+	m_firstChildren.emplace_back(m_children.size());
+	m_numbersOfChildren.emplace_back(numberOfChildren);
+	m_values.emplace_back(value);
+
+	// Reserve the range of children, which is filled in once the children have been added
+	m_children.resize(m_children.size() + numberOfChildren);
+
+	return node;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+NodeIndex Tree::addVariable(ast::VariableDeclaration *variableDeclaration)
+{
+	m_variableDeclarations.emplace_back(variableDeclaration);
+
+	return addNode(NodeType::Variable, m_variableDeclarations.size() - 1, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+NodeIndex Tree::addFormula(const ast::Formula &formula, VariableDeclarationMap &boundVariables)
+{
+	return formula.accept(FormulaConverter(), *this, boundVariables);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+NodeIndex Tree::addTerm(const ast::Term &term, const VariableDeclarationMap &boundVariables)
+{
+	return term.accept(TermConverter(), *this, boundVariables);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Converting to the AST
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ast::Formula Tree::toFormula(NodeIndex node) const
+{
+	VariableDeclarationMap boundVariables;
+
+	return toFormula(node, boundVariables);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ast::Term Tree::toTerm(NodeIndex node) const
+{
+	return toTerm(node, VariableDeclarationMap());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ast::Formula Tree::toFormula(NodeIndex node, VariableDeclarationMap &boundVariables) const
+{
+	const auto children = this->children(node);
+
+	const auto toFormulas =
+		[&]()
+		{
+			std::vector<ast::Formula> arguments;
+			arguments.reserve(children.size());
+
+			for (const auto child : children)
+				arguments.emplace_back(toFormula(child, boundVariables));
+
+			return arguments;
+		};
+
+	const auto toQuantifiedVariables =
+		[&]()
+		{
+			ast::VariableDeclarationPointers variables;
+			variables.reserve(children.size() - 1);
+
+			for (size_t i = 0; i < children.size() - 1; i++)
+			{
+				const auto *variable = variableDeclaration(children[i]);
+
+				variables.emplace_back(std::make_unique<ast::VariableDeclaration>(variable->type, variable->domain, std::string(variable->name)));
+				boundVariables[variable] = variables.back().get();
+			}
+
+			return variables;
+		};
+
+	switch (type(node))
+	{
+		case NodeType::And:
+			return ast::And(toFormulas());
+		case NodeType::Biconditional:
+			return ast::Biconditional(toFormula(children[0], boundVariables), toFormula(children[1], boundVariables));
+		case NodeType::Boolean:
+			return ast::Boolean(booleanValue(node));
+		case NodeType::Comparison:
+			return ast::Comparison(operator_<ast::Comparison::Operator>(node), toTerm(children[0], boundVariables), toTerm(children[1], boundVariables));
+		case NodeType::Exists:
+		{
+			auto variables = toQuantifiedVariables();
+			return ast::Exists(std::move(variables), toFormula(children.back(), boundVariables));
+		}
+		case NodeType::ForAll:
+		{
+			auto variables = toQuantifiedVariables();
+			return ast::ForAll(std::move(variables), toFormula(children.back(), boundVariables));
+		}
+		case NodeType::Implies:
+			return ast::Implies(toFormula(children[0], boundVariables), toFormula(children[1], boundVariables));
+		case NodeType::In:
+			return ast::In(toTerm(children[0], boundVariables), toTerm(children[1], boundVariables));
+		case NodeType::Not:
+			return ast::Not(toFormula(children[0], boundVariables));
+		case NodeType::Or:
+			return ast::Or(toFormulas());
+		case NodeType::Predicate:
+		{
+			std::vector<ast::Term> arguments;
+			arguments.reserve(children.size());
+
+			for (const auto child : children)
+				arguments.emplace_back(toTerm(child, boundVariables));
+
+			return ast::Predicate(predicateDeclaration(node), std::move(arguments));
+		}
+		default:
+			break;
+	}
+
+	throw LogicException("flat AST node is not a formula, please report to bug tracker");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ast::Term Tree::toTerm(NodeIndex node, const VariableDeclarationMap &boundVariables) const
+{
+	const auto children = this->children(node);
+
+	switch (type(node))
+	{
+		case NodeType::BinaryOperation:
+			return ast::BinaryOperation(operator_<ast::BinaryOperation::Operator>(node), toTerm(children[0], boundVariables), toTerm(children[1], boundVariables));
+		case NodeType::Boolean:
+			return ast::Boolean(booleanValue(node));
+		case NodeType::Function:
+		{
+			std::vector<ast::Term> arguments;
+			arguments.reserve(children.size());
+
+			for (const auto child : children)
+				arguments.emplace_back(toTerm(child, boundVariables));
+
+			return ast::Function(functionDeclaration(node), std::move(arguments));
+		}
+		case NodeType::Integer:
+			return ast::Integer(integerValue(node));
+		case NodeType::Interval:
+			return ast::Interval(toTerm(children[0], boundVariables), toTerm(children[1], boundVariables));
+		case NodeType::SpecialInteger:
+			return ast::SpecialInteger(specialIntegerType(node));
+		case NodeType::String:
+			return ast::String(std::string(string(node)));
+		case NodeType::UnaryOperation:
+			return ast::UnaryOperation(operator_<ast::UnaryOperation::Operator>(node), toTerm(children[0], boundVariables));
+		case NodeType::Variable:
+		{
+			auto *variable = variableDeclaration(node);
+			const auto matchingBoundVariable = boundVariables.find(variable);
+
+			if (matchingBoundVariable != boundVariables.cend())
+				return ast::Variable(matchingBoundVariable->second);
+
+			return ast::Variable(variable);
+		}
+		default:
+			break;
+	}
+
+	throw LogicException("flat AST node is not a term, please report to bug tracker");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+}
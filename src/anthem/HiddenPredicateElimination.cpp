@@ -1,5 +1,8 @@
 #include <anthem/HiddenPredicateElimination.h>
 
+#include <algorithm>
+#include <unordered_map>
+
 #include <anthem/ASTCopy.h>
 #include <anthem/ASTUtils.h>
 #include <anthem/ASTVisitors.h>
@@ -23,55 +26,6 @@ struct PredicateReplacement
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-// Replaces all occurrences of a variable in a given term with another variable
-struct ReplaceVariableInTermVisitor : public ast::RecursiveTermVisitor<ReplaceVariableInTermVisitor>
-{
-	static void accept(ast::Variable &variable, ast::Term &, const ast::VariableDeclaration &original, ast::VariableDeclaration &replacement)
-	{
-		if (variable.declaration == &original)
-			// No dangling variables can result from this operation, and hence, fixing them is not necessary
-			variable.declaration = &replacement;
-	}
-
-	// Ignore all other types of expressions
-	template<class T>
-	static void accept(T &, ast::Term &, const ast::VariableDeclaration &, ast::VariableDeclaration &)
-	{
-	}
-};
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
-// Replaces all occurrences of a variable in a given formula with another variable
-struct ReplaceVariableInFormulaVisitor : public ast::RecursiveFormulaVisitor<ReplaceVariableInFormulaVisitor>
-{
-	static void accept(ast::Comparison &comparison, ast::Formula &, const ast::VariableDeclaration &original, ast::VariableDeclaration &replacement)
-	{
-		comparison.left.accept(ReplaceVariableInTermVisitor(), comparison.left, original, replacement);
-		comparison.right.accept(ReplaceVariableInTermVisitor(), comparison.right, original, replacement);
-	}
-
-	static void accept(ast::In &in, ast::Formula &, const ast::VariableDeclaration &original, ast::VariableDeclaration &replacement)
-	{
-		in.element.accept(ReplaceVariableInTermVisitor(), in.element, original, replacement);
-		in.set.accept(ReplaceVariableInTermVisitor(), in.set, original, replacement);
-	}
-
-	static void accept(ast::Predicate &predicate, ast::Formula &, const ast::VariableDeclaration &original, ast::VariableDeclaration &replacement)
-	{
-		for (auto &argument : predicate.arguments)
-			argument.accept(ReplaceVariableInTermVisitor(), argument, original, replacement);
-	}
-
-	// Ignore all other types of expressions
-	template<class T>
-	static void accept(T &, ast::Formula &, const ast::VariableDeclaration &, ast::VariableDeclaration &)
-	{
-	}
-};
-
-////////////////////////////////////////////////////////////////////////////////////////////////////
-
 // Replace a predicate in a term with a formula
 struct ReplacePredicateInFormulaVisitor : public ast::RecursiveFormulaVisitor<ReplacePredicateInFormulaVisitor>
 {
@@ -82,6 +36,8 @@ struct ReplacePredicateInFormulaVisitor : public ast::RecursiveFormulaVisitor<Re
 
 		auto formulaReplacement = ast::prepareCopy(predicateReplacement.replacement);
 
+		ast::VariableSubstitution substitution;
+
 		for (size_t i = 0; i < predicate.arguments.size(); i++)
 		{
 			assert(predicateReplacement.predicate.arguments[i].is<ast::Variable>());
@@ -90,9 +46,12 @@ struct ReplacePredicateInFormulaVisitor : public ast::RecursiveFormulaVisitor<Re
 			assert(predicate.arguments[i].is<ast::Variable>());
 			auto &replacement = *predicate.arguments[i].get<ast::Variable>().declaration;
 
-			formulaReplacement.accept(ReplaceVariableInFormulaVisitor(), formulaReplacement, original, replacement);
+			substitution.add(original, replacement);
 		}
 
+		// No dangling variables can result from this operation, and hence, fixing them is not necessary
+		substitution.apply(formulaReplacement);
+
 		formula = std::move(formulaReplacement);
 	}
 
@@ -185,6 +144,127 @@ PredicateReplacement findReplacement(const ast::PredicateDeclaration &predicateD
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Collects the predicates occurring in a formula
+struct CollectPredicatesVisitor : public ast::RecursiveFormulaVisitor<CollectPredicatesVisitor>
+{
+	static void accept(ast::Predicate &predicate, ast::Formula &, std::vector<const ast::PredicateDeclaration *> &predicateDeclarations)
+	{
+		predicateDeclarations.emplace_back(predicate.declaration);
+	}
+
+	// Ignore all other types of expressions
+	template<class T>
+	static void accept(T &, ast::Formula &, std::vector<const ast::PredicateDeclaration *> &)
+	{
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Returns the predicate that a completed formula defines, or nullptr if it is an integrity constraint
+const ast::PredicateDeclaration *definedPredicate(const ast::Formula &completedFormula)
+{
+	if (completedFormula.is<ast::ForAll>())
+		return definedPredicate(completedFormula.get<ast::ForAll>().argument);
+	else if (completedFormula.is<ast::Biconditional>())
+	{
+		const auto &left = completedFormula.get<ast::Biconditional>().left;
+		return left.is<ast::Predicate>() ? left.get<ast::Predicate>().declaration : nullptr;
+	}
+	else if (completedFormula.is<ast::Predicate>())
+		return completedFormula.get<ast::Predicate>().declaration;
+	else if (completedFormula.is<ast::Not>())
+	{
+		const auto &argument = completedFormula.get<ast::Not>().argument;
+		return argument.is<ast::Predicate>() ? argument.get<ast::Predicate>().declaration : nullptr;
+	}
+
+	return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct HiddenPredicate
+{
+	ast::PredicateDeclaration *declaration;
+	// Position of the completed definition among the completed formulas
+	size_t definition;
+	// Positions of the completed formulas mentioning the predicate, possibly among others that don’t
+	// mention it anymore
+	std::vector<size_t> occurrences;
+	// How often the predicate occurs outside of its definition
+	size_t numberOfOccurrences{0};
+	// Hidden predicates that the completed definition mentions
+	std::vector<HiddenPredicate *> dependencies;
+	bool isEliminated{false};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Orders hidden predicates such that those a predicate depends on come first, by finding the strongly
+// connected components of the dependency graph with Tarjan’s algorithm. Predicates with circular
+// dependencies end up in the same component
+struct DependencyOrder
+{
+	void visit(HiddenPredicate &hiddenPredicate)
+	{
+		auto &visit = visits[&hiddenPredicate];
+		visit.index = visit.lowLink = numberOfVisits++;
+		visit.isOnStack = true;
+		stack.push_back(&hiddenPredicate);
+
+		for (auto *dependency : hiddenPredicate.dependencies)
+		{
+			const auto match = visits.find(dependency);
+
+			if (match == visits.end())
+			{
+				this->visit(*dependency);
+				visits[&hiddenPredicate].lowLink = std::min(visits[&hiddenPredicate].lowLink, visits[dependency].lowLink);
+			}
+			else if (match->second.isOnStack)
+				visits[&hiddenPredicate].lowLink = std::min(visits[&hiddenPredicate].lowLink, match->second.index);
+		}
+
+		if (visits[&hiddenPredicate].lowLink != visits[&hiddenPredicate].index)
+			return;
+
+		// Within a component, predicates are eliminated in the order of their definitions
+		const auto componentStart = components.size();
+		HiddenPredicate *member;
+
+		do
+		{
+			member = stack.back();
+			stack.pop_back();
+			visits[member].isOnStack = false;
+			components.push_back(member);
+		}
+		while (member != &hiddenPredicate);
+
+		std::sort(components.begin() + componentStart, components.end(),
+			[](const auto *lhs, const auto *rhs)
+			{
+				return lhs->definition < rhs->definition;
+			});
+	}
+
+	struct Visit
+	{
+		size_t index;
+		size_t lowLink;
+		bool isOnStack;
+	};
+
+	std::unordered_map<const HiddenPredicate *, Visit> visits;
+	std::vector<HiddenPredicate *> stack;
+	size_t numberOfVisits{0};
+	// Hidden predicates in the order in which they are eliminated
+	std::vector<HiddenPredicate *> components;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void eliminateHiddenPredicates(std::vector<ast::Formula> &completedFormulas, Context &context)
 {
 	if (context.defaultPredicateVisibility == ast::PredicateDeclaration::Visibility::Visible)
@@ -195,17 +275,22 @@ void eliminateHiddenPredicates(std::vector<ast::Formula> &completedFormulas, Con
 
 	assert(context.defaultPredicateVisibility == ast::PredicateDeclaration::Visibility::Hidden);
 
-	// TODO: get rid of index-wise matching of completed formulas and predicate declarations
-	size_t i = -1;
+	// Completion yields the completed definitions in the order of the predicate declarations, followed
+	// by the integrity constraints
+	std::vector<HiddenPredicate> hiddenPredicates;
+	std::unordered_map<const ast::PredicateDeclaration *, HiddenPredicate *> hiddenPredicateIndex;
+	size_t numberOfDefinitions = 0;
 
-	// Replace all occurrences of hidden predicates
 	for (auto &predicateDeclaration : context.predicateDeclarations)
 	{
 		// Check that the predicate is used and not declared #external
 		if (!predicateDeclaration->isUsed || predicateDeclaration->isExternal)
 			continue;
 
-		i++;
+		const auto definition = numberOfDefinitions++;
+
+		if (definition >= completedFormulas.size() || definedPredicate(completedFormulas[definition]) != predicateDeclaration.get())
+			throw CompletionException("completed definition of “" + predicateDeclaration->name + "/" + std::to_string(predicateDeclaration->arity()) + "” not found for hiding predicates");
 
 		const auto isPredicateVisible =
 			(predicateDeclaration->visibility == ast::PredicateDeclaration::Visibility::Visible)
@@ -216,26 +301,124 @@ void eliminateHiddenPredicates(std::vector<ast::Formula> &completedFormulas, Con
 		if (isPredicateVisible)
 			continue;
 
-		context.logger.log(output::Priority::Debug) << "eliminating “" << predicateDeclaration->name << "/" << predicateDeclaration->arity() << "”";
+		hiddenPredicates.push_back({predicateDeclaration.get(), definition, {}, 0, {}, false});
+	}
+
+	for (auto &hiddenPredicate : hiddenPredicates)
+		hiddenPredicateIndex.emplace(hiddenPredicate.declaration, &hiddenPredicate);
+
+	const auto findHiddenPredicate =
+		[&](const ast::PredicateDeclaration *predicateDeclaration) -> HiddenPredicate *
+		{
+			const auto match = hiddenPredicateIndex.find(predicateDeclaration);
+
+			return (match == hiddenPredicateIndex.end()) ? nullptr : match->second;
+		};
+
+	// Index where hidden predicates occur, and on which hidden predicates their definitions depend
+	std::vector<HiddenPredicate *> definitions(completedFormulas.size(), nullptr);
+
+	for (auto &hiddenPredicate : hiddenPredicates)
+		definitions[hiddenPredicate.definition] = &hiddenPredicate;
+
+	std::vector<const ast::PredicateDeclaration *> predicateDeclarations;
+
+	for (size_t i = 0; i < completedFormulas.size(); i++)
+	{
+		predicateDeclarations.clear();
+		completedFormulas[i].accept(CollectPredicatesVisitor(), completedFormulas[i], predicateDeclarations);
+
+		for (const auto *predicateDeclaration : predicateDeclarations)
+		{
+			auto *hiddenPredicate = findHiddenPredicate(predicateDeclaration);
+
+			if (!hiddenPredicate)
+				continue;
+
+			if (i != hiddenPredicate->definition)
+				hiddenPredicate->numberOfOccurrences++;
+
+			if (!hiddenPredicate->occurrences.empty() && hiddenPredicate->occurrences.back() == i)
+				continue;
+
+			hiddenPredicate->occurrences.push_back(i);
+
+			if (definitions[i] && definitions[i] != hiddenPredicate)
+				definitions[i]->dependencies.push_back(hiddenPredicate);
+		}
+	}
+
+	DependencyOrder dependencyOrder;
+
+	for (auto &hiddenPredicate : hiddenPredicates)
+		if (dependencyOrder.visits.find(&hiddenPredicate) == dependencyOrder.visits.end())
+			dependencyOrder.visit(hiddenPredicate);
+
+	// Replace all occurrences of hidden predicates, those a predicate depends on first, so that
+	// replacements only mention hidden predicates with circular dependencies
+	for (auto *hiddenPredicate : dependencyOrder.components)
+	{
+		auto &predicateDeclaration = *hiddenPredicate->declaration;
+		const auto i = hiddenPredicate->definition;
+
+		context.logger.log(output::Priority::Debug) << "eliminating “" << predicateDeclaration.name << "/" << predicateDeclaration.arity() << "”";
 
 		const auto &completedPredicateDefinition = completedFormulas[i];
-		auto replacement = findReplacement(*predicateDeclaration, completedPredicateDefinition);
+		auto replacement = findReplacement(predicateDeclaration, completedPredicateDefinition);
 
 		bool hasCircularDependency = false;
-		replacement.replacement.accept(DetectCircularDependcyVisitor(), replacement.replacement, *predicateDeclaration, hasCircularDependency);
+		replacement.replacement.accept(DetectCircularDependcyVisitor(), replacement.replacement, predicateDeclaration, hasCircularDependency);
 
 		if (hasCircularDependency)
 		{
-			context.logger.log(output::Priority::Warning) << "cannot hide predicate “" << predicateDeclaration->name << "/" << predicateDeclaration->arity() << "” due to circular dependency";
+			context.logger.log(output::Priority::Warning) << "cannot hide predicate “" << predicateDeclaration.name << "/" << predicateDeclaration.arity() << "” due to circular dependency";
+			continue;
+		}
+
+		// Substituting large definitions for several occurrences would make the output grow exponentially
+		// with chains of hidden predicates, so they are kept as abbreviations instead. The predicates they
+		// depend on have been eliminated or abbreviated before, so their size is bounded
+		if (context.abbreviationThreshold > 0 && hiddenPredicate->numberOfOccurrences > 1
+			&& ast::countNodes(replacement.replacement) > context.abbreviationThreshold)
+		{
+			context.logger.log(output::Priority::Debug) << "keeping “" << predicateDeclaration.name << "/" << predicateDeclaration.arity() << "” as an abbreviation";
+			predicateDeclaration.isAbbreviation = true;
 			continue;
 		}
 
-		for (size_t j = 0; j < completedFormulas.size(); j++)
-			if (j != i)
-				completedFormulas[j].accept(ReplacePredicateInFormulaVisitor(), completedFormulas[j], replacement);
+		// Hidden predicates that are yet to be eliminated now also occur where the replacement is inserted
+		predicateDeclarations.clear();
+		replacement.replacement.accept(CollectPredicatesVisitor(), replacement.replacement, predicateDeclarations);
+
+		std::vector<HiddenPredicate *> introducedHiddenPredicates;
+
+		for (const auto *introducedPredicateDeclaration : predicateDeclarations)
+		{
+			auto *introducedHiddenPredicate = findHiddenPredicate(introducedPredicateDeclaration);
+
+			if (!introducedHiddenPredicate || introducedHiddenPredicate->isEliminated)
+				continue;
+
+			introducedHiddenPredicate->numberOfOccurrences += hiddenPredicate->numberOfOccurrences;
+
+			if (std::find(introducedHiddenPredicates.cbegin(), introducedHiddenPredicates.cend(), introducedHiddenPredicate) == introducedHiddenPredicates.cend())
+				introducedHiddenPredicates.push_back(introducedHiddenPredicate);
+		}
+
+		for (const auto j : hiddenPredicate->occurrences)
+		{
+			if (j == i)
+				continue;
+
+			completedFormulas[j].accept(ReplacePredicateInFormulaVisitor(), completedFormulas[j], replacement);
+
+			for (auto *introducedHiddenPredicate : introducedHiddenPredicates)
+				introducedHiddenPredicate->occurrences.push_back(j);
+		}
 
 		// TODO: refactor
 		completedFormulas[i] = ast::Boolean(true);
+		hiddenPredicate->isEliminated = true;
 	}
 
 	const auto canBeRemoved =
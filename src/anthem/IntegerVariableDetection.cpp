@@ -1,10 +1,14 @@
 #include <anthem/IntegerVariableDetection.h>
 
-#include <map>
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <unordered_map>
 
 #include <anthem/ASTCopy.h>
 #include <anthem/ASTUtils.h>
 #include <anthem/ASTVisitors.h>
+#include <anthem/BitParallelEvaluation.h>
 #include <anthem/Evaluation.h>
 #include <anthem/Exception.h>
 #include <anthem/Simplification.h>
@@ -20,311 +24,327 @@ namespace anthem
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-using VariableDomainMap = std::map<const ast::VariableDeclaration *, Domain>;
+// Variables assumed to be symbolic, one hypothesis per lane. As there are never more variables than lanes, they
+// are stored in a small open-addressing table owned by the detection run. Instead of resetting all entries for
+// the next hypotheses, entries from earlier epochs are treated as unset
+class Hypotheses
+{
+	public:
+		// Starts a new set of hypotheses in which no variables are assumed to be symbolic
+		void clear()
+		{
+			m_epoch++;
+		}
 
-////////////////////////////////////////////////////////////////////////////////////////////////////
+		void makeSymbolic(const ast::VariableDeclaration &variableDeclaration, size_t lane)
+		{
+			auto &entry = m_entries[findEntry(variableDeclaration)];
 
-Domain domain(const ast::Variable &variable, VariableDomainMap &variableDomainMap)
-{
-	if (variable.declaration->domain != Domain::Unknown)
-		return variable.declaration->domain;
+			if (entry.epoch != m_epoch)
+				entry = Entry{&variableDeclaration, m_epoch, 0};
 
-	const auto match = variableDomainMap.find(variable.declaration);
+			entry.symbolicLanes |= Lanes(1) << lane;
+		}
 
-	if (match == variableDomainMap.end())
-		return Domain::Unknown;
+		Lanes symbolicLanes(const ast::VariableDeclaration &variableDeclaration) const
+		{
+			const auto &entry = m_entries[findEntry(variableDeclaration)];
 
-	return match->second;
-}
+			return (entry.epoch == m_epoch ? entry.symbolicLanes : 0);
+		}
 
-////////////////////////////////////////////////////////////////////////////////////////////////////
+	private:
+		struct Entry
+		{
+			const ast::VariableDeclaration *variableDeclaration{nullptr};
+			size_t epoch{0};
+			Lanes symbolicLanes{0};
+		};
+
+		// With at least twice as many entries as lanes, probe sequences stay short
+		static constexpr size_t NumberOfEntryBits = 7;
+		static constexpr size_t NumberOfEntries = size_t(1) << NumberOfEntryBits;
+		static_assert(NumberOfEntries >= 2 * NumberOfLanes);
+
+		// Returns the index of the entry of a variable, or of the unset entry where it is to be stored
+		size_t findEntry(const ast::VariableDeclaration &variableDeclaration) const
+		{
+			// Fibonacci hashing spreads the aligned addresses of the declarations over the table
+			const auto address = reinterpret_cast<uintptr_t>(&variableDeclaration);
+			auto index = static_cast<size_t>((static_cast<uint64_t>(address) * 0x9e3779b97f4a7c15) >> (64 - NumberOfEntryBits));
 
-void clearVariableDomainMap(VariableDomainMap &variableDomainMap)
-{
-	for (auto &variableDeclaration : variableDomainMap)
-		variableDeclaration.second = Domain::Unknown;
-}
+			while (m_entries[index].epoch == m_epoch && m_entries[index].variableDeclaration != &variableDeclaration)
+				index = (index + 1) % NumberOfEntries;
+
+			return index;
+		}
+
+		std::array<Entry, NumberOfEntries> m_entries;
+		size_t m_epoch{1};
+};
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct VariableDomainMapAccessor
+struct HypothesesAccessor
 {
-	Domain operator()(const ast::Variable &variable, VariableDomainMap &variableDomainMap)
+	TypeLanes operator()(const ast::Variable &variable, Hypotheses &hypotheses)
 	{
-		return domain(variable, variableDomainMap);
+		const auto domain = variable.declaration->domain;
+
+		if (domain != Domain::Unknown)
+			return TypeLanes::broadcast({domain, SetSize::Unit});
+
+		const auto symbolicLanes = hypotheses.symbolicLanes(*variable.declaration);
+
+		auto typeLanes = TypeLanes::broadcast({Domain::Symbolic, SetSize::Unit}, symbolicLanes);
+		typeLanes.add({Domain::Unknown, SetSize::Unit}, ~symbolicLanes);
+
+		return typeLanes;
 	}
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-Type type(const ast::Term &term, VariableDomainMap &variableDomainMap)
+// Checks for each variable whether assuming it to be symbolic makes the formula evaluate to the
+// contradicting result or to an error, which proves the variable to be integer. Each hypothesis occupies
+// one lane, so that up to 64 of them are checked with a single evaluation
+OperationResult checkHypotheses(const std::vector<ast::VariableDeclaration *> &variableDeclarations,
+	const ast::Formula &formula, EvaluationResult contradictingResult, Hypotheses &hypotheses)
 {
-	return type<VariableDomainMapAccessor>(term, variableDomainMap);
-}
+	assert(contradictingResult == EvaluationResult::True || contradictingResult == EvaluationResult::False);
 
-////////////////////////////////////////////////////////////////////////////////////////////////////
+	auto operationResult = OperationResult::Unchanged;
 
-EvaluationResult evaluate(const ast::Formula &formula, VariableDomainMap &variableDomainMap)
-{
-	return evaluate<VariableDomainMap>(formula, variableDomainMap);
-}
+	for (size_t first = 0; first < variableDeclarations.size(); first += NumberOfLanes)
+	{
+		const auto numberOfHypotheses = std::min(NumberOfLanes, variableDeclarations.size() - first);
 
-////////////////////////////////////////////////////////////////////////////////////////////////////
+		hypotheses.clear();
 
-template <class Functor>
-struct ForEachVariableDeclarationVisitor
-{
-	template <class... Arguments>
-	static OperationResult visit(ast::And &and_, Arguments &&... arguments)
-	{
-		auto operationResult = OperationResult::Unchanged;
+		for (size_t lane = 0; lane < numberOfHypotheses; lane++)
+			hypotheses.makeSymbolic(*variableDeclarations[first + lane], lane);
 
-		for (auto &argument : and_.arguments)
-			if (argument.accept(ForEachVariableDeclarationVisitor(), std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-				operationResult = OperationResult::Changed;
+		const auto result = evaluateLanes<HypothesesAccessor>(formula, hypotheses);
 
-		return operationResult;
-	}
+		// Erroneous lanes have their bits set in both planes
+		const auto contradictingLanes = (contradictingResult == EvaluationResult::True ? result.isTrue : result.isFalse);
 
-	template <class... Arguments>
-	static OperationResult visit(ast::Biconditional &biconditional, Arguments &&... arguments)
-	{
-		auto operationResult = OperationResult::Unchanged;
+		for (size_t lane = 0; lane < numberOfHypotheses; lane++)
+		{
+			auto &variableDeclaration = *variableDeclarations[first + lane];
 
-		if (biconditional.left.accept(ForEachVariableDeclarationVisitor(), std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-			operationResult = OperationResult::Changed;
+			if (((contradictingLanes >> lane) & 1) == 0 || variableDeclaration.domain != Domain::Unknown)
+				continue;
 
-		if (biconditional.right.accept(ForEachVariableDeclarationVisitor(), std::forward<Arguments>(arguments)...) == OperationResult::Changed)
+			variableDeclaration.domain = Domain::Integer;
 			operationResult = OperationResult::Changed;
-
-		return operationResult;
+		}
 	}
 
-	template <class... Arguments>
-	static OperationResult visit(ast::Boolean &, Arguments &&...)
-	{
-		return OperationResult::Unchanged;
-	}
+	return operationResult;
+}
 
-	template <class... Arguments>
-	static OperationResult visit(ast::Comparison &, Arguments &&...)
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Collects the variables bound in a formula whose domains are still unknown, innermost ones first
+struct CollectUnknownVariablesVisitor : public ast::RecursiveFormulaVisitor<CollectUnknownVariablesVisitor>
+{
+	static void accept(ast::Exists &exists, ast::Formula &, std::vector<ast::VariableDeclaration *> &variableDeclarations)
 	{
-		return OperationResult::Unchanged;
+		collect(exists.variables, variableDeclarations);
 	}
 
-	template <class... Arguments>
-	static OperationResult visit(ast::Exists &exists, Arguments &&... arguments)
+	static void accept(ast::ForAll &forAll, ast::Formula &, std::vector<ast::VariableDeclaration *> &variableDeclarations)
 	{
-		auto operationResult = OperationResult::Unchanged;
-
-		if (exists.argument.accept(ForEachVariableDeclarationVisitor(), std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-			operationResult = OperationResult::Changed;
-
-		for (auto &variableDeclaration : exists.variables)
-			if (Functor()(*variableDeclaration, exists.argument, std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-				operationResult = OperationResult::Changed;
-
-		return operationResult;
+		collect(forAll.variables, variableDeclarations);
 	}
 
-	template <class... Arguments>
-	static OperationResult visit(ast::ForAll &forAll, Arguments &&... arguments)
+	// Ignore all other types of expressions
+	template<class T>
+	static void accept(T &, ast::Formula &, std::vector<ast::VariableDeclaration *> &)
 	{
-		auto operationResult = OperationResult::Unchanged;
-
-		if (forAll.argument.accept(ForEachVariableDeclarationVisitor(), std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-			operationResult = OperationResult::Changed;
-
-		for (auto &variableDeclaration : forAll.variables)
-			if (Functor()(*variableDeclaration, forAll.argument, std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-				operationResult = OperationResult::Changed;
-
-		return operationResult;
 	}
 
-	template <class... Arguments>
-	static OperationResult visit(ast::Implies &implies, Arguments &&... arguments)
+	static void collect(const ast::VariableDeclarationPointers &variables, std::vector<ast::VariableDeclaration *> &variableDeclarations)
 	{
-		auto operationResult = OperationResult::Unchanged;
-
-		if (implies.antecedent.accept(ForEachVariableDeclarationVisitor(), std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-			operationResult = OperationResult::Changed;
+		for (const auto &variableDeclaration : variables)
+			if (variableDeclaration->domain == Domain::Unknown)
+				variableDeclarations.push_back(variableDeclaration.get());
+	}
+};
 
-		if (implies.consequent.accept(ForEachVariableDeclarationVisitor(), std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-			operationResult = OperationResult::Changed;
+////////////////////////////////////////////////////////////////////////////////////////////////////
 
-		return operationResult;
+// If making a quantified variable symbolic renders the quantified formula false, the variable is integer
+struct CheckIfQuantifiedFormulasFalseVisitor : public ast::RecursiveFormulaVisitor<CheckIfQuantifiedFormulasFalseVisitor>
+{
+	static void accept(ast::Exists &exists, ast::Formula &, Hypotheses &hypotheses, OperationResult &operationResult)
+	{
+		check(exists.variables, exists.argument, hypotheses, operationResult);
 	}
 
-	template <class... Arguments>
-	static OperationResult visit(ast::In &, Arguments &&...)
+	static void accept(ast::ForAll &forAll, ast::Formula &, Hypotheses &hypotheses, OperationResult &operationResult)
 	{
-		return OperationResult::Unchanged;
+		check(forAll.variables, forAll.argument, hypotheses, operationResult);
 	}
 
-	template <class... Arguments>
-	static OperationResult visit(ast::Not &not_, Arguments &&... arguments)
+	// Ignore all other types of expressions
+	template<class T>
+	static void accept(T &, ast::Formula &, Hypotheses &, OperationResult &)
 	{
-		return not_.argument.accept(ForEachVariableDeclarationVisitor(), std::forward<Arguments>(arguments)...);
 	}
 
-	template <class... Arguments>
-	static OperationResult visit(ast::Or &or_, Arguments &&... arguments)
+	static void check(const ast::VariableDeclarationPointers &variables, const ast::Formula &quantifiedFormula,
+		Hypotheses &hypotheses, OperationResult &operationResult)
 	{
-		auto operationResult = OperationResult::Unchanged;
+		std::vector<ast::VariableDeclaration *> variableDeclarations;
+		CollectUnknownVariablesVisitor::collect(variables, variableDeclarations);
 
-		for (auto &argument : or_.arguments)
-			if (argument.accept(ForEachVariableDeclarationVisitor(), std::forward<Arguments>(arguments)...) == OperationResult::Changed)
-				operationResult = OperationResult::Changed;
+		if (checkHypotheses(variableDeclarations, quantifiedFormula, EvaluationResult::False, hypotheses) == OperationResult::Changed)
+			operationResult = OperationResult::Changed;
+	}
+};
 
-		return operationResult;
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct CollectPredicateOccurrencesVisitor : public ast::RecursiveFormulaVisitor<CollectPredicateOccurrencesVisitor>
+{
+	static void accept(ast::Predicate &predicate, ast::Formula &, std::vector<const ast::PredicateDeclaration *> &predicateDeclarations)
+	{
+		predicateDeclarations.emplace_back(predicate.declaration);
 	}
 
-	template <class... Arguments>
-	static OperationResult visit(ast::Predicate &, Arguments &&...)
+	// Ignore all other types of expressions
+	template<class T>
+	static void accept(T &, ast::Formula &, std::vector<const ast::PredicateDeclaration *> &)
 	{
-		return OperationResult::Unchanged;
 	}
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct CheckIfDefinitionFalseFunctor
+// Returns the biconditional of a completed definition, or nullptr if the formula isn’t one
+ast::Biconditional *completedDefinition(ast::Formula &completedFormula)
 {
-	OperationResult operator()(ast::VariableDeclaration &variableDeclaration,
-		ast::Formula &, ast::Formula &definition, VariableDomainMap &variableDomainMap)
-	{
-		if (variableDeclaration.domain != Domain::Unknown)
-			return OperationResult::Unchanged;
+	if (!completedFormula.is<ast::ForAll>())
+		return nullptr;
 
-		clearVariableDomainMap(variableDomainMap);
+	auto &forAll = completedFormula.get<ast::ForAll>();
 
-		// As a hypothesis, make the parameter symbolic
-		variableDomainMap[&variableDeclaration] = Domain::Symbolic;
+	if (!forAll.argument.is<ast::Biconditional>())
+		return nullptr;
 
-		const auto result = evaluate(definition, variableDomainMap);
+	auto &biconditional = forAll.argument.get<ast::Biconditional>();
 
-		if (result == EvaluationResult::Error || result == EvaluationResult::False)
-		{
-			// If making the variable symbolic leads to a false or erroneous result, it’s proven to be integer
-			variableDeclaration.domain = Domain::Integer;
-			return OperationResult::Changed;
-		}
+	if (!biconditional.left.is<ast::Predicate>())
+		return nullptr;
 
-		return OperationResult::Unchanged;
-	}
-};
+	return &biconditional;
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-struct CheckIfQuantifiedFormulaFalseFunctor
+// Assumes the completed formulas to be in translated but not simplified form.
+// That is, completed formulas are either variable-free or universally quantified
+void detectIntegerVariables(std::vector<ast::Formula> &completedFormulas)
 {
-	OperationResult operator()(ast::VariableDeclaration &variableDeclaration,
-		ast::Formula &quantifiedFormula, VariableDomainMap &variableDomainMap)
+	// The results for a formula only change if its own variables or the parameters of the predicates it
+	// mentions turn out to be integer, so only the formulas affected by a change are checked again
+	std::unordered_map<const ast::PredicateDeclaration *, std::vector<size_t>> occurrences;
+
+	for (size_t i = 0; i < completedFormulas.size(); i++)
 	{
-		if (variableDeclaration.domain != Domain::Unknown)
-			return OperationResult::Unchanged;
+		std::vector<const ast::PredicateDeclaration *> predicateDeclarations;
+		completedFormulas[i].accept(CollectPredicateOccurrencesVisitor(), completedFormulas[i], predicateDeclarations);
 
-		clearVariableDomainMap(variableDomainMap);
+		for (const auto *predicateDeclaration : predicateDeclarations)
+		{
+			auto &predicateOccurrences = occurrences[predicateDeclaration];
+
+			if (predicateOccurrences.empty() || predicateOccurrences.back() != i)
+				predicateOccurrences.push_back(i);
+		}
+	}
 
-		// As a hypothesis, make the parameter symbolic
-		variableDomainMap[&variableDeclaration] = Domain::Symbolic;
+	std::deque<size_t> worklist;
+	std::vector<bool> isQueued(completedFormulas.size(), true);
 
-		const auto result = evaluate(quantifiedFormula, variableDomainMap);
+	for (size_t i = 0; i < completedFormulas.size(); i++)
+		worklist.push_back(i);
 
-		if (result == EvaluationResult::Error || result == EvaluationResult::False)
+	const auto enqueue =
+		[&](size_t i)
 		{
-			// If making the variable symbolic leads to a false or erroneous result, it’s proven to be integer
-			variableDeclaration.domain = Domain::Integer;
-			return OperationResult::Changed;
-		}
+			if (isQueued[i])
+				return;
 
-		return OperationResult::Unchanged;
-	}
-};
+			isQueued[i] = true;
+			worklist.push_back(i);
+		};
 
-////////////////////////////////////////////////////////////////////////////////////////////////////
+	Hypotheses hypotheses;
 
-struct CheckIfCompletedFormulaTrueFunctor
-{
-	OperationResult operator()(ast::VariableDeclaration &variableDeclaration,
-		ast::Formula &, ast::Formula &completedFormula, VariableDomainMap &variableDomainMap)
+	while (!worklist.empty())
 	{
-		if (variableDeclaration.domain != Domain::Unknown)
-			return OperationResult::Unchanged;
+		const auto i = worklist.front();
+		worklist.pop_front();
+		isQueued[i] = false;
 
-		clearVariableDomainMap(variableDomainMap);
+		auto &completedFormula = completedFormulas[i];
+		auto operationResult = OperationResult::Unchanged;
 
-		// As a hypothesis, make the parameter symbolic
-		variableDomainMap[&variableDeclaration] = Domain::Symbolic;
+		completedFormula.accept(CheckIfQuantifiedFormulasFalseVisitor(), completedFormula, hypotheses, operationResult);
 
-		const auto result = evaluate(completedFormula, variableDomainMap);
+		std::vector<ast::VariableDeclaration *> variableDeclarations;
+		completedFormula.accept(CollectUnknownVariablesVisitor(), completedFormula, variableDeclarations);
 
-		if (result == EvaluationResult::Error || result == EvaluationResult::True)
-		{
-			// If making the variable symbolic leads to a false or erroneous result, it’s proven to be integer
-			variableDeclaration.domain = Domain::Integer;
-			return OperationResult::Changed;
-		}
+		// If making a variable symbolic renders the completed formula true, the variable is integer
+		if (checkHypotheses(variableDeclarations, completedFormula, EvaluationResult::True, hypotheses) == OperationResult::Changed)
+			operationResult = OperationResult::Changed;
 
-		return OperationResult::Unchanged;
-	}
-};
+		auto *biconditional = completedDefinition(completedFormula);
 
-////////////////////////////////////////////////////////////////////////////////////////////////////
+		// If making a variable symbolic renders the definition false, the variable is integer
+		if (biconditional && checkHypotheses(variableDeclarations, biconditional->right, EvaluationResult::False, hypotheses) == OperationResult::Changed)
+			operationResult = OperationResult::Changed;
 
-// Assumes the completed formulas to be in translated but not simplified form.
-// That is, completed formulas are either variable-free or universally quantified
-void detectIntegerVariables(std::vector<ast::Formula> &completedFormulas)
-{
-	VariableDomainMap variableDomainMap;
-	auto operationResult = OperationResult::Changed;
+		// Further variables may turn out to be integer based on the ones just detected
+		if (operationResult == OperationResult::Changed)
+			enqueue(i);
 
-	while (operationResult == OperationResult::Changed)
-	{
-		operationResult = OperationResult::Unchanged;
+		if (!biconditional)
+			continue;
 
-		for (auto &completedFormula : completedFormulas)
-		{
-			if (completedFormula.accept(ForEachVariableDeclarationVisitor<CheckIfQuantifiedFormulaFalseFunctor>(), variableDomainMap) == OperationResult::Changed)
-				operationResult = OperationResult::Changed;
+		auto &predicate = biconditional->left.get<ast::Predicate>();
 
-			if (completedFormula.accept(ForEachVariableDeclarationVisitor<CheckIfCompletedFormulaTrueFunctor>(), completedFormula, variableDomainMap) == OperationResult::Changed)
-				operationResult = OperationResult::Changed;
+		assert(predicate.arguments.size() == predicate.declaration->arity());
 
-			if (!completedFormula.is<ast::ForAll>())
-				continue;
+		bool areParametersChanged = false;
 
-			auto &forAll = completedFormula.get<ast::ForAll>();
+		for (size_t j = 0; j < predicate.arguments.size(); j++)
+		{
+			auto &variableArgument = predicate.arguments[j];
+			auto &parameter = predicate.declaration->parameters[j];
 
-			if (!forAll.argument.is<ast::Biconditional>())
-				continue;
+			assert(variableArgument.is<ast::Variable>());
 
-			auto &biconditional = forAll.argument.get<ast::Biconditional>();
+			auto &variable = variableArgument.get<ast::Variable>();
 
-			if (!biconditional.left.is<ast::Predicate>())
+			if (parameter.domain == variable.declaration->domain)
 				continue;
 
-			auto &predicate = biconditional.left.get<ast::Predicate>();
-			auto &definition = biconditional.right;
-
-			if (completedFormula.accept(ForEachVariableDeclarationVisitor<CheckIfDefinitionFalseFunctor>(), definition, variableDomainMap) == OperationResult::Changed)
-				operationResult = OperationResult::Changed;
-
-			assert(predicate.arguments.size() == predicate.declaration->arity());
-
-			for (size_t i = 0; i < predicate.arguments.size(); i++)
-			{
-				auto &variableArgument = predicate.arguments[i];
-				auto &parameter = predicate.declaration->parameters[i];
+			parameter.domain = variable.declaration->domain;
+			areParametersChanged = true;
+		}
 
-				assert(variableArgument.is<ast::Variable>());
+		if (!areParametersChanged)
+			continue;
 
-				auto &variable = variableArgument.get<ast::Variable>();
+		const auto predicateOccurrences = occurrences.find(predicate.declaration);
 
-				parameter.domain = variable.declaration->domain;
-			}
-		}
+		if (predicateOccurrences != occurrences.end())
+			for (const auto j : predicateOccurrences->second)
+				enqueue(j);
 	}
 }
 
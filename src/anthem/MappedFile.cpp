@@ -0,0 +1,79 @@
+#include <anthem/MappedFile.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// MappedFile
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MappedFile::MappedFile(const char *fileName)
+{
+	const auto fileDescriptor = open(fileName, O_RDONLY);
+
+	if (fileDescriptor < 0)
+		return;
+
+	struct stat fileStatus;
+
+	if (fstat(fileDescriptor, &fileStatus) != 0 || !S_ISREG(fileStatus.st_mode) || fileStatus.st_size == 0)
+	{
+		close(fileDescriptor);
+		return;
+	}
+
+	const auto size = static_cast<size_t>(fileStatus.st_size);
+	const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+	// The bytes following the end of the file up to the next page boundary read as zero. If the file
+	// ends exactly at a page boundary, an additional zero page is reserved to terminate the string
+	const auto mappingSize = (size / pageSize + 1) * pageSize;
+
+	auto *mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if (mapping == MAP_FAILED)
+	{
+		close(fileDescriptor);
+		return;
+	}
+
+	auto *fileMapping = mmap(mapping, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fileDescriptor, 0);
+
+	// Files whose size changed in the meantime are left unmapped, as the mapping wouldn’t match them
+	struct stat mappedFileStatus;
+	const auto isFileUnchanged = (fstat(fileDescriptor, &mappedFileStatus) == 0
+		&& mappedFileStatus.st_size == fileStatus.st_size);
+
+	close(fileDescriptor);
+
+	if (fileMapping == MAP_FAILED || !isFileUnchanged)
+	{
+		munmap(mapping, mappingSize);
+		return;
+	}
+
+	madvise(fileMapping, size, MADV_SEQUENTIAL);
+
+	m_data = static_cast<const char *>(fileMapping);
+	m_size = size;
+	m_mappingSize = mappingSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+MappedFile::~MappedFile()
+{
+	if (m_data)
+		munmap(const_cast<char *>(m_data), m_mappingSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
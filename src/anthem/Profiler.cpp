@@ -0,0 +1,193 @@
+#include <anthem/Profiler.h>
+
+#include <atomic>
+
+#include <anthem/AST.h>
+#include <anthem/ASTUtils.h>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Profiler
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Numbers threads consecutively in the order in which they first record an event
+size_t currentThreadID()
+{
+	static std::atomic<size_t> nextThreadID{1};
+	thread_local const size_t threadID = nextThreadID++;
+
+	return threadID;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Escapes quotes, backslashes, and all control characters, as required in JSON strings
+void writeEscaped(std::ostream &stream, const std::string &string)
+{
+	constexpr const char *HexadecimalDigits = "0123456789abcdef";
+
+	for (const auto character : string)
+		switch (character)
+		{
+			case '"':
+				stream << "\\\"";
+				break;
+			case '\\':
+				stream << "\\\\";
+				break;
+			case '\b':
+				stream << "\\b";
+				break;
+			case '\f':
+				stream << "\\f";
+				break;
+			case '\n':
+				stream << "\\n";
+				break;
+			case '\r':
+				stream << "\\r";
+				break;
+			case '\t':
+				stream << "\\t";
+				break;
+			default:
+				if (static_cast<unsigned char>(character) < 0x20)
+					stream << "\\u00" << HexadecimalDigits[character >> 4] << HexadecimalDigits[character & 0xf];
+				else
+					stream << character;
+		}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Profiler::Span::Span(Profiler *profiler, std::string &&name)
+:	m_profiler{profiler},
+	m_name{std::move(name)}
+{
+	if (m_profiler)
+		m_startTime = Clock::now();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Profiler::Span::~Span()
+{
+	if (m_profiler)
+		m_profiler->recordSpan(std::move(m_name), m_startTime, Clock::now());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Profiler::Profiler(bool recordDetails)
+:	m_recordDetails{recordDetails},
+	m_startTime{Clock::now()}
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Profiler *Profiler::details(Profiler *profiler)
+{
+	if (!profiler || !profiler->m_recordDetails)
+		return nullptr;
+
+	return profiler;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Profiler::recordSpan(std::string &&name, Clock::time_point startTime, Clock::time_point endTime)
+{
+	const auto threadID = currentThreadID();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_events.emplace_back(Event{std::move(name), 'X', threadID, startTime, endTime - startTime, 0});
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Profiler::recordCounter(const char *name, size_t value)
+{
+	const auto threadID = currentThreadID();
+	const auto time = Clock::now();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_events.emplace_back(Event{name, 'C', threadID, time, Clock::duration::zero(), value});
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Profiler::write(std::ostream &stream) const
+{
+	const auto toMicroseconds =
+		[](const auto &duration)
+		{
+			return std::chrono::duration<double, std::micro>(duration).count();
+		};
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	stream << "{\"traceEvents\": [";
+
+	for (size_t i = 0; i < m_events.size(); i++)
+	{
+		const auto &event = m_events[i];
+
+		if (i > 0)
+			stream << ",";
+
+		stream << "\n  {\"name\": \"";
+		writeEscaped(stream, event.name);
+		stream
+			<< "\", \"ph\": \"" << event.phase << "\""
+			<< ", \"pid\": 1, \"tid\": " << event.threadID
+			<< ", \"ts\": " << toMicroseconds(event.time - m_startTime);
+
+		if (event.phase == 'X')
+			stream << ", \"dur\": " << toMicroseconds(event.duration);
+		else if (event.phase == 'C')
+			stream << ", \"args\": {\"value\": " << event.value << "}";
+
+		stream << "}";
+	}
+
+	stream << "\n], \"displayTimeUnit\": \"ms\"}" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template<class FormulaAccessor>
+void recordNumberOfNodes(Profiler *profiler, size_t numberOfFormulas, const FormulaAccessor &formulaAt)
+{
+	if (!profiler)
+		return;
+
+	size_t numberOfNodes = 0;
+
+	for (size_t i = 0; i < numberOfFormulas; i++)
+		numberOfNodes += ast::countNodes(formulaAt(i));
+
+	profiler->recordCounter("AST nodes", numberOfNodes);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void recordNumberOfNodes(Profiler *profiler, std::vector<ast::Formula> &formulas)
+{
+	recordNumberOfNodes(profiler, formulas.size(), [&](size_t i) -> ast::Formula &{return formulas[i];});
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void recordNumberOfNodes(Profiler *profiler, std::vector<ast::ScopedFormula> &scopedFormulas)
+{
+	recordNumberOfNodes(profiler, scopedFormulas.size(), [&](size_t i) -> ast::Formula &{return scopedFormulas[i].formula;});
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
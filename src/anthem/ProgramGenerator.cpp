@@ -0,0 +1,219 @@
+#include <anthem/ProgramGenerator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <anthem/Exception.h>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// ProgramGenerator
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The standard distributions differ between implementations, so random numbers are derived from the
+// engine’s output directly to generate the same programs everywhere
+class RandomNumbers
+{
+	public:
+		explicit RandomNumbers(uint32_t seed)
+		:	m_engine{seed}
+		{
+		}
+
+		// Returns a number from 0 to the bound (exclusive)
+		size_t below(size_t bound)
+		{
+			return static_cast<size_t>(m_engine() % bound);
+		}
+
+		bool withProbability(double probability)
+		{
+			return m_engine() < probability * (static_cast<double>(std::mt19937::max()) + 1.0);
+		}
+
+	private:
+		std::mt19937 m_engine;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t share(double density, size_t number)
+{
+	return static_cast<size_t>(std::lround(std::clamp(density, 0.0, 1.0) * number));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void printPredicateName(std::ostream &stream, size_t index)
+{
+	stream << "p" << (index + 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::string generateProgram(const ProgramGeneratorOptions &options)
+{
+	if (options.numberOfPredicates == 0)
+		throw LogicException("programs must have at least one predicate");
+
+	RandomNumbers randomNumbers(options.seed);
+	std::stringstream program;
+
+	const auto numberOfExternalPredicates = share(options.externalDensity, options.numberOfPredicates);
+
+	const auto printArguments =
+		[&](const auto &printArgument)
+		{
+			if (options.arity == 0)
+				return;
+
+			program << "(";
+
+			for (size_t i = 0; i < options.arity; i++)
+			{
+				if (i > 0)
+					program << ", ";
+
+				printArgument(i);
+			}
+
+			program << ")";
+		};
+
+	// Returns whether a pool or an interval was printed instead of the regular argument
+	const auto printPoolOrInterval =
+		[&]()
+		{
+			if (randomNumbers.withProbability(options.poolShare))
+			{
+				program << "(" << (randomNumbers.below(5) + 1) << ";" << (randomNumbers.below(5) + 6) << ")";
+				return true;
+			}
+
+			if (randomNumbers.withProbability(options.intervalShare))
+			{
+				program << (randomNumbers.below(5) + 1) << ".." << (randomNumbers.below(5) + 6);
+				return true;
+			}
+
+			return false;
+		};
+
+	for (size_t i = 0; i < numberOfExternalPredicates; i++)
+	{
+		program << "#external ";
+		printPredicateName(program, i);
+		program << "(" << options.arity << ").\n";
+	}
+
+	for (size_t i = numberOfExternalPredicates; i < options.numberOfPredicates; i++)
+	{
+		for (size_t j = 0; j < options.rulesPerPredicate; j++)
+		{
+			const auto isChoiceRule = randomNumbers.withProbability(options.choiceRuleShare);
+			// Predicates without predecessors can only be defined by facts
+			const auto isFact = (i == 0 || options.bodyLength == 0);
+
+			if (isChoiceRule)
+				program << "{";
+
+			printPredicateName(program, i);
+			printArguments(
+				[&](size_t k)
+				{
+					if (!isFact)
+					{
+						program << "X" << (k + 1);
+						return;
+					}
+
+					if (!printPoolOrInterval())
+						program << (randomNumbers.below(10) + 1);
+				});
+
+			if (isChoiceRule)
+				program << "}";
+
+			if (isFact)
+			{
+				program << ".\n";
+				continue;
+			}
+
+			program << " :- ";
+
+			for (size_t k = 0; k < options.bodyLength; k++)
+			{
+				if (k > 0)
+					program << ", ";
+
+				// The first literal binds all head variables, the others may introduce new ones unless negated
+				const auto isNegated = (k > 0 && randomNumbers.withProbability(0.25));
+
+				if (isNegated)
+					program << "not ";
+
+				printPredicateName(program, randomNumbers.below(i));
+				printArguments(
+					[&](size_t l)
+					{
+						if (k == 0)
+						{
+							program << "X" << (l + 1);
+							return;
+						}
+
+						if (printPoolOrInterval())
+							return;
+
+						const auto isHeadVariable = (isNegated || randomNumbers.withProbability(0.5));
+						program << (isHeadVariable ? "X" : "Y") << (randomNumbers.below(options.arity) + 1);
+					});
+			}
+
+			program << ".\n";
+		}
+	}
+
+	// Show a random selection of the predicates that aren’t #external
+	const auto numberOfDefinedPredicates = options.numberOfPredicates - numberOfExternalPredicates;
+	const auto numberOfShownPredicates = share(options.showDensity, numberOfDefinedPredicates);
+
+	if (numberOfShownPredicates < numberOfDefinedPredicates)
+	{
+		std::vector<size_t> predicates(numberOfDefinedPredicates);
+
+		for (size_t i = 0; i < numberOfDefinedPredicates; i++)
+			predicates[i] = numberOfExternalPredicates + i;
+
+		// Fisher–Yates shuffle of the first predicates to show
+		for (size_t i = 0; i < numberOfShownPredicates; i++)
+			std::swap(predicates[i], predicates[i + randomNumbers.below(numberOfDefinedPredicates - i)]);
+
+		predicates.resize(numberOfShownPredicates);
+		std::sort(predicates.begin(), predicates.end());
+
+		if (predicates.empty())
+			program << "#show.\n";
+
+		for (const auto predicate : predicates)
+		{
+			program << "#show ";
+			printPredicateName(program, predicate);
+			program << "/" << options.arity << ".\n";
+		}
+	}
+
+	return program.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
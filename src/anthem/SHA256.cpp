@@ -0,0 +1,155 @@
+#include <anthem/SHA256.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// SHA256
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+constexpr std::array<uint32_t, 64> RoundConstants =
+{
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline uint32_t rotateRight(uint32_t value, unsigned int bits)
+{
+	return (value >> bits) | (value << (32 - bits));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+SHA256::SHA256()
+:	m_state{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19}
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SHA256::update(const void *data, size_t size)
+{
+	auto *bytes = static_cast<const uint8_t *>(data);
+
+	m_totalSize += size;
+
+	// Complete a partially filled block first
+	if (m_blockSize > 0)
+	{
+		const auto numberOfBytes = std::min(size, m_block.size() - m_blockSize);
+		std::memcpy(m_block.data() + m_blockSize, bytes, numberOfBytes);
+		m_blockSize += numberOfBytes;
+		bytes += numberOfBytes;
+		size -= numberOfBytes;
+
+		if (m_blockSize < m_block.size())
+			return;
+
+		processBlock(m_block.data());
+		m_blockSize = 0;
+	}
+
+	for (; size >= m_block.size(); bytes += m_block.size(), size -= m_block.size())
+		processBlock(bytes);
+
+	std::memcpy(m_block.data(), bytes, size);
+	m_blockSize = size;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::string SHA256::hexadecimalDigest()
+{
+	const auto totalSizeInBits = m_totalSize * 8;
+
+	// Pad with a single 1 bit and zeros up to the last 8 bytes of a block, which hold the size
+	const uint8_t padding = 0x80;
+	update(&padding, 1);
+
+	const uint8_t zero = 0;
+
+	while (m_blockSize != 56)
+		update(&zero, 1);
+
+	for (int i = 7; i >= 0; i--)
+	{
+		const auto byte = static_cast<uint8_t>(totalSizeInBits >> (i * 8));
+		update(&byte, 1);
+	}
+
+	constexpr const char *HexadecimalDigits = "0123456789abcdef";
+
+	std::string digest;
+	digest.reserve(64);
+
+	for (const auto word : m_state)
+		for (int i = 28; i >= 0; i -= 4)
+			digest += HexadecimalDigits[(word >> i) & 0xf];
+
+	return digest;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void SHA256::processBlock(const uint8_t *block)
+{
+	std::array<uint32_t, 64> schedule;
+
+	for (size_t i = 0; i < 16; i++)
+		schedule[i] = (uint32_t(block[i * 4]) << 24) | (uint32_t(block[i * 4 + 1]) << 16)
+			| (uint32_t(block[i * 4 + 2]) << 8) | uint32_t(block[i * 4 + 3]);
+
+	for (size_t i = 16; i < 64; i++)
+	{
+		const auto s0 = rotateRight(schedule[i - 15], 7) ^ rotateRight(schedule[i - 15], 18) ^ (schedule[i - 15] >> 3);
+		const auto s1 = rotateRight(schedule[i - 2], 17) ^ rotateRight(schedule[i - 2], 19) ^ (schedule[i - 2] >> 10);
+		schedule[i] = schedule[i - 16] + s0 + schedule[i - 7] + s1;
+	}
+
+	auto [a, b, c, d, e, f, g, h] = m_state;
+
+	for (size_t i = 0; i < 64; i++)
+	{
+		const auto s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+		const auto choice = (e & f) ^ (~e & g);
+		const auto temporary1 = h + s1 + choice + RoundConstants[i] + schedule[i];
+		const auto s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+		const auto majority = (a & b) ^ (a & c) ^ (b & c);
+		const auto temporary2 = s0 + majority;
+
+		h = g;
+		g = f;
+		f = e;
+		e = d + temporary1;
+		d = c;
+		c = b;
+		b = a;
+		a = temporary1 + temporary2;
+	}
+
+	m_state[0] += a;
+	m_state[1] += b;
+	m_state[2] += c;
+	m_state[3] += d;
+	m_state[4] += e;
+	m_state[5] += f;
+	m_state[6] += g;
+	m_state[7] += h;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,848 @@
+#include <anthem/Server.h>
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <anthem/Exception.h>
+#include <anthem/StatementCache.h>
+#include <anthem/Translation.h>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Server
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// A JSON value, restricted to what requests consist of
+struct JSONValue
+{
+	enum class Type
+	{
+		Null,
+		Boolean,
+		Number,
+		String,
+		Array,
+		Object
+	};
+
+	Type type = Type::Null;
+	bool boolean = false;
+	// The contents of strings and the literal text of numbers
+	std::string text;
+	std::vector<JSONValue> elements;
+	std::vector<std::pair<std::string, JSONValue>> members;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class JSONParser
+{
+	public:
+		// Requests are flat, so deeper nesting is only a way to exhaust the stack
+		static constexpr size_t MaximumNestingDepth = 64;
+
+		explicit JSONParser(const std::string &text)
+		:	m_text{text}
+		{
+		}
+
+		JSONValue parse()
+		{
+			auto value = parseValue();
+
+			skipWhiteSpace();
+
+			if (m_position != m_text.size())
+				throw LogicException("malformed request: unexpected text after the request object");
+
+			return value;
+		}
+
+	private:
+		void skipWhiteSpace()
+		{
+			while (m_position < m_text.size() && std::strchr(" \t\r\n", m_text[m_position]) != nullptr)
+				m_position++;
+		}
+
+		char peek()
+		{
+			skipWhiteSpace();
+
+			if (m_position == m_text.size())
+				throw LogicException("malformed request: unexpected end of request");
+
+			return m_text[m_position];
+		}
+
+		void expect(char character)
+		{
+			if (peek() != character)
+				throw LogicException(std::string("malformed request: expected “") + character + "” at position "
+					+ std::to_string(m_position + 1));
+
+			m_position++;
+		}
+
+		bool parseKeyword(const char *keyword)
+		{
+			const auto length = std::strlen(keyword);
+
+			if (m_text.compare(m_position, length, keyword) != 0)
+				return false;
+
+			m_position += length;
+			return true;
+		}
+
+		bool parseDigits()
+		{
+			const auto start = m_position;
+
+			while (m_position < m_text.size() && m_text[m_position] >= '0' && m_text[m_position] <= '9')
+				m_position++;
+
+			return m_position > start;
+		}
+
+		// Numbers are echoed verbatim in replies, so they must follow the grammar of RFC 8259 exactly
+		std::string parseNumber()
+		{
+			const auto start = m_position;
+
+			const auto invalidNumber =
+				[&]()
+				{
+					return LogicException("malformed request: invalid number at position " + std::to_string(start + 1));
+				};
+
+			if (m_text[m_position] == '-')
+				m_position++;
+
+			if (m_position < m_text.size() && m_text[m_position] == '0')
+			{
+				m_position++;
+
+				// No leading zeros
+				if (parseDigits())
+					throw invalidNumber();
+			}
+			else if (m_position == m_text.size() || m_text[m_position] < '1' || m_text[m_position] > '9' || !parseDigits())
+				throw invalidNumber();
+
+			if (m_position < m_text.size() && m_text[m_position] == '.')
+			{
+				m_position++;
+
+				if (!parseDigits())
+					throw invalidNumber();
+			}
+
+			if (m_position < m_text.size() && (m_text[m_position] == 'e' || m_text[m_position] == 'E'))
+			{
+				m_position++;
+
+				if (m_position < m_text.size() && (m_text[m_position] == '+' || m_text[m_position] == '-'))
+					m_position++;
+
+				if (!parseDigits())
+					throw invalidNumber();
+			}
+
+			return m_text.substr(start, m_position - start);
+		}
+
+		void enterNestedValue()
+		{
+			if (m_depth == MaximumNestingDepth)
+				throw LogicException("malformed request: values nested more than "
+					+ std::to_string(MaximumNestingDepth) + " levels deep");
+
+			m_depth++;
+		}
+
+		JSONValue parseValue()
+		{
+			JSONValue value;
+
+			const auto character = peek();
+
+			if (character == '{')
+			{
+				value.type = JSONValue::Type::Object;
+				enterNestedValue();
+				m_position++;
+
+				if (peek() == '}')
+				{
+					m_depth--;
+					m_position++;
+					return value;
+				}
+
+				while (true)
+				{
+					auto name = parseString();
+					expect(':');
+					value.members.emplace_back(std::move(name), parseValue());
+
+					if (peek() == '}')
+						break;
+
+					expect(',');
+				}
+
+				m_depth--;
+				m_position++;
+			}
+			else if (character == '[')
+			{
+				value.type = JSONValue::Type::Array;
+				enterNestedValue();
+				m_position++;
+
+				if (peek() == ']')
+				{
+					m_depth--;
+					m_position++;
+					return value;
+				}
+
+				while (true)
+				{
+					value.elements.emplace_back(parseValue());
+
+					if (peek() == ']')
+						break;
+
+					expect(',');
+				}
+
+				m_depth--;
+				m_position++;
+			}
+			else if (character == '"')
+			{
+				value.type = JSONValue::Type::String;
+				value.text = parseString();
+			}
+			else if (character == '-' || (character >= '0' && character <= '9'))
+			{
+				value.type = JSONValue::Type::Number;
+				value.text = parseNumber();
+			}
+			else if (parseKeyword("true"))
+			{
+				value.type = JSONValue::Type::Boolean;
+				value.boolean = true;
+			}
+			else if (parseKeyword("false"))
+				value.type = JSONValue::Type::Boolean;
+			else if (!parseKeyword("null"))
+				throw LogicException("malformed request: unexpected character at position " + std::to_string(m_position + 1));
+
+			return value;
+		}
+
+		unsigned int parseHexadecimalDigits()
+		{
+			if (m_text.size() - m_position < 4)
+				throw LogicException("malformed request: incomplete unicode escape sequence");
+
+			unsigned int codePoint = 0;
+
+			for (size_t i = 0; i < 4; i++)
+			{
+				const auto digit = m_text[m_position++];
+
+				codePoint <<= 4;
+
+				if (digit >= '0' && digit <= '9')
+					codePoint |= digit - '0';
+				else if (digit >= 'a' && digit <= 'f')
+					codePoint |= digit - 'a' + 10;
+				else if (digit >= 'A' && digit <= 'F')
+					codePoint |= digit - 'A' + 10;
+				else
+					throw LogicException("malformed request: invalid unicode escape sequence");
+			}
+
+			return codePoint;
+		}
+
+		void appendUTF8(std::string &string, unsigned int codePoint)
+		{
+			if (codePoint < 0x80)
+				string += static_cast<char>(codePoint);
+			else if (codePoint < 0x800)
+			{
+				string += static_cast<char>(0xc0 | (codePoint >> 6));
+				string += static_cast<char>(0x80 | (codePoint & 0x3f));
+			}
+			else if (codePoint < 0x10000)
+			{
+				string += static_cast<char>(0xe0 | (codePoint >> 12));
+				string += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+				string += static_cast<char>(0x80 | (codePoint & 0x3f));
+			}
+			else
+			{
+				string += static_cast<char>(0xf0 | (codePoint >> 18));
+				string += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f));
+				string += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+				string += static_cast<char>(0x80 | (codePoint & 0x3f));
+			}
+		}
+
+		std::string parseString()
+		{
+			expect('"');
+
+			std::string string;
+
+			while (true)
+			{
+				if (m_position == m_text.size())
+					throw LogicException("malformed request: unterminated string");
+
+				const auto character = m_text[m_position++];
+
+				if (character == '"')
+					return string;
+
+				if (character != '\\')
+				{
+					string += character;
+					continue;
+				}
+
+				if (m_position == m_text.size())
+					throw LogicException("malformed request: unterminated string");
+
+				switch (m_text[m_position++])
+				{
+					case '"':
+						string += '"';
+						break;
+					case '\\':
+						string += '\\';
+						break;
+					case '/':
+						string += '/';
+						break;
+					case 'b':
+						string += '\b';
+						break;
+					case 'f':
+						string += '\f';
+						break;
+					case 'n':
+						string += '\n';
+						break;
+					case 'r':
+						string += '\r';
+						break;
+					case 't':
+						string += '\t';
+						break;
+					case 'u':
+					{
+						auto codePoint = parseHexadecimalDigits();
+
+						// Characters outside the basic multilingual plane are escaped as surrogate pairs, and
+						// surrogates on their own don’t encode any character
+						if (codePoint >= 0xdc00 && codePoint < 0xe000)
+							throw LogicException("malformed request: unpaired surrogate in unicode escape sequence");
+
+						if (codePoint >= 0xd800 && codePoint < 0xdc00)
+						{
+							if (m_text.compare(m_position, 2, "\\u") != 0)
+								throw LogicException("malformed request: unpaired surrogate in unicode escape sequence");
+
+							m_position += 2;
+							const auto lowSurrogate = parseHexadecimalDigits();
+
+							if (lowSurrogate < 0xdc00 || lowSurrogate >= 0xe000)
+								throw LogicException("malformed request: unpaired surrogate in unicode escape sequence");
+
+							codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (lowSurrogate - 0xdc00);
+						}
+
+						appendUTF8(string, codePoint);
+						break;
+					}
+					default:
+						throw LogicException("malformed request: invalid escape sequence");
+				}
+			}
+		}
+
+		const std::string &m_text;
+		size_t m_position{0};
+		size_t m_depth{0};
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Returns the length of the well-formed UTF-8 sequence at the given position, or 0 if there is none.
+// Overlong encodings, surrogates, and code points beyond U+10FFFF are not well-formed
+size_t utf8SequenceLength(const std::string &string, size_t position)
+{
+	const auto byte =
+		[&](size_t offset) -> unsigned int
+		{
+			return (position + offset < string.size()) ? static_cast<unsigned char>(string[position + offset]) : 0;
+		};
+
+	const auto isContinuationByte =
+		[&](size_t offset, unsigned int minimum = 0x80, unsigned int maximum = 0xbf)
+		{
+			return byte(offset) >= minimum && byte(offset) <= maximum;
+		};
+
+	const auto leadingByte = byte(0);
+
+	if (leadingByte >= 0xc2 && leadingByte <= 0xdf)
+		return isContinuationByte(1) ? 2 : 0;
+
+	if (leadingByte >= 0xe0 && leadingByte <= 0xef)
+	{
+		const auto minimum = (leadingByte == 0xe0) ? 0xa0 : 0x80;
+		const auto maximum = (leadingByte == 0xed) ? 0x9f : 0xbf;
+
+		return (isContinuationByte(1, minimum, maximum) && isContinuationByte(2)) ? 3 : 0;
+	}
+
+	if (leadingByte >= 0xf0 && leadingByte <= 0xf4)
+	{
+		const auto minimum = (leadingByte == 0xf0) ? 0x90 : 0x80;
+		const auto maximum = (leadingByte == 0xf4) ? 0x8f : 0xbf;
+
+		return (isContinuationByte(1, minimum, maximum) && isContinuationByte(2) && isContinuationByte(3)) ? 4 : 0;
+	}
+
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Bytes that are not part of well-formed UTF-8 (such as from input files in other encodings) are replaced
+// with U+FFFD, as the reply would not be valid JSON otherwise
+void writeJSONString(std::ostream &stream, const std::string &string)
+{
+	constexpr const char *HexadecimalDigits = "0123456789abcdef";
+
+	stream << '"';
+
+	for (size_t position = 0; position < string.size(); position++)
+	{
+		const auto character = string[position];
+
+		if (static_cast<unsigned char>(character) >= 0x80)
+		{
+			const auto length = utf8SequenceLength(string, position);
+
+			if (length == 0)
+			{
+				stream << "\\ufffd";
+				continue;
+			}
+
+			stream.write(string.data() + position, length);
+			position += length - 1;
+			continue;
+		}
+
+		switch (character)
+		{
+			case '"':
+				stream << "\\\"";
+				break;
+			case '\\':
+				stream << "\\\\";
+				break;
+			case '\n':
+				stream << "\\n";
+				break;
+			case '\r':
+				stream << "\\r";
+				break;
+			case '\t':
+				stream << "\\t";
+				break;
+			default:
+				if (static_cast<unsigned char>(character) < 0x20)
+					stream << "\\u00" << HexadecimalDigits[character >> 4] << HexadecimalDigits[character & 0xf];
+				else
+					stream << character;
+		}
+	}
+
+	stream << '"';
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const std::string &stringOption(const std::string &name, const JSONValue &value)
+{
+	if (value.type != JSONValue::Type::String)
+		throw LogicException("option “" + name + "” must be a string");
+
+	return value.text;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool booleanOption(const std::string &name, const JSONValue &value)
+{
+	if (value.type != JSONValue::Type::Boolean)
+		throw LogicException("option “" + name + "” must be a Boolean value");
+
+	return value.boolean;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Applies the options of a request to the context and extracts the programs to translate
+std::vector<ProgramText> readRequest(const JSONValue &request, Context &context)
+{
+	std::vector<ProgramText> programs;
+
+	for (const auto &[name, value] : request.members)
+	{
+		if (name == "id")
+			continue;
+		else if (name == "program")
+			programs.push_back({"<program>", stringOption(name, value)});
+		else if (name == "programs")
+		{
+			if (value.type != JSONValue::Type::Array)
+				throw LogicException("option “programs” must be an array of strings");
+
+			for (const auto &element : value.elements)
+				programs.push_back({"<program " + std::to_string(programs.size() + 1) + ">", stringOption(name, element)});
+		}
+		else if (name == "mode")
+		{
+			const auto &mode = stringOption(name, value);
+
+			if (mode == "here-and-there")
+				context.translationMode = TranslationMode::HereAndThere;
+			else if (mode == "completion")
+				context.translationMode = TranslationMode::Completion;
+			else
+				throw LogicException("unknown head mode “" + mode + "”");
+		}
+		else if (name == "output-format")
+		{
+			const auto &outputFormat = stringOption(name, value);
+
+			if (outputFormat == "human-readable")
+				context.outputFormat = OutputFormat::HumanReadable;
+			else if (outputFormat == "tptp")
+				context.outputFormat = OutputFormat::TPTP;
+			else
+				throw LogicException("unknown output format “" + outputFormat + "”");
+		}
+		else if (name == "map-to-integers")
+		{
+			const auto &mapToIntegersPolicy = stringOption(name, value);
+
+			if (mapToIntegersPolicy == "auto")
+				context.mapToIntegersPolicy = MapToIntegersPolicy::Auto;
+			else if (mapToIntegersPolicy == "always")
+				context.mapToIntegersPolicy = MapToIntegersPolicy::Always;
+			else
+				throw LogicException("unknown map-to-integers policy “" + mapToIntegersPolicy + "”");
+		}
+		else if (name == "parentheses")
+		{
+			const auto &parenthesisStyle = stringOption(name, value);
+
+			if (parenthesisStyle == "normal")
+				context.parenthesisStyle = output::ParenthesisStyle::Normal;
+			else if (parenthesisStyle == "full")
+				context.parenthesisStyle = output::ParenthesisStyle::Full;
+			else
+				throw LogicException("unknown parenthesis style “" + parenthesisStyle + "”");
+		}
+		else if (name == "simplify")
+			context.performSimplification = booleanOption(name, value);
+		else if (name == "complete")
+			context.performCompletion = booleanOption(name, value);
+		else if (name == "detect-integers")
+			context.performIntegerDetection = booleanOption(name, value);
+		else if (name == "log-priority")
+			context.logger.setLogPriority(output::priorityFromName(stringOption(name, value).c_str()));
+		else
+			throw LogicException("unknown option “" + name + "”");
+	}
+
+	return programs;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Server::Server(Context &context)
+:	m_context{context},
+	m_statementCache{std::make_shared<StatementCache>()}
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::string Server::handleRequest(const std::string &request)
+{
+	m_output.str(std::string());
+	m_output.clear();
+	m_diagnostics.str(std::string());
+	m_diagnostics.clear();
+
+	// Nothing carries over from one request to the next except for the memory of the arena and the
+	// translations of statements, which don’t depend on the context they are translated in
+	Context requestContext{output::Logger(output::ColorStream(m_output), output::ColorStream(m_diagnostics))};
+	requestContext.logger.setColorPolicy(output::ColorStream::ColorPolicy::Never);
+	requestContext.logger.setLogPriority(m_context.logger.logPriority());
+	requestContext.copyOptions(m_context);
+	requestContext.statementCache = m_statementCache;
+	requestContext.arena.reclaim(m_spareArena);
+
+	const auto numberOfStatements = m_statementCache->totalNumberOfStatements();
+	const auto numberOfTranslatedStatements = m_statementCache->totalNumberOfTranslatedStatements();
+
+	JSONValue id;
+	bool success = true;
+
+	try
+	{
+		const auto requestObject = JSONParser(request).parse();
+
+		if (requestObject.type != JSONValue::Type::Object)
+			throw LogicException("malformed request: expected an object");
+
+		for (const auto &member : requestObject.members)
+			if (member.first == "id")
+				id = member.second;
+
+		const auto programs = readRequest(requestObject, requestContext);
+
+		translate(programs, requestContext);
+
+		if (requestContext.collectStatistics)
+			requestContext.statistics.print(requestContext.logger.errorStream());
+	}
+	catch (const std::exception &exception)
+	{
+		requestContext.logger.log(output::Priority::Error) << exception.what();
+		success = false;
+	}
+
+	requestContext.logger.outputStream().flush();
+
+	// How many statements were reused depends on the previous requests, so it isn’t part of the reply
+	const auto numberOfRequestStatements = m_statementCache->totalNumberOfStatements() - numberOfStatements;
+	const auto numberOfReusedStatements = numberOfRequestStatements
+		- (m_statementCache->totalNumberOfTranslatedStatements() - numberOfTranslatedStatements);
+
+	m_context.logger.log(output::Priority::Info) << "reused the translations of " << numberOfReusedStatements
+		<< " of " << numberOfRequestStatements << " statements";
+
+	// All AST nodes of the request are destroyed at this point. Only as much memory as the request’s own
+	// arena used is kept, as the arenas of worker threads start empty with every request
+	requestContext.arena.trim(0);
+	const auto retainedCapacity = requestContext.arena.capacity();
+
+	m_spareArena.reclaim(requestContext.arena);
+
+	for (auto &adoptedArena : requestContext.adoptedArenas)
+		m_spareArena.reclaim(*adoptedArena);
+
+	m_spareArena.trim(retainedCapacity);
+
+	std::stringstream reply;
+	reply << "{\"id\": ";
+
+	switch (id.type)
+	{
+		case JSONValue::Type::Number:
+			reply << id.text;
+			break;
+		case JSONValue::Type::String:
+			writeJSONString(reply, id.text);
+			break;
+		default:
+			reply << "null";
+			break;
+	}
+
+	reply << ", \"success\": " << (success ? "true" : "false") << ", \"output\": ";
+	writeJSONString(reply, m_output.str());
+	reply << ", \"diagnostics\": ";
+	writeJSONString(reply, m_diagnostics.str());
+	reply << "}";
+
+	return reply.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Server::serve(std::istream &requests, std::ostream &replies)
+{
+	std::string request;
+
+	while (std::getline(requests, request))
+	{
+		if (request.find_first_not_of(" \t\r") == std::string::npos)
+			continue;
+
+		replies << handleRequest(request) << "\n";
+		replies.flush();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Stream buffer reading from and writing to a connected socket
+class SocketBuffer : public std::streambuf
+{
+	public:
+		explicit SocketBuffer(int socket)
+		:	m_socket{socket}
+		{
+			setg(m_inputBuffer, m_inputBuffer, m_inputBuffer);
+			setp(m_outputBuffer, m_outputBuffer + sizeof(m_outputBuffer));
+		}
+
+	protected:
+		int_type underflow() override
+		{
+			ssize_t size;
+
+			do
+				size = recv(m_socket, m_inputBuffer, sizeof(m_inputBuffer), 0);
+			while (size < 0 && errno == EINTR);
+
+			if (size <= 0)
+				return traits_type::eof();
+
+			setg(m_inputBuffer, m_inputBuffer, m_inputBuffer + size);
+
+			return traits_type::to_int_type(*gptr());
+		}
+
+		int_type overflow(int_type character) override
+		{
+			if (sync() != 0)
+				return traits_type::eof();
+
+			if (!traits_type::eq_int_type(character, traits_type::eof()))
+			{
+				*pptr() = traits_type::to_char_type(character);
+				pbump(1);
+			}
+
+			return traits_type::not_eof(character);
+		}
+
+		int sync() override
+		{
+			const char *data = pbase();
+
+			while (data < pptr())
+			{
+				// Closed connections must not terminate the server with SIGPIPE
+				const auto size = send(m_socket, data, pptr() - data, MSG_NOSIGNAL);
+
+				if (size < 0 && errno == EINTR)
+					continue;
+
+				if (size <= 0)
+					return -1;
+
+				data += size;
+			}
+
+			setp(m_outputBuffer, m_outputBuffer + sizeof(m_outputBuffer));
+
+			return 0;
+		}
+
+	private:
+		int m_socket;
+		char m_inputBuffer[64 * 1024];
+		char m_outputBuffer[64 * 1024];
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Server::serveOnSocket(const std::string &socketPath)
+{
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+
+	if (socketPath.size() >= sizeof(address.sun_path))
+		throw LogicException("socket path “" + socketPath + "” is too long");
+
+	std::strcpy(address.sun_path, socketPath.c_str());
+
+	// Remove sockets left behind by previous servers, but nothing else
+	struct stat fileStatus;
+
+	if (stat(socketPath.c_str(), &fileStatus) == 0 && S_ISSOCK(fileStatus.st_mode))
+		unlink(socketPath.c_str());
+
+	const auto listeningSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if (listeningSocket < 0)
+		throw LogicException("could not create socket: " + std::string(std::strerror(errno)));
+
+	// The socket file gets permissions derived from the umask, so they are restricted to the owner before
+	// listening, as nobody can connect earlier than that
+	if (bind(listeningSocket, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0
+		|| chmod(socketPath.c_str(), S_IRUSR | S_IWUSR) != 0
+		|| listen(listeningSocket, SOMAXCONN) != 0)
+	{
+		const auto error = errno;
+		close(listeningSocket);
+		throw LogicException("could not listen on socket “" + socketPath + "”: " + std::strerror(error));
+	}
+
+	m_context.logger.log(output::Priority::Info) << "listening on socket " << socketPath;
+
+	while (true)
+	{
+		const auto connection = accept(listeningSocket, nullptr, nullptr);
+
+		if (connection < 0)
+		{
+			if (errno == EINTR || errno == ECONNABORTED)
+				continue;
+
+			const auto error = errno;
+			close(listeningSocket);
+			throw LogicException("could not accept connection: " + std::string(std::strerror(error)));
+		}
+
+		auto socketBuffer = std::make_unique<SocketBuffer>(connection);
+		std::istream requests(socketBuffer.get());
+		std::ostream replies(socketBuffer.get());
+
+		serve(requests, replies);
+
+		close(connection);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
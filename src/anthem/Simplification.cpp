@@ -2,7 +2,7 @@
 
 #include <optional>
 
-#include <anthem/ASTCopy.h>
+#include <anthem/ASTUtils.h>
 #include <anthem/Equality.h>
 #include <anthem/SimplificationVisitors.h>
 #include <anthem/Type.h>
@@ -28,8 +28,10 @@ bool matchesVariableDeclaration(const ast::Term &term, const ast::VariableDeclar
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // Extracts the term t if the given formula is of the form “X = t” and X matches the given variable
+// Both sides are matched, and t is returned, as if the given substitution was applied to the formula beforehand
 // The input formula is no longer usable after this call if a term is returned
-std::optional<ast::Term> extractAssignedTerm(ast::Formula &formula, const ast::VariableDeclaration &variableDeclaration)
+std::optional<ast::Term> extractAssignedTerm(ast::Formula &formula, const ast::VariableDeclaration &variableDeclaration,
+	const ast::VariableSubstitution &substitution)
 {
 	if (!formula.is<ast::Comparison>())
 		return std::nullopt;
@@ -39,90 +41,114 @@ std::optional<ast::Term> extractAssignedTerm(ast::Formula &formula, const ast::V
 	if (comparison.operator_ != ast::Comparison::Operator::Equal)
 		return std::nullopt;
 
-	if (matchesVariableDeclaration(comparison.left, variableDeclaration))
-		return std::move(comparison.right);
+	const auto matchesVariableDeclarationAfterSubstitution =
+		[&](const ast::Term &term)
+		{
+			if (!term.is<ast::Variable>())
+				return false;
+
+			const auto *replacement = substitution.find(*term.get<ast::Variable>().declaration);
+
+			return matchesVariableDeclaration(replacement ? *replacement : term, variableDeclaration);
+		};
+
+	std::optional<ast::Term> assignedTerm;
 
-	if (matchesVariableDeclaration(comparison.right, variableDeclaration))
-		return std::move(comparison.left);
+	if (matchesVariableDeclarationAfterSubstitution(comparison.left))
+		assignedTerm = std::move(comparison.right);
+	else if (matchesVariableDeclarationAfterSubstitution(comparison.right))
+		assignedTerm = std::move(comparison.left);
+	else
+		return std::nullopt;
+
+	substitution.apply(assignedTerm.value());
 
-	return std::nullopt;
+	return assignedTerm;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-// Replaces all occurrences of a variable in a given term with another term
-struct ReplaceVariableInTermVisitor : public ast::RecursiveTermVisitor<ReplaceVariableInTermVisitor>
+// State shared by the simplification rules while simplifying a formula
+struct SimplificationPass
 {
-	static void accept(ast::Variable &variable, ast::Term &term, const ast::VariableDeclaration &original, const ast::Term &replacement)
-	{
-		if (variable.declaration == &original)
-			// No dangling variables can result from this operation, and hence, fixing them is not necessary
-			term = ast::prepareCopy(replacement);
-	}
-
-	// Ignore all other types of expressions
-	template<class T>
-	static void accept(T &, ast::Term &, const ast::VariableDeclaration &, const ast::Term &)
-	{
-	}
+	SimplificationStatistics *statistics{nullptr};
+	// Fingerprints computed for equality checks, which are kept until the next rewrite
+	ast::FingerprintCache fingerprintCache;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-// Replaces all occurrences of a variable in a given formula with a term
-struct ReplaceVariableInFormulaVisitor : public ast::RecursiveFormulaVisitor<ReplaceVariableInFormulaVisitor>
+template<class SimplificationRule>
+OperationResult simplify(ast::Formula &formula, SimplificationPass &simplificationPass)
 {
-	static void accept(ast::Comparison &comparison, ast::Formula &, const ast::VariableDeclaration &original, const ast::Term &replacement)
-	{
-		comparison.left.accept(ReplaceVariableInTermVisitor(), comparison.left, original, replacement);
-		comparison.right.accept(ReplaceVariableInTermVisitor(), comparison.right, original, replacement);
-	}
-
-	static void accept(ast::In &in, ast::Formula &, const ast::VariableDeclaration &original, const ast::Term &term)
-	{
-		in.element.accept(ReplaceVariableInTermVisitor(), in.element, original, term);
-		in.set.accept(ReplaceVariableInTermVisitor(), in.set, original, term);
-	}
+	const auto result = SimplificationRule::apply(formula, simplificationPass);
 
-	static void accept(ast::Predicate &predicate, ast::Formula &, const ast::VariableDeclaration &original, const ast::Term &replacement)
-	{
-		for (auto &argument : predicate.arguments)
-			argument.accept(ReplaceVariableInTermVisitor(), argument, original, replacement);
-	}
+	// Rewrites may modify or destroy formulas whose fingerprints were remembered
+	if (result == OperationResult::Changed)
+		simplificationPass.fingerprintCache.clear();
 
-	// Ignore all other types of expressions
-	template<class T>
-	static void accept(T &, ast::Formula &, const ast::VariableDeclaration &, const ast::Term &)
-	{
-	}
-};
+	return result;
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-template<class SimplificationRule>
-OperationResult simplify(ast::Formula &formula)
+template<size_t RuleIndex, class SimplificationRule>
+OperationResult simplify(ast::Formula &formula, SimplificationPass &simplificationPass)
 {
-	return SimplificationRule::apply(formula);
+	auto *statistics = simplificationPass.statistics;
+
+	if (!statistics)
+		return simplify<SimplificationRule>(formula, simplificationPass);
+
+	auto &ruleStatistics = statistics->rules[RuleIndex];
+
+	const auto startTime = std::chrono::steady_clock::now();
+	const auto result = simplify<SimplificationRule>(formula, simplificationPass);
+	ruleStatistics.time += std::chrono::steady_clock::now() - startTime;
+
+	ruleStatistics.numberOfAttempts++;
+
+	if (result == OperationResult::Changed)
+		ruleStatistics.numberOfRewrites++;
+
+	return result;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-template<class FirstSimplificationRule, class SecondSimplificationRule, class... OtherSimplificationRules>
-OperationResult simplify(ast::Formula &formula)
+template<size_t RuleIndex, class FirstSimplificationRule, class SecondSimplificationRule, class... OtherSimplificationRules>
+OperationResult simplify(ast::Formula &formula, SimplificationPass &simplificationPass)
 {
-	if (simplify<FirstSimplificationRule>(formula) == OperationResult::Changed)
+	if (simplify<RuleIndex, FirstSimplificationRule>(formula, simplificationPass) == OperationResult::Changed)
 		return OperationResult::Changed;
 
-	return simplify<SecondSimplificationRule, OtherSimplificationRules...>(formula);
+	return simplify<RuleIndex + 1, SecondSimplificationRule, OtherSimplificationRules...>(formula, simplificationPass);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Tries the simplification rules in the given order until the first one succeeds
+template<class... SimplificationRules>
+struct SimplificationRuleSet
+{
+	static SimplificationStatistics makeStatistics()
+	{
+		return SimplificationStatistics{{SimplificationRuleStatistics{SimplificationRules::Description}...}};
+	}
+
+	static OperationResult apply(ast::Formula &formula, SimplificationPass &simplificationPass)
+	{
+		return simplify<0, SimplificationRules...>(formula, simplificationPass);
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 struct SimplificationRuleExistsWithoutQuantifiedVariables
 {
 	static constexpr const auto Description = "exists () (F) === F";
 
-	static OperationResult apply(ast::Formula &formula)
+	static OperationResult apply(ast::Formula &formula, SimplificationPass &)
 	{
 		if (!formula.is<ast::Exists>())
 			return OperationResult::Unchanged;
@@ -144,7 +170,7 @@ struct SimplificationRuleTrivialAssignmentInExists
 {
 	static constexpr const auto Description = "exists X (X = Y) === #true";
 
-	static OperationResult apply(ast::Formula &formula)
+	static OperationResult apply(ast::Formula &formula, SimplificationPass &)
 	{
 		if (!formula.is<ast::Exists>())
 			return OperationResult::Unchanged;
@@ -181,7 +207,7 @@ struct SimplificationRuleAssignmentInExists
 {
 	static constexpr const auto Description = "exists X (X = t and F(X)) === exists () (F(t))";
 
-	static OperationResult apply(ast::Formula &formula)
+	static OperationResult apply(ast::Formula &formula, SimplificationPass &)
 	{
 		if (!formula.is<ast::Exists>())
 			return OperationResult::Unchanged;
@@ -194,50 +220,47 @@ struct SimplificationRuleAssignmentInExists
 		auto &and_ = exists.argument.get<ast::And>();
 		auto &arguments = and_.arguments;
 
+		// All variables are replaced at once in the end, with the same result as replacing them one after the other
+		ast::VariableSubstitution substitution;
+
 		auto simplificationResult = OperationResult::Unchanged;
 
-		for (auto i = exists.variables.begin(); i != exists.variables.end();)
+		for (const auto &variableDeclaration : exists.variables)
 		{
-			const auto &variableDeclaration = **i;
-
-			bool wasVariableReplaced = false;
-
-			// TODO: refactor
 			for (auto j = arguments.begin(); j != arguments.end(); j++)
 			{
 				auto &argument = *j;
 				// Find term that is equivalent to the given variable
-				auto assignedTerm = extractAssignedTerm(argument, variableDeclaration);
+				auto assignedTerm = extractAssignedTerm(argument, *variableDeclaration, substitution);
 
 				if (!assignedTerm)
 					continue;
 
-				// Replace all occurrences of the variable with the equivalent term
-				for (auto k = arguments.begin(); k != arguments.end(); k++)
-				{
-					if (k == j)
-						continue;
-
-					auto &otherArgument = *k;
-					otherArgument.accept(ReplaceVariableInFormulaVisitor(), otherArgument, variableDeclaration, assignedTerm.value());
-				}
-
+				substitution.add(*variableDeclaration, std::move(assignedTerm.value()));
 				arguments.erase(j);
 
-				wasVariableReplaced = true;
 				simplificationResult = OperationResult::Changed;
 
 				break;
 			}
+		}
+
+		if (simplificationResult == OperationResult::Unchanged)
+			return simplificationResult;
 
-			if (wasVariableReplaced)
+		// Replace all occurrences of the variables with the equivalent terms
+		for (auto &argument : arguments)
+			substitution.apply(argument);
+
+		// The replaced variables are only removed now because the substitution refers to them until here
+		const auto isVariableReplaced =
+			[&](const auto &variableDeclaration)
 			{
-				i = exists.variables.erase(i);
-				continue;
-			}
+				return (substitution.find(*variableDeclaration) != nullptr);
+			};
 
-			i++;
-		}
+		exists.variables.erase(std::remove_if(exists.variables.begin(), exists.variables.end(), isVariableReplaced),
+			exists.variables.end());
 
 		return simplificationResult;
 	}
@@ -249,7 +272,7 @@ struct SimplificationRuleEmptyConjunction
 {
 	static constexpr const auto Description = "[empty conjunction] === #true";
 
-	static OperationResult apply(ast::Formula &formula)
+	static OperationResult apply(ast::Formula &formula, SimplificationPass &)
 	{
 		if (!formula.is<ast::And>())
 			return OperationResult::Unchanged;
@@ -271,7 +294,7 @@ struct SimplificationRuleOneElementConjunction
 {
 	static constexpr const auto Description = "[conjunction of only F] === F";
 
-	static OperationResult apply(ast::Formula &formula)
+	static OperationResult apply(ast::Formula &formula, SimplificationPass &)
 	{
 		if (!formula.is<ast::And>())
 			return OperationResult::Unchanged;
@@ -293,7 +316,7 @@ struct SimplificationRuleTrivialExists
 {
 	static constexpr const auto Description = "exists ... ([#true/#false]) === [#true/#false]";
 
-	static OperationResult apply(ast::Formula &formula)
+	static OperationResult apply(ast::Formula &formula, SimplificationPass &)
 	{
 		if (!formula.is<ast::Exists>())
 			return OperationResult::Unchanged;
@@ -315,7 +338,7 @@ struct SimplificationRuleInWithPrimitiveArguments
 {
 	static constexpr const auto Description = "[primitive A] in [primitive B] === A = B";
 
-	static OperationResult apply(ast::Formula &formula)
+	static OperationResult apply(ast::Formula &formula, SimplificationPass &)
 	{
 		if (!formula.is<ast::In>())
 			return OperationResult::Unchanged;
@@ -339,7 +362,7 @@ struct SimplificationRuleSubsumptionInBiconditionals
 {
 	static constexpr const auto Description = "(F <-> (F and G)) === (F -> G)";
 
-	static OperationResult apply(ast::Formula &formula)
+	static OperationResult apply(ast::Formula &formula, SimplificationPass &simplificationPass)
 	{
 		if (!formula.is<ast::Biconditional>())
 			return OperationResult::Unchanged;
@@ -363,7 +386,7 @@ struct SimplificationRuleSubsumptionInBiconditionals
 			std::find_if(and_.arguments.cbegin(), and_.arguments.cend(),
 			[&](const auto &argument)
 			{
-				return (ast::equal(predicateSide, argument) == Tristate::True);
+				return (ast::equal(predicateSide, argument, simplificationPass.fingerprintCache) == Tristate::True);
 			});
 
 		if (matchingPredicate == and_.arguments.cend())
@@ -383,7 +406,7 @@ struct SimplificationRuleDoubleNegation
 {
 	static constexpr const auto Description = "not not F === F";
 
-	static OperationResult apply(ast::Formula &formula)
+	static OperationResult apply(ast::Formula &formula, SimplificationPass &)
 	{
 		if (!formula.is<ast::Not>())
 			return OperationResult::Unchanged;
@@ -407,7 +430,7 @@ struct SimplificationRuleDeMorganForConjunctions
 {
 	static constexpr const auto Description = "(not (F and G)) === (not F or not G)";
 
-	static OperationResult apply(ast::Formula &formula)
+	static OperationResult apply(ast::Formula &formula, SimplificationPass &)
 	{
 		if (!formula.is<ast::Not>())
 			return OperationResult::Unchanged;
@@ -434,7 +457,7 @@ struct SimplificationRuleImplicationFromDisjunction
 {
 	static constexpr const auto Description = "(not F or G) === (F -> G)";
 
-	static OperationResult apply(ast::Formula &formula)
+	static OperationResult apply(ast::Formula &formula, SimplificationPass &)
 	{
 		if (!formula.is<ast::Or>())
 			return OperationResult::Unchanged;
@@ -470,7 +493,7 @@ struct SimplificationRuleNegatedComparison
 {
 	static constexpr const auto Description = "(not F [comparison] G) === (F [negated comparison] G)";
 
-	static OperationResult apply(ast::Formula &formula)
+	static OperationResult apply(ast::Formula &formula, SimplificationPass &)
 	{
 		if (!formula.is<ast::Not>())
 			return OperationResult::Unchanged;
@@ -516,7 +539,7 @@ struct SimplificationRuleIntegerSetInclusion
 {
 	static constexpr const auto Description = "(F in G) === (F = G) if F and G are integer variables";
 
-	static OperationResult apply(ast::Formula &formula)
+	static OperationResult apply(ast::Formula &formula, SimplificationPass &)
 	{
 		if (!formula.is<ast::In>())
 			return OperationResult::Unchanged;
@@ -540,8 +563,8 @@ struct SimplificationRuleIntegerSetInclusion
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-const auto simplifyWithDefaultRules =
-	simplify
+using DefaultSimplificationRules =
+	SimplificationRuleSet
 	<
 		SimplificationRuleDoubleNegation,
 		SimplificationRuleTrivialAssignmentInExists,
@@ -563,10 +586,12 @@ const auto simplifyWithDefaultRules =
 // Performs the different simplification techniques
 struct SimplifyFormulaVisitor : public ast::FormulaSimplificationVisitor<SimplifyFormulaVisitor>
 {
-	// Do nothing for all other types of expressions
-	static OperationResult accept(ast::Formula &formula)
+	static OperationResult accept(ast::Formula &formula, SimplificationPass &simplificationPass)
 	{
-		return simplifyWithDefaultRules(formula);
+		if (simplificationPass.statistics)
+			simplificationPass.statistics->numberOfIterations++;
+
+		return DefaultSimplificationRules::apply(formula, simplificationPass);
 	}
 };
 
@@ -574,7 +599,22 @@ struct SimplifyFormulaVisitor : public ast::FormulaSimplificationVisitor<Simplif
 
 void simplify(ast::Formula &formula)
 {
-	while (formula.accept(SimplifyFormulaVisitor(), formula) == OperationResult::Changed);
+	SimplificationPass simplificationPass;
+
+	SimplifyFormulaVisitor::simplify(formula, simplificationPass);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void simplify(ast::Formula &formula, SimplificationStatistics &statistics)
+{
+	if (statistics.rules.empty())
+		statistics = DefaultSimplificationRules::makeStatistics();
+
+	SimplificationPass simplificationPass;
+	simplificationPass.statistics = &statistics;
+
+	SimplifyFormulaVisitor::simplify(formula, simplificationPass);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
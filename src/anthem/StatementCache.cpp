@@ -0,0 +1,201 @@
+#include <anthem/StatementCache.h>
+
+#include <sstream>
+
+#include <anthem/ASTCopy.h>
+#include <anthem/DeclarationMerging.h>
+#include <anthem/StatementVisitor.h>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// StatementCache
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::string completedDefinitionKey(const ast::PredicateDeclaration &predicateDeclaration)
+{
+	return predicateDeclaration.name + "/" + std::to_string(predicateDeclaration.arity());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+StatementCache::StatementCache()
+:	m_declarations{std::make_unique<Context>()}
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+StatementCache::~StatementCache() = default;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void StatementCache::beginProgram(Context &context)
+{
+	// The cached formulas are allocated from the cache’s arena, which only recycles their memory while active
+	ArenaScope arenaScope(&m_arena);
+
+	const auto numberOfCompletedDefinitions = m_completedDefinitions.size();
+
+	// Statements are translated differently depending on the mode
+	if (context.translationMode != m_translationMode)
+	{
+		m_statements.clear();
+		m_completedDefinitions.clear();
+		m_translationMode = context.translationMode;
+	}
+
+	m_numberOfPrograms++;
+
+	const auto isUnused =
+		[&](const auto &entry)
+		{
+			return entry.second.lastUsed + 2 < m_numberOfPrograms;
+		};
+
+	for (auto i = m_statements.begin(); i != m_statements.end();)
+		i = isUnused(*i) ? m_statements.erase(i) : std::next(i);
+
+	for (auto i = m_completedDefinitions.begin(); i != m_completedDefinitions.end();)
+		i = isUnused(*i) ? m_completedDefinitions.erase(i) : std::next(i);
+
+	// Drop the declarations that only the discarded completed definitions referred to
+	if (m_completedDefinitions.size() != numberOfCompletedDefinitions)
+	{
+		auto declarations = std::make_unique<Context>();
+
+		for (auto &[key, completedDefinition] : m_completedDefinitions)
+			redirectDeclarations(completedDefinition.formula, *declarations);
+
+		m_declarations = std::move(declarations);
+	}
+
+	m_formulaOrigins.clear();
+	m_numberOfStatements = 0;
+	m_numberOfTranslatedStatements = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void StatementCache::translateStatement(const Clingo::AST::Statement &statement,
+	std::vector<ast::ScopedFormula> &scopedFormulas, Context &context)
+{
+	std::stringstream text;
+	text << statement;
+
+	m_numberOfStatements++;
+	m_totalNumberOfStatements++;
+
+	auto match = m_statements.find(text.str());
+
+	if (match == m_statements.end())
+	{
+		// The statement’s context only logs while the statement is translated
+		auto &errorStream = context.logger.errorStream();
+		auto statementContext = std::make_unique<Context>(output::Logger(output::ColorStream(errorStream.stream()),
+			output::ColorStream(errorStream.stream())));
+		statementContext->logger.setColorPolicy(errorStream.supportsColor()
+			? output::ColorStream::ColorPolicy::Always
+			: output::ColorStream::ColorPolicy::Never);
+		statementContext->logger.setLogPriority(context.logger.logPriority());
+		statementContext->copyOptions(context);
+
+		Statement cachedStatement{m_nextStatementID++, std::move(statementContext), {}, 0};
+
+		{
+			ArenaScope arenaScope(&m_arena);
+			statement.data.accept(StatementVisitor(), statement, cachedStatement.scopedFormulas, *cachedStatement.context);
+		}
+
+		match = m_statements.emplace(text.str(), std::move(cachedStatement)).first;
+		m_numberOfTranslatedStatements++;
+		m_totalNumberOfTranslatedStatements++;
+	}
+
+	auto &cachedStatement = match->second;
+	cachedStatement.lastUsed = m_numberOfPrograms;
+
+	// The cached formulas are copied because the translation modifies them later on
+	std::vector<ast::ScopedFormula> statementScopedFormulas;
+	statementScopedFormulas.reserve(cachedStatement.scopedFormulas.size());
+
+	for (size_t i = 0; i < cachedStatement.scopedFormulas.size(); i++)
+	{
+		statementScopedFormulas.emplace_back(ast::copy(cachedStatement.scopedFormulas[i]));
+		m_formulaOrigins.emplace_back(cachedStatement.id, i);
+	}
+
+	mergeDeclarations(context, *cachedStatement.context, statementScopedFormulas);
+
+	for (auto &scopedFormula : statementScopedFormulas)
+		scopedFormulas.emplace_back(std::move(scopedFormula));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::optional<std::vector<StatementCache::FormulaOrigin>> StatementCache::formulaOrigins(
+	const std::vector<ast::ScopedFormula *> &definitions, const std::vector<ast::ScopedFormula> &scopedFormulas) const
+{
+	// The formulas don’t stem from the current program, for example if reading it failed
+	if (m_formulaOrigins.size() != scopedFormulas.size())
+		return std::nullopt;
+
+	std::vector<FormulaOrigin> formulaOrigins;
+	formulaOrigins.reserve(definitions.size());
+
+	for (const auto *definition : definitions)
+		formulaOrigins.emplace_back(m_formulaOrigins[definition - scopedFormulas.data()]);
+
+	return formulaOrigins;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::optional<ast::Formula> StatementCache::loadCompletedDefinition(const ast::PredicateDeclaration &predicateDeclaration,
+	const std::vector<ast::ScopedFormula *> &definitions, const std::vector<ast::ScopedFormula> &scopedFormulas,
+	Context &context)
+{
+	const auto formulaOrigins = this->formulaOrigins(definitions, scopedFormulas);
+
+	if (!formulaOrigins)
+		return std::nullopt;
+
+	auto match = m_completedDefinitions.find(completedDefinitionKey(predicateDeclaration));
+
+	if (match == m_completedDefinitions.end() || match->second.definitions != formulaOrigins.value())
+		return std::nullopt;
+
+	match->second.lastUsed = m_numberOfPrograms;
+
+	auto completedDefinition = ast::prepareCopy(match->second.formula);
+	redirectDeclarations(completedDefinition, context);
+
+	return completedDefinition;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void StatementCache::storeCompletedDefinition(const ast::PredicateDeclaration &predicateDeclaration,
+	const std::vector<ast::ScopedFormula *> &definitions, const std::vector<ast::ScopedFormula> &scopedFormulas,
+	const ast::Formula &completedDefinition)
+{
+	auto formulaOrigins = this->formulaOrigins(definitions, scopedFormulas);
+
+	if (!formulaOrigins)
+		return;
+
+	ArenaScope arenaScope(&m_arena);
+
+	auto formula = ast::prepareCopy(completedDefinition);
+	redirectDeclarations(formula, *m_declarations);
+
+	m_completedDefinitions.insert_or_assign(completedDefinitionKey(predicateDeclaration),
+		CompletedDefinition{std::move(formulaOrigins.value()), std::move(formula), m_numberOfPrograms});
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
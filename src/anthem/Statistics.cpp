@@ -0,0 +1,150 @@
+#include <anthem/Statistics.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include <anthem/output/Formatting.h>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Statistics
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Statistics::add(const SimplificationStatistics &simplificationStatistics)
+{
+	if (simplificationRules.empty())
+		for (const auto &rule : simplificationStatistics.rules)
+			simplificationRules.emplace_back(SimplificationRuleStatistics{rule.description});
+
+	assert(simplificationRules.size() == simplificationStatistics.rules.size());
+
+	for (size_t i = 0; i < simplificationRules.size(); i++)
+	{
+		auto &rule = simplificationRules[i];
+		const auto &otherRule = simplificationStatistics.rules[i];
+
+		assert(rule.description == otherRule.description);
+
+		rule.numberOfAttempts += otherRule.numberOfAttempts;
+		rule.numberOfRewrites += otherRule.numberOfRewrites;
+		rule.time += otherRule.time;
+	}
+
+	numberOfSimplificationIterations.emplace_back(simplificationStatistics.numberOfIterations);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Statistics::print(output::ColorStream &stream, bool printDetails) const
+{
+	const auto formatMilliseconds =
+		[](const auto &duration)
+		{
+			std::stringstream stream;
+			stream << std::fixed << std::setprecision(3) << std::chrono::duration<double, std::milli>(duration).count();
+
+			return stream.str();
+		};
+
+	const auto formatThroughput =
+		[](size_t size, const auto &duration)
+		{
+			const auto seconds = std::chrono::duration<double>(duration).count();
+
+			std::stringstream stream;
+			stream << std::fixed << std::setprecision(1);
+
+			if (seconds > 0)
+				stream << (static_cast<double>(size) / seconds / 1e6);
+			else
+				stream << "inf";
+
+			return stream.str();
+		};
+
+	stream << output::Keyword("input") << std::endl;
+
+	for (const auto &input : inputs)
+		stream
+			<< "  " << input.fileName << ": "
+			<< output::Number<size_t>(input.size) << " bytes"
+			<< (input.isMemoryMapped ? " (memory-mapped)" : "") << ", "
+			<< output::Number<std::string>(formatMilliseconds(input.time)) << " ms, "
+			<< output::Number<std::string>(formatThroughput(input.size, input.time)) << " MB/s"
+			<< std::endl;
+
+	stream << output::Keyword("simplification rules") << std::endl;
+
+	if (simplificationRules.empty())
+		stream << "  (no formulas simplified)" << std::endl;
+
+	for (const auto &rule : simplificationRules)
+		stream
+			<< "  " << rule.description << ": "
+			<< output::Number<size_t>(rule.numberOfAttempts) << " attempts, "
+			<< output::Number<size_t>(rule.numberOfRewrites) << " rewrites, "
+			<< output::Number<std::string>(formatMilliseconds(rule.time)) << " ms"
+			<< std::endl;
+
+	size_t totalNumberOfIterations = 0;
+	size_t maximumNumberOfIterations = 0;
+	// Number of formulas by the number of iterations they took, in buckets of powers of two (0, 1, 2–3, 4–7, …)
+	std::vector<size_t> histogram;
+
+	for (const auto numberOfIterations : numberOfSimplificationIterations)
+	{
+		totalNumberOfIterations += numberOfIterations;
+		maximumNumberOfIterations = std::max(maximumNumberOfIterations, numberOfIterations);
+
+		size_t bucket = 0;
+
+		while ((numberOfIterations >> bucket) > 0)
+			bucket++;
+
+		if (histogram.size() <= bucket)
+			histogram.resize(bucket + 1, 0);
+
+		histogram[bucket]++;
+	}
+
+	stream
+		<< output::Keyword("simplification fixpoint iterations") << ": "
+		<< output::Number<size_t>(totalNumberOfIterations) << " in total, "
+		<< output::Number<size_t>(maximumNumberOfIterations) << " at most for "
+		<< output::Number<size_t>(numberOfSimplificationIterations.size()) << " formulas" << std::endl;
+
+	for (size_t bucket = 0; bucket < histogram.size(); bucket++)
+	{
+		if (histogram[bucket] == 0)
+			continue;
+
+		const size_t minimumNumberOfIterations = (bucket == 0 ? 0 : size_t(1) << (bucket - 1));
+		const size_t maximumNumberOfIterationsInBucket = (bucket == 0 ? 0 : (size_t(1) << bucket) - 1);
+
+		stream << "  " << output::Number<size_t>(minimumNumberOfIterations);
+
+		if (maximumNumberOfIterationsInBucket > minimumNumberOfIterations)
+			stream << "-" << output::Number<size_t>(maximumNumberOfIterationsInBucket);
+
+		stream << " iterations: " << output::Number<size_t>(histogram[bucket]) << " formulas" << std::endl;
+	}
+
+	if (!printDetails)
+		return;
+
+	stream << output::Keyword("simplification fixpoint iterations per formula") << std::endl;
+
+	for (size_t i = 0; i < numberOfSimplificationIterations.size(); i++)
+		stream
+			<< "  formula " << (i + 1) << ": "
+			<< output::Number<size_t>(numberOfSimplificationIterations[i]) << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
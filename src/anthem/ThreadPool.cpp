@@ -0,0 +1,207 @@
+#include <anthem/ThreadPool.h>
+
+#include <algorithm>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// ThreadPool
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ThreadPool::ThreadPool(size_t numberOfThreads, std::vector<std::unique_ptr<Arena>> *arenas)
+:	m_arenas{arenas}
+{
+	numberOfThreads = std::max<size_t>(numberOfThreads, 1);
+
+	m_workers.reserve(numberOfThreads);
+
+	for (size_t i = 0; i < numberOfThreads; i++)
+	{
+		m_workers.emplace_back(std::make_unique<Worker>());
+
+		// Worker 0 allocates from the arena active on the calling thread
+		if (m_arenas && i > 0)
+			m_workers.back()->arena = std::make_unique<Arena>();
+	}
+
+	// Worker 0 is the thread calling forEachIndex
+	m_threads.reserve(numberOfThreads - 1);
+
+	for (size_t i = 1; i < numberOfThreads; i++)
+		m_threads.emplace_back([this, i](){run(i);});
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_isStopping = true;
+	}
+
+	m_workAvailable.notify_all();
+
+	for (auto &thread : m_threads)
+		thread.join();
+
+	for (auto &worker : m_workers)
+		if (worker->arena)
+			m_arenas->emplace_back(std::move(worker->arena));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t ThreadPool::numberOfThreads() const noexcept
+{
+	return m_workers.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::forEachIndex(size_t count, const std::function<void(size_t)> &task)
+{
+	if (count == 0)
+		return;
+
+	if (m_workers.size() == 1 || count == 1)
+	{
+		for (size_t i = 0; i < count; i++)
+			task(i);
+
+		return;
+	}
+
+	m_task = &task;
+	m_exception = nullptr;
+	m_numberOfRemainingIndices = count;
+
+	// Hand out contiguous ranges of indices, idle workers steal from the others later on
+	const auto chunkSize = (count + m_workers.size() - 1) / m_workers.size();
+
+	for (size_t i = 0; i < m_workers.size(); i++)
+	{
+		auto &worker = *m_workers[i];
+		std::lock_guard<std::mutex> lock(worker.mutex);
+
+		for (size_t index = i * chunkSize; index < std::min((i + 1) * chunkSize, count); index++)
+			worker.indices.push_back(index);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_batchID++;
+	}
+
+	m_workAvailable.notify_all();
+
+	processIndices(0);
+
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_workFinished.wait(lock, [&](){return m_numberOfRemainingIndices == 0;});
+	}
+
+	m_task = nullptr;
+
+	if (m_exception)
+		std::rethrow_exception(m_exception);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::run(size_t workerIndex)
+{
+	size_t lastBatchID = 0;
+
+	// Objects created and deleted by the same worker are recycled, objects deleted by other threads are released
+	// along with the arena
+	ArenaScope arenaScope(m_workers[workerIndex]->arena.get());
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_workAvailable.wait(lock, [&](){return m_isStopping || m_batchID != lastBatchID;});
+
+			if (m_isStopping)
+				return;
+
+			lastBatchID = m_batchID;
+		}
+
+		processIndices(workerIndex);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ThreadPool::processIndices(size_t workerIndex)
+{
+	size_t index;
+
+	while (takeIndex(workerIndex, index))
+	{
+		try
+		{
+			(*m_task)(index);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(m_exceptionMutex);
+
+			if (!m_exception || index < m_exceptionIndex)
+			{
+				m_exception = std::current_exception();
+				m_exceptionIndex = index;
+			}
+		}
+
+		if (m_numberOfRemainingIndices.fetch_sub(1) == 1)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_workFinished.notify_all();
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ThreadPool::takeIndex(size_t workerIndex, size_t &index)
+{
+	// Take work from the front of the own queue first
+	{
+		auto &worker = *m_workers[workerIndex];
+		std::lock_guard<std::mutex> lock(worker.mutex);
+
+		if (!worker.indices.empty())
+		{
+			index = worker.indices.front();
+			worker.indices.pop_front();
+			return true;
+		}
+	}
+
+	// Otherwise, steal from the back of the other workers’ queues
+	for (size_t i = 1; i < m_workers.size(); i++)
+	{
+		auto &worker = *m_workers[(workerIndex + i) % m_workers.size()];
+		std::lock_guard<std::mutex> lock(worker.mutex);
+
+		if (!worker.indices.empty())
+		{
+			index = worker.indices.back();
+			worker.indices.pop_back();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -1,17 +1,25 @@
 #include <anthem/Translation.h>
 
+#include <chrono>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <sstream>
 
 #include <clingo.hh>
 
+#include <anthem/ASTUtils.h>
 #include <anthem/Completion.h>
 #include <anthem/Context.h>
+#include <anthem/DeclarationMerging.h>
 #include <anthem/IntegerVariableDetection.h>
 #include <anthem/MapDomains.h>
+#include <anthem/MappedFile.h>
 #include <anthem/Simplification.h>
+#include <anthem/StatementCache.h>
 #include <anthem/StatementVisitor.h>
+#include <anthem/ThreadPool.h>
+#include <anthem/TranslationCache.h>
 #include <anthem/output/FormatterHumanReadable.h>
 #include <anthem/output/FormatterTPTP.h>
 
@@ -155,7 +163,7 @@ const auto printTypeAnnotation =
 						<< "(" << symbolDeclaration.name
 						<< "/" << output::Number(symbolDeclaration.arity())
 						<< "@" << output::Number(i + 1)
-						<< ")" << std::endl;
+						<< ")\n";
 				}
 				break;
 			case OutputFormat::TPTP:
@@ -192,7 +200,7 @@ const auto printTypeAnnotation =
 				using PrintReturnTypeTrait = PrintReturnTypeTrait<typename std::remove_cv<
 					typename std::remove_reference<decltype(symbolDeclaration)>::type>::type>;
 				PrintReturnTypeTrait::print(stream, symbolDeclaration);
-				stream << "))." << std::endl;
+				stream << ")).\n";
 
 				break;
 			}
@@ -211,12 +219,58 @@ void translateCompletion(std::vector<ast::ScopedFormula> &&scopedFormulas, Conte
 
 	const auto performSimplification = (context.performSimplification && context.semantics == Semantics::ClassicalLogic);
 
+	// Worker threads allocate from arenas of their own, which the context keeps until the AST is destroyed
+	ThreadPool threadPool(context.numberOfThreads, context.allocateFromArena ? &context.adoptedArenas : nullptr);
+
+	const auto simplifyFormulas =
+		[&](size_t numberOfFormulas, const auto &formulaAt)
+		{
+			Profiler::Span span(context.profiler.get(), "simplification");
+
+			const auto simplifyFormula =
+				[&](size_t i, auto &&... statistics)
+				{
+					auto *profiler = Profiler::details(context.profiler.get());
+					Profiler::Span span(profiler, profiler ? "simplify formula " + std::to_string(i + 1) : std::string());
+
+					simplify(formulaAt(i), statistics...);
+				};
+
+			if (!context.collectStatistics)
+			{
+				threadPool.forEachIndex(numberOfFormulas,
+					[&](size_t i)
+					{
+						simplifyFormula(i);
+					});
+
+				return;
+			}
+
+			// Collect the statistics separately for each formula and add them up in the order of the output
+			std::vector<SimplificationStatistics> simplificationStatistics(numberOfFormulas);
+
+			threadPool.forEachIndex(numberOfFormulas,
+				[&](size_t i)
+				{
+					simplifyFormula(i, simplificationStatistics[i]);
+				});
+
+			for (const auto &formulaStatistics : simplificationStatistics)
+				context.statistics.add(formulaStatistics);
+		};
+
 	if (!context.performCompletion)
 	{
 		// Simplify output if specified
 		if (performSimplification)
-			for (auto &scopedFormula : scopedFormulas)
-				simplify(scopedFormula.formula);
+		{
+			simplifyFormulas(scopedFormulas.size(),
+				[&](size_t i) -> ast::Formula &
+				{
+					return scopedFormulas[i].formula;
+				});
+		}
 
 		if (context.showStatementsUsed)
 			context.logger.log(output::Priority::Warning) << "#show statements are ignored because completion is not enabled";
@@ -224,17 +278,27 @@ void translateCompletion(std::vector<ast::ScopedFormula> &&scopedFormulas, Conte
 		if (context.externalStatementsUsed)
 			context.logger.log(output::Priority::Warning) << "#external statements are ignored because completion is not enabled";
 
+		recordNumberOfNodes(context.profiler.get(), scopedFormulas);
+
+		Profiler::Span span(context.profiler.get(), "printing");
+
 		for (const auto &scopedFormula : scopedFormulas)
 		{
 			printFormula(scopedFormula.formula, FormulaType::Axiom, context, printContext);
-			context.logger.outputStream() << std::endl;
+			context.logger.outputStream() << "\n";
 		}
 
 		return;
 	}
 
 	// Perform completion
-	auto completedFormulas = complete(std::move(scopedFormulas), context);
+	auto completedFormulas =
+		[&]()
+		{
+			Profiler::Span span(context.profiler.get(), "completion");
+
+			return complete(std::move(scopedFormulas), context, threadPool);
+		}();
 
 	for (const auto &predicateDeclaration : context.predicateDeclarations)
 	{
@@ -262,12 +326,28 @@ void translateCompletion(std::vector<ast::ScopedFormula> &&scopedFormulas, Conte
 
 	// Detect integer variables
 	if (context.performIntegerDetection)
-		detectIntegerVariables(completedFormulas);
+	{
+		{
+			Profiler::Span span(context.profiler.get(), "integer detection");
+			detectIntegerVariables(completedFormulas);
+		}
+
+		recordNumberOfNodes(context.profiler.get(), completedFormulas);
+	}
 
 	// Simplify output if specified
 	if (performSimplification)
-		for (auto &completedFormula : completedFormulas)
-			simplify(completedFormula);
+	{
+		simplifyFormulas(completedFormulas.size(),
+			[&](size_t i) -> ast::Formula &
+			{
+				return completedFormulas[i];
+			});
+	}
+
+	recordNumberOfNodes(context.profiler.get(), completedFormulas);
+
+	Profiler::Span span(context.profiler.get(), "printing");
 
 	// Print specifiers for integer predicate parameters
 	for (auto &predicateDeclaration : context.predicateDeclarations)
@@ -281,8 +361,8 @@ void translateCompletion(std::vector<ast::ScopedFormula> &&scopedFormulas, Conte
 			|| (predicateDeclaration->visibility == ast::PredicateDeclaration::Visibility::Default
 				&& context.defaultPredicateVisibility == ast::PredicateDeclaration::Visibility::Visible);
 
-		// If the predicate ought to be visible, don’t eliminate it
-		if (!isPredicateVisible)
+		// Only visible predicates and abbreviations remain in the output
+		if (!isPredicateVisible && !predicateDeclaration->isAbbreviation)
 			continue;
 
 		printTypeAnnotation(*predicateDeclaration, context, printContext);
@@ -293,7 +373,7 @@ void translateCompletion(std::vector<ast::ScopedFormula> &&scopedFormulas, Conte
 	for (const auto &completedFormula : completedFormulas)
 	{
 		printFormula(completedFormula, FormulaType::Axiom, context, printContext);
-		context.logger.outputStream() << std::endl;
+		context.logger.outputStream() << "\n";
 	}
 }
 
@@ -587,7 +667,15 @@ void translateHereAndThere(std::vector<ast::ScopedFormula> &&scopedFormulasA,
 
     auto finalPrimeAxioms = buildUniversallyClosedFormulas(std::move(primeAxioms));
 
-	auto finalFormulas = buildFinalFormulas();
+	auto finalFormulas =
+		[&]()
+		{
+			Profiler::Span span(context.profiler.get(), "here-and-there translation");
+
+			return buildFinalFormulas();
+		}();
+
+	recordNumberOfNodes(context.profiler.get(), finalFormulas);
 
 	const auto performDomainMapping =
 		[&]()
@@ -606,6 +694,8 @@ void translateHereAndThere(std::vector<ast::ScopedFormula> &&scopedFormulasA,
 	// If requested, map both program and integer variables to integers
 	if (performDomainMapping())
 	{
+		Profiler::Span span(context.profiler.get(), "domain mapping");
+
         for (auto &finalFormula : finalFormulas)
             mapDomains(finalFormula, context);
 
@@ -613,6 +703,10 @@ void translateHereAndThere(std::vector<ast::ScopedFormula> &&scopedFormulasA,
             mapDomains(finalPrimeAxiom, context);
     }
 
+	recordNumberOfNodes(context.profiler.get(), finalFormulas);
+
+	Profiler::Span span(context.profiler.get(), "printing");
+
 	// Print auxiliary definitions for mapping program and integer variables to even and odd integers
 	if (context.outputFormat == OutputFormat::TPTP)
 	{
@@ -635,7 +729,7 @@ tff(types, type, object: $tType).
     for (auto &finalPrimeAxiom : finalPrimeAxioms)
     {
         printFormula(finalPrimeAxiom, FormulaType::Axiom, context, printContext);
-        context.logger.outputStream() << std::endl;
+        context.logger.outputStream() << "\n";
     }
 
 	if (context.outputFormat == OutputFormat::TPTP)
@@ -692,7 +786,7 @@ tff(greater, axiom, (![X1: $int, X2: $int]: (p__greater__(f__integer__(X1), f__i
 tff(greater, axiom, (![X1: $i, X2: $int]: p__greater__(f__symbolic__(X1), f__integer__(X2)))).
 tff(greater, axiom, (![X1: $int, X2: $i]: ~p__greater__(f__integer__(X1), f__symbolic__(X2)))).
 )"
-			<< std::endl;
+			<< "\n";
 	}
 
 	if (scopedFormulasB)
@@ -711,24 +805,31 @@ tff(greater, axiom, (![X1: $int, X2: $i]: ~p__greater__(f__integer__(X1), f__sym
 	for (auto &finalFormula : finalFormulas)
 	{
 		printFormula(finalFormula, formulaType(), context, printContext);
-		context.logger.outputStream() << std::endl;
+		context.logger.outputStream() << "\n";
 	}
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-std::vector<ast::ScopedFormula> translateSingleStream(const char *fileName, std::istream &stream, Context &context)
+// Parses a null-terminated program, of which reading started at the given time
+std::vector<ast::ScopedFormula> translateProgram(const char *fileName, const char *program, size_t size,
+	bool isMemoryMapped, std::chrono::steady_clock::time_point startTime, Context &context)
 {
-	context.logger.log(output::Priority::Info) << "reading " << fileName;
-
-	auto fileContent = std::string(std::istreambuf_iterator<char>(stream), {});
-
 	std::vector<ast::ScopedFormula> scopedFormulas;
 
+	if (context.statementCache)
+		context.statementCache->beginProgram(context);
+
 	const auto translateStatement =
 		[&scopedFormulas, &context](const Clingo::AST::Statement &statement)
 		{
-			statement.data.accept(StatementVisitor(), statement, scopedFormulas, context);
+			auto *profiler = Profiler::details(context.profiler.get());
+			Profiler::Span span(profiler, profiler ? "translate statement in line " + std::to_string(statement.location.begin_line()) : std::string());
+
+			if (context.statementCache)
+				context.statementCache->translateStatement(statement, scopedFormulas, context);
+			else
+				statement.data.accept(StatementVisitor(), statement, scopedFormulas, context);
 		};
 
 	const auto logger =
@@ -737,61 +838,287 @@ std::vector<ast::ScopedFormula> translateSingleStream(const char *fileName, std:
 			context.logger.log(output::Priority::Error) << text;
 		};
 
-	Clingo::parse_program(fileContent.c_str(), translateStatement, logger);
+	{
+		Profiler::Span span(context.profiler.get(), std::string("parsing ") + fileName);
+		Clingo::parse_program(program, translateStatement, logger);
+	}
+
+	if (context.collectStatistics)
+	{
+		const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime);
+		context.statistics.inputs.push_back({fileName, size, isMemoryMapped, time});
+	}
+
+	recordNumberOfNodes(context.profiler.get(), scopedFormulas);
 
 	return scopedFormulas;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void translate(const std::vector<std::string> &fileNames, Context &context)
+std::vector<ast::ScopedFormula> translateSingleStream(const char *fileName, std::istream &stream, Context &context)
 {
-	if (fileNames.empty())
-		throw TranslationException("no input files specified");
+	context.logger.log(output::Priority::Info) << "reading " << fileName;
+
+	const auto startTime = std::chrono::steady_clock::now();
 
-	const auto translateSingleFile =
-		[&](const auto &fileName)
+	auto fileContent = std::string(std::istreambuf_iterator<char>(stream), {});
+
+	return translateProgram(fileName, fileContent.c_str(), fileContent.size(), false, startTime, context);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::vector<ast::ScopedFormula> translateSingleFile(const std::string &fileName, Context &context)
+{
+	// Regular files are parsed in place, without copying them into memory first, unless they may change
+	// in the meantime, which would invalidate the mapping
+	if (context.mapInputFiles)
+	{
+		MappedFile mappedFile(fileName.c_str());
+
+		if (mappedFile.isMapped())
 		{
-			std::ifstream file(fileName, std::ios::in);
+			context.logger.log(output::Priority::Info) << "reading " << fileName;
 
-			if (!file.is_open())
-				throw LogicException("could not read file “" + fileName + "”");
+			const auto startTime = std::chrono::steady_clock::now();
 
-			return translateSingleStream(fileName.c_str(), file, context);
-		};
+			return translateProgram(fileName.c_str(), mappedFile.data(), mappedFile.size(), true, startTime, context);
+		}
+	}
+
+	// Pipes and other special files are read as streams
+	std::ifstream file(fileName, std::ios::in);
+
+	if (!file.is_open())
+		throw LogicException("could not read file “" + fileName + "”");
+
+	return translateSingleStream(fileName.c_str(), file, context);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Translates two programs on separate threads, as if the second one was translated after the first one
+template<class TranslateInput>
+std::pair<std::vector<ast::ScopedFormula>, std::vector<ast::ScopedFormula>> translateConcurrently(
+	const TranslateInput &translateInput, Context &context)
+{
+	// Messages about the second program are held back until the first program is translated
+	std::stringstream logB;
+
+	Context contextB{output::Logger(output::ColorStream(logB), output::ColorStream(logB))};
+	contextB.logger.setColorPolicy(context.logger.errorStream().supportsColor()
+		? output::ColorStream::ColorPolicy::Always
+		: output::ColorStream::ColorPolicy::Never);
+	contextB.logger.setLogPriority(context.logger.logPriority());
+	contextB.copyOptions(context);
+	contextB.semantics = context.semantics;
+	contextB.profiler = context.profiler;
+
+	auto arenaB = context.allocateFromArena ? std::make_unique<Arena>() : nullptr;
+
+	auto scopedFormulasBFuture = std::async(std::launch::async,
+		[&]()
+		{
+			ArenaScope arenaScope(arenaB.get());
+
+			return translateInput(1, contextB);
+		});
+
+	auto scopedFormulasA = translateInput(0, context);
+
+	std::vector<ast::ScopedFormula> scopedFormulasB;
+
+	try
+	{
+		scopedFormulasB = scopedFormulasBFuture.get();
+	}
+	catch (...)
+	{
+		context.logger.errorStream() << logB.str();
+		throw;
+	}
+
+	context.logger.errorStream() << logB.str();
+
+	// The second program’s AST nodes remain allocated from the arena of the thread that translated it
+	if (arenaB)
+		context.adoptedArenas.emplace_back(std::move(arenaB));
+
+	mergeDeclarations(context, contextB, scopedFormulasB);
+
+	return {std::move(scopedFormulasA), std::move(scopedFormulasB)};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Translates the inputs with the given indices according to the translation mode
+template<class TranslateInput>
+void translateInputs(size_t numberOfInputs, const TranslateInput &translateInput, Context &context)
+{
+	ArenaScope arenaScope(context.allocateFromArena ? &context.arena : nullptr);
+
+	if (numberOfInputs == 0)
+		throw TranslationException("no input files specified");
 
 	switch (context.translationMode)
 	{
 		case TranslationMode::Completion:
 		{
-			if (fileNames.size() > 1)
+			if (numberOfInputs > 1)
 				throw TranslationException("only one file may me translated at a time in completion mode");
 
-			auto scopedFormulas = translateSingleFile(fileNames.front());
+			auto scopedFormulas = translateInput(0, context);
 
 			translateCompletion(std::move(scopedFormulas), context);
 			break;
 		}
 		case TranslationMode::HereAndThere:
 		{
-			if (fileNames.size() > 2)
+			if (numberOfInputs > 2)
 				throw TranslationException("only one or two files may me translated at a time in here-and-there mode");
 
-			auto scopedFormulasA = translateSingleFile(fileNames.front());
-			auto scopedFormulasB = (fileNames.size() > 1)
-				? std::optional<std::vector<ast::ScopedFormula>>(translateSingleFile(fileNames[1]))
+			// The statement cache keeps track of one program at a time
+			if (numberOfInputs > 1 && context.parseConcurrently && !context.statementCache)
+			{
+				auto scopedFormulas = translateConcurrently(translateInput, context);
+
+				translateHereAndThere(std::move(scopedFormulas.first), std::move(scopedFormulas.second), context);
+				break;
+			}
+
+			auto scopedFormulasA = translateInput(0, context);
+			auto scopedFormulasB = (numberOfInputs > 1)
+				? std::optional<std::vector<ast::ScopedFormula>>(translateInput(1, context))
 				: std::nullopt;
 
 			translateHereAndThere(std::move(scopedFormulasA), std::move(scopedFormulasB), context);
 			break;
 		}
 	};
+
+	context.logger.outputStream().flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Streams the cached output of the programs if present, and otherwise translates and caches them
+void translateCached(const std::vector<ProgramText> &programs, Context &context)
+{
+	auto &translationCache = *context.translationCache;
+	const auto key = translationCache.key(programs, context);
+
+	auto &outputStream = context.logger.outputStream();
+
+	if (translationCache.load(key, outputStream.stream()))
+	{
+		outputStream.flush();
+		context.logger.log(output::Priority::Info) << "using cached output " << key;
+		return;
+	}
+
+	// The output is captured exactly as it would be written, including colors
+	std::stringstream capturedOutput;
+	output::ColorStream capturedOutputStream(capturedOutput);
+	capturedOutputStream.setColorPolicy(outputStream.supportsColor()
+		? output::ColorStream::ColorPolicy::Always
+		: output::ColorStream::ColorPolicy::Never);
+
+	std::swap(outputStream, capturedOutputStream);
+
+	const auto restoreOutputStream =
+		[&]()
+		{
+			std::swap(outputStream, capturedOutputStream);
+			outputStream.stream() << capturedOutput.str();
+			outputStream.flush();
+		};
+
+	try
+	{
+		translate(programs, context);
+	}
+	catch (...)
+	{
+		restoreOutputStream();
+		throw;
+	}
+
+	restoreOutputStream();
+
+	// Failing to cache the output doesn’t invalidate the translation
+	try
+	{
+		translationCache.store(key, capturedOutput.str());
+	}
+	catch (const std::exception &exception)
+	{
+		context.logger.log(output::Priority::Warning) << exception.what();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void translate(const std::vector<std::string> &fileNames, Context &context)
+{
+	// The inputs are read completely to compute the cache key before parsing them
+	if (context.translationCache)
+	{
+		std::vector<ProgramText> programs;
+		programs.reserve(fileNames.size());
+
+		for (const auto &fileName : fileNames)
+		{
+			std::ifstream file(fileName, std::ios::in | std::ios::binary);
+
+			if (!file.is_open())
+				throw LogicException("could not read file “" + fileName + "”");
+
+			programs.push_back({fileName, std::string(std::istreambuf_iterator<char>(file), {})});
+		}
+
+		translateCached(programs, context);
+		return;
+	}
+
+	translateInputs(fileNames.size(),
+		[&](size_t i, Context &inputContext)
+		{
+			return translateSingleFile(fileNames[i], inputContext);
+		},
+		context);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void translate(const std::vector<ProgramText> &programs, Context &context)
+{
+	translateInputs(programs.size(),
+		[&](size_t i, Context &inputContext)
+		{
+			const auto &program = programs[i];
+
+			inputContext.logger.log(output::Priority::Info) << "reading " << program.name;
+
+			const auto startTime = std::chrono::steady_clock::now();
+
+			return translateProgram(program.name.c_str(), program.text.c_str(), program.text.size(), false, startTime, inputContext);
+		},
+		context);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void translate(const char *fileName, std::istream &stream, Context &context)
 {
+	if (context.translationCache)
+	{
+		translateCached({{fileName, std::string(std::istreambuf_iterator<char>(stream), {})}}, context);
+		return;
+	}
+
+	ArenaScope arenaScope(context.allocateFromArena ? &context.arena : nullptr);
+
 	auto scopedFormulas = translateSingleStream(fileName, stream, context);
 
 	switch (context.translationMode)
@@ -807,6 +1134,8 @@ void translate(const char *fileName, std::istream &stream, Context &context)
 			break;
 		}
 	};
+
+	context.logger.outputStream().flush();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
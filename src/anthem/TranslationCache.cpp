@@ -0,0 +1,249 @@
+#include <anthem/TranslationCache.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <anthem/Context.h>
+#include <anthem/Exception.h>
+#include <anthem/SHA256.h>
+#include <anthem/Translation.h>
+#include <anthem/Version.h>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// TranslationCache
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Entries are named after SHA-256 hashes, so other files in the directory are left alone
+bool isEntryFileName(const char *fileName)
+{
+	return std::strlen(fileName) == 64 && std::strspn(fileName, "0123456789abcdef") == 64;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Creates the directory along with its missing parents
+void createDirectories(const std::string &directory)
+{
+	for (size_t position = 1; position <= directory.size(); position++)
+	{
+		if (position < directory.size() && directory[position] != '/')
+			continue;
+
+		const auto parent = directory.substr(0, position);
+
+		if (mkdir(parent.c_str(), 0777) != 0 && errno != EEXIST)
+			throw LogicException("could not create cache directory “" + directory + "”: " + std::strerror(errno));
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TranslationCache::TranslationCache(std::string directory, size_t maximumSize)
+:	m_directory{std::move(directory)},
+	m_maximumSize{maximumSize}
+{
+	createDirectories(m_directory);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::string TranslationCache::key(const std::vector<ProgramText> &programs, Context &context) const
+{
+	SHA256 hash;
+
+	// Outputs of other versions of anthem may differ
+	hash.update("anthem " + std::string(Version) + "\n");
+
+	std::stringstream options;
+	options
+		<< "translation mode " << static_cast<int>(context.translationMode) << "\n"
+		<< "output format " << static_cast<int>(context.outputFormat) << "\n"
+		<< "map-to-integers policy " << static_cast<int>(context.mapToIntegersPolicy) << "\n"
+		<< "simplify " << context.performSimplification << "\n"
+		<< "complete " << context.performCompletion << "\n"
+		<< "detect integers " << context.performIntegerDetection << "\n"
+		<< "abbreviation threshold " << context.abbreviationThreshold << "\n"
+		<< "parenthesis style " << static_cast<int>(context.parenthesisStyle) << "\n"
+		<< "color " << context.logger.outputStream().supportsColor() << "\n"
+		<< "programs " << programs.size() << "\n";
+
+	hash.update(options.str());
+
+	// The sizes separate the programs unambiguously
+	for (const auto &program : programs)
+	{
+		hash.update(std::to_string(program.text.size()) + "\n");
+		hash.update(program.text);
+	}
+
+	return hash.hexadecimalDigest();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool TranslationCache::load(const std::string &key, std::ostream &stream)
+{
+	const auto fileName = m_directory + "/" + key;
+
+	std::ifstream file(fileName, std::ios::in | std::ios::binary);
+
+	if (!file.is_open())
+	{
+		m_numberOfMisses++;
+		return false;
+	}
+
+	// Mark the entry as recently used
+	utimensat(AT_FDCWD, fileName.c_str(), nullptr, 0);
+
+	stream << file.rdbuf();
+
+	m_numberOfHits++;
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void TranslationCache::store(const std::string &key, const std::string &output)
+{
+	static std::atomic<size_t> numberOfTemporaryFiles{0};
+
+	// Entries only appear once they are complete, even if other processes read them concurrently
+	const auto temporaryFileName = m_directory + "/" + key + ".tmp-" + std::to_string(getpid()) + "-"
+		+ std::to_string(numberOfTemporaryFiles++);
+
+	{
+		std::ofstream file(temporaryFileName, std::ios::out | std::ios::trunc | std::ios::binary);
+		file << output;
+
+		if (!file.is_open() || !file.flush())
+		{
+			file.close();
+			unlink(temporaryFileName.c_str());
+			throw LogicException("could not write cache entry “" + temporaryFileName + "”");
+		}
+	}
+
+	if (rename(temporaryFileName.c_str(), (m_directory + "/" + key).c_str()) != 0)
+	{
+		unlink(temporaryFileName.c_str());
+		throw LogicException("could not write cache entry “" + key + "”: " + std::strerror(errno));
+	}
+
+	m_numberOfStoredEntries++;
+
+	evict();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::vector<TranslationCache::Entry> TranslationCache::entries() const
+{
+	std::vector<Entry> entries;
+
+	auto *directory = opendir(m_directory.c_str());
+
+	if (directory == nullptr)
+		return entries;
+
+	while (const auto *directoryEntry = readdir(directory))
+	{
+		if (!isEntryFileName(directoryEntry->d_name))
+			continue;
+
+		auto fileName = m_directory + "/" + directoryEntry->d_name;
+
+		struct stat fileStatus;
+
+		// Entries may have been removed by other processes in the meantime
+		if (stat(fileName.c_str(), &fileStatus) != 0 || !S_ISREG(fileStatus.st_mode))
+			continue;
+
+		const auto lastUsed = static_cast<int64_t>(fileStatus.st_mtim.tv_sec) * 1000000000 + fileStatus.st_mtim.tv_nsec;
+
+		entries.push_back({std::move(fileName), static_cast<size_t>(fileStatus.st_size), lastUsed});
+	}
+
+	closedir(directory);
+
+	return entries;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void TranslationCache::evict()
+{
+	std::lock_guard<std::mutex> lock(m_evictionMutex);
+
+	auto entries = this->entries();
+
+	size_t size = 0;
+
+	for (const auto &entry : entries)
+		size += entry.size;
+
+	if (size <= m_maximumSize)
+		return;
+
+	std::sort(entries.begin(), entries.end(),
+		[](const auto &entry, const auto &otherEntry)
+		{
+			return entry.lastUsed < otherEntry.lastUsed;
+		});
+
+	for (const auto &entry : entries)
+	{
+		if (size <= m_maximumSize)
+			break;
+
+		if (unlink(entry.fileName.c_str()) == 0)
+		{
+			m_numberOfEvictedEntries++;
+			m_evictedSize += entry.size;
+		}
+
+		size -= entry.size;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void TranslationCache::printStatistics(output::ColorStream &stream) const
+{
+	const auto entries = this->entries();
+
+	size_t size = 0;
+
+	for (const auto &entry : entries)
+		size += entry.size;
+
+	stream << output::Keyword("translation cache") << ": " << m_directory << std::endl;
+	stream
+		<< "  " << output::Number<size_t>(m_numberOfHits) << " hits, "
+		<< output::Number<size_t>(m_numberOfMisses) << " misses, "
+		<< output::Number<size_t>(m_numberOfStoredEntries) << " stored entries" << std::endl;
+	stream
+		<< "  " << output::Number<size_t>(m_numberOfEvictedEntries) << " evicted entries ("
+		<< output::Number<size_t>(m_evictedSize) << " bytes)" << std::endl;
+	stream
+		<< "  " << output::Number<size_t>(entries.size()) << " entries, "
+		<< output::Number<size_t>(size) << " of " << output::Number<size_t>(m_maximumSize) << " bytes used" << std::endl;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,230 @@
+#include <anthem/Watcher.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <anthem/Exception.h>
+#include <anthem/StatementCache.h>
+#include <anthem/Translation.h>
+
+namespace anthem
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Watcher
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Editors often write files in several steps, so changes are only reported once no further events
+// arrived for this long
+constexpr int SettleTimeMilliseconds = 10;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Watcher::Watcher(std::vector<std::string> fileNames, Context &context)
+:	m_fileNames{std::move(fileNames)},
+	m_context{context},
+	m_statementCache{std::make_shared<StatementCache>()}
+{
+	if (m_fileNames.empty())
+		throw LogicException("no input files to watch");
+
+	m_inotifyFileDescriptor = inotify_init1(IN_CLOEXEC);
+
+	if (m_inotifyFileDescriptor < 0)
+		throw LogicException(std::string("could not watch input files: ") + std::strerror(errno));
+
+	// Watch the directories rather than the files themselves, because many editors replace files
+	// instead of writing to them
+	for (const auto &fileName : m_fileNames)
+	{
+		const auto separatorPosition = fileName.find_last_of('/');
+		const auto directoryName = (separatorPosition == std::string::npos)
+			? std::string(".")
+			: fileName.substr(0, separatorPosition + 1);
+		const auto baseName = (separatorPosition == std::string::npos)
+			? fileName
+			: fileName.substr(separatorPosition + 1);
+
+		const auto watchDescriptor = inotify_add_watch(m_inotifyFileDescriptor, directoryName.c_str(),
+			IN_CLOSE_WRITE | IN_MOVED_TO);
+
+		if (watchDescriptor < 0)
+		{
+			const auto error = errno;
+			close(m_inotifyFileDescriptor);
+			throw LogicException("could not watch input file “" + fileName + "”: " + std::strerror(error));
+		}
+
+		m_watchedFiles.emplace(watchDescriptor, baseName);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Watcher::~Watcher()
+{
+	close(m_inotifyFileDescriptor);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Watcher::translate()
+{
+	const auto startTime = std::chrono::steady_clock::now();
+
+	auto &outputStream = m_context.logger.outputStream();
+	auto &errorStream = m_context.logger.errorStream();
+
+	Context translationContext{output::Logger(output::ColorStream(outputStream.stream()),
+		output::ColorStream(errorStream.stream()))};
+
+	const auto colorPolicy =
+		[](const output::ColorStream &colorStream)
+		{
+			return colorStream.supportsColor()
+				? output::ColorStream::ColorPolicy::Always
+				: output::ColorStream::ColorPolicy::Never;
+		};
+
+	translationContext.logger.outputStream().setColorPolicy(colorPolicy(outputStream));
+	translationContext.logger.errorStream().setColorPolicy(colorPolicy(errorStream));
+	translationContext.logger.setLogPriority(m_context.logger.logPriority());
+	translationContext.logger.outputStream().enableBuffering();
+	translationContext.copyOptions(m_context);
+	// The files being watched are edited in place, possibly while they are read
+	translationContext.mapInputFiles = false;
+	translationContext.translationCache = m_context.translationCache;
+	translationContext.statementCache = m_statementCache;
+	translationContext.arena.reclaim(m_spareArena);
+
+	const auto numberOfStatements = m_statementCache->totalNumberOfStatements();
+	const auto numberOfTranslatedStatements = m_statementCache->totalNumberOfTranslatedStatements();
+
+	try
+	{
+		anthem::translate(m_fileNames, translationContext);
+
+		if (translationContext.collectStatistics)
+			translationContext.statistics.print(translationContext.logger.errorStream());
+	}
+	catch (const std::exception &exception)
+	{
+		translationContext.logger.log(output::Priority::Error) << exception.what();
+	}
+
+	translationContext.logger.outputStream().flush();
+
+	// Logged by the watcher rather than along with the translation, as it depends on the previous translations
+	const auto numberOfTranslationStatements = m_statementCache->totalNumberOfStatements() - numberOfStatements;
+	const auto numberOfReusedStatements = numberOfTranslationStatements
+		- (m_statementCache->totalNumberOfTranslatedStatements() - numberOfTranslatedStatements);
+
+	m_context.logger.log(output::Priority::Info) << "reused the translations of " << numberOfReusedStatements
+		<< " of " << numberOfTranslationStatements << " statements";
+
+	// Keep as much memory for the next translation as this translation’s own arena used
+	translationContext.arena.trim(0);
+	const auto retainedCapacity = translationContext.arena.capacity();
+
+	m_spareArena.reclaim(translationContext.arena);
+
+	for (auto &adoptedArena : translationContext.adoptedArenas)
+		m_spareArena.reclaim(*adoptedArena);
+
+	m_spareArena.trim(retainedCapacity);
+
+	const auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+	m_context.logger.log(output::Priority::Info) << "translated in " << time.count() << " ms";
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool Watcher::readEvents()
+{
+	alignas(inotify_event) char buffer[4096];
+
+	const auto size = read(m_inotifyFileDescriptor, buffer, sizeof(buffer));
+
+	if (size < 0)
+	{
+		if (errno == EINTR || errno == EAGAIN)
+			return false;
+
+		throw LogicException(std::string("could not watch input files: ") + std::strerror(errno));
+	}
+
+	bool isChanged = false;
+
+	for (ssize_t position = 0; position < size;)
+	{
+		const auto *event = reinterpret_cast<const inotify_event *>(buffer + position);
+		position += sizeof(inotify_event) + event->len;
+
+		if (event->len == 0)
+			continue;
+
+		if (m_watchedFiles.count({event->wd, std::string(event->name)}) > 0)
+			isChanged = true;
+	}
+
+	return isChanged;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool Watcher::waitForChange(int timeoutMilliseconds)
+{
+	bool isChanged = false;
+	auto timeout = timeoutMilliseconds;
+
+	while (true)
+	{
+		pollfd pollFileDescriptor{m_inotifyFileDescriptor, POLLIN, 0};
+
+		const auto result = poll(&pollFileDescriptor, 1, timeout);
+
+		if (result < 0)
+		{
+			if (errno == EINTR)
+				continue;
+
+			throw LogicException(std::string("could not watch input files: ") + std::strerror(errno));
+		}
+
+		if (result == 0)
+			return isChanged;
+
+		if (readEvents())
+		{
+			isChanged = true;
+			timeout = SettleTimeMilliseconds;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Watcher::watch()
+{
+	translate();
+
+	while (true)
+	{
+		waitForChange();
+
+		m_context.logger.log(output::Priority::Info) << "input files changed, translating again";
+
+		translate();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -56,8 +56,8 @@ Logger::Logger(ColorStream &&outputStream)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 Logger::Logger(ColorStream &&outputStream, ColorStream &&errorStream)
-:	m_outputStream{outputStream},
-	m_errorStream{errorStream},
+:	m_outputStream{std::move(outputStream)},
+	m_errorStream{std::move(errorStream)},
 	m_logPriority{Priority::Warning}
 {
 }
@@ -78,6 +78,13 @@ ColorStream &Logger::errorStream()
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+Priority Logger::logPriority() const
+{
+	return m_logPriority;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void Logger::setLogPriority(Priority logPriority)
 {
 	m_logPriority = logPriority;
@@ -100,6 +107,9 @@ FormatScope Logger::log(Priority priority)
 	if (priorityID < static_cast<int>(m_logPriority))
 		return FormatScope(detail::nullStream);
 
+	// Buffered output must not fall behind the messages on the error stream
+	m_outputStream.flush();
+
 	m_errorStream
 		<< priorityFormat(priority) << priorityName(priority) << ":"
 		<< ResetFormat() << " "
@@ -117,6 +127,9 @@ FormatScope Logger::log(Priority priority, const Location &location)
 	if (priorityID < static_cast<int>(m_logPriority))
 		return FormatScope(detail::nullStream);
 
+	// Buffered output must not fall behind the messages on the error stream
+	m_outputStream.flush();
+
 	m_errorStream
 		<< LocationFormat
 		<< location.sectionStart << ":" << location.rowStart << ":" << location.columnStart << ":"
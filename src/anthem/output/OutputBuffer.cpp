@@ -0,0 +1,103 @@
+#include <anthem/output/OutputBuffer.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace anthem
+{
+namespace output
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// OutputBuffer
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+OutputBuffer::OutputBuffer(std::streambuf *target, size_t size)
+:	m_target{target},
+	m_buffer(std::max(size, size_t(1)))
+{
+	setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+OutputBuffer::~OutputBuffer()
+{
+	sync();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+OutputBuffer::int_type OutputBuffer::overflow(int_type character)
+{
+	if (!writeBufferedData())
+		return traits_type::eof();
+
+	if (traits_type::eq_int_type(character, traits_type::eof()))
+		return traits_type::not_eof(character);
+
+	*pptr() = traits_type::to_char_type(character);
+	pbump(1);
+
+	return character;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+std::streamsize OutputBuffer::xsputn(const char_type *data, std::streamsize size)
+{
+	const auto remainingSize = static_cast<std::streamsize>(epptr() - pptr());
+
+	if (size <= remainingSize)
+	{
+		std::memcpy(pptr(), data, size);
+		pbump(static_cast<int>(size));
+
+		return size;
+	}
+
+	if (!writeBufferedData())
+		return 0;
+
+	// Data that wouldn’t fit into the buffer anyway is passed on directly
+	if (size >= static_cast<std::streamsize>(m_buffer.size()))
+		return m_target->sputn(data, size);
+
+	std::memcpy(pptr(), data, size);
+	pbump(static_cast<int>(size));
+
+	return size;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int OutputBuffer::sync()
+{
+	if (!writeBufferedData())
+		return -1;
+
+	return m_target->pubsync();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool OutputBuffer::writeBufferedData()
+{
+	const auto size = static_cast<std::streamsize>(pptr() - pbase());
+
+	if (size == 0)
+		return true;
+
+	const auto writtenSize = m_target->sputn(pbase(), size);
+
+	setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+
+	return (writtenSize == size);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+}
+}
@@ -0,0 +1,227 @@
+#include <catch2/catch.hpp>
+
+#include <thread>
+
+#include <anthem/Arena.h>
+#include <anthem/ThreadPool.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct SmallObject : public anthem::ArenaAllocated
+{
+	int value{0};
+};
+
+struct LargeObject : public anthem::ArenaAllocated
+{
+	std::byte data[2 * anthem::Arena::MaximumAllocationSize];
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[arena] Memory is recycled by size class", "[arena]")
+{
+	using namespace anthem;
+
+	Arena arena;
+
+	auto *block = arena.allocate(24);
+	CHECK(arena.capacity() > 0);
+
+	const auto capacity = arena.capacity();
+
+	SECTION("freed blocks are reused for sizes of the same class")
+	{
+		arena.deallocate(block, 24);
+
+		CHECK(arena.allocate(32) == block);
+		CHECK(arena.capacity() == capacity);
+	}
+
+	SECTION("freed blocks are not reused for sizes of other classes")
+	{
+		arena.deallocate(block, 24);
+
+		auto *otherBlock = arena.allocate(48);
+
+		CHECK(otherBlock != block);
+		CHECK(arena.allocate(17) == block);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[arena] Objects are allocated from the active arena", "[arena]")
+{
+	using namespace anthem;
+
+	Arena arena;
+
+	SECTION("without active arena, objects are allocated from the heap")
+	{
+		auto *object = new SmallObject;
+		delete object;
+
+		CHECK(arena.capacity() == 0);
+	}
+
+	SECTION("large objects are allocated from the heap")
+	{
+		ArenaScope arenaScope(&arena);
+
+		auto *object = new LargeObject;
+		delete object;
+
+		CHECK(arena.capacity() == 0);
+	}
+
+	SECTION("small objects are allocated from the active arena and recycled when deleted")
+	{
+		ArenaScope arenaScope(&arena);
+
+		auto *object = new SmallObject;
+		CHECK(arena.capacity() > 0);
+
+		delete object;
+
+		auto *recycledObject = new SmallObject;
+		CHECK(recycledObject == object);
+
+		delete recycledObject;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[arena] Objects deleted outside of their arena are not recycled", "[arena]")
+{
+	using namespace anthem;
+
+	Arena arena;
+	Arena otherArena;
+
+	SmallObject *object = nullptr;
+
+	{
+		ArenaScope arenaScope(&arena);
+		object = new SmallObject;
+	}
+
+	SECTION("while another arena is active")
+	{
+		{
+			ArenaScope arenaScope(&otherArena);
+			delete object;
+
+			auto *otherObject = new SmallObject;
+			CHECK(otherObject != object);
+			delete otherObject;
+		}
+
+		ArenaScope arenaScope(&arena);
+
+		auto *newObject = new SmallObject;
+		CHECK(newObject != object);
+		delete newObject;
+	}
+
+	SECTION("on another thread")
+	{
+		// The arena is only active on this thread
+		ArenaScope arenaScope(&arena);
+
+		std::thread thread(
+			[&]()
+			{
+				delete object;
+			});
+		thread.join();
+
+		auto *newObject = new SmallObject;
+		CHECK(newObject != object);
+		delete newObject;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[arena] Arenas reclaim the memory of other arenas", "[arena]")
+{
+	using namespace anthem;
+
+	Arena arena;
+	Arena otherArena;
+
+	otherArena.allocate(64);
+	const auto capacity = otherArena.capacity();
+
+	arena.reclaim(otherArena);
+
+	CHECK(otherArena.capacity() == 0);
+	CHECK(arena.capacity() == capacity);
+
+	// Reclaimed chunks are used before requesting new ones
+	arena.allocate(64);
+	CHECK(arena.capacity() == capacity);
+
+	// Reclaimed arenas start over
+	otherArena.allocate(64);
+	CHECK(otherArena.capacity() == capacity);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[arena] Trimming releases reclaimed chunks only", "[arena]")
+{
+	using namespace anthem;
+
+	Arena arena;
+	Arena otherArena;
+
+	arena.allocate(64);
+	otherArena.allocate(64);
+	otherArena.allocate(Arena::MaximumAllocationSize);
+
+	const auto capacity = arena.capacity();
+
+	arena.reclaim(otherArena);
+	CHECK(arena.capacity() > capacity);
+
+	arena.trim(0);
+	CHECK(arena.capacity() == capacity);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[arena] Worker threads allocate from arenas of their own", "[arena]")
+{
+	using namespace anthem;
+
+	Arena arena;
+	std::vector<std::unique_ptr<Arena>> workerArenas;
+	std::vector<SmallObject *> objects(64, nullptr);
+
+	{
+		ArenaScope arenaScope(&arena);
+		ThreadPool threadPool(4, &workerArenas);
+
+		threadPool.forEachIndex(objects.size(),
+			[&](size_t i)
+			{
+				// Objects deleted on the same thread are recycled
+				auto *temporaryObject = new SmallObject;
+				delete temporaryObject;
+
+				objects[i] = new SmallObject;
+				CHECK(objects[i] == temporaryObject);
+			});
+
+		CHECK(Arena::active() == &arena);
+	}
+
+	// The worker arenas outlive the pool along with the objects allocated from them
+	CHECK(workerArenas.size() == 3);
+
+	for (auto *object : objects)
+		delete object;
+}
@@ -0,0 +1,162 @@
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <anthem/Batch.h>
+#include <anthem/Context.h>
+#include <anthem/Exception.h>
+#include <anthem/Translation.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[batch] Batch manifests are read line by line", "[batch]")
+{
+	using namespace anthem;
+
+	SECTION("jobs consist of input files followed by the output file")
+	{
+		std::stringstream manifest;
+		manifest << "# comment\n\na.lp b.lp a-b.txt\n  c.lp\tc.txt  \n";
+
+		const auto jobs = readBatchJobs("manifest", manifest);
+
+		REQUIRE(jobs.size() == 2);
+		CHECK(jobs[0].inputFileNames == std::vector<std::string>{"a.lp", "b.lp"});
+		CHECK(jobs[0].outputFileName == "a-b.txt");
+		CHECK(jobs[1].inputFileNames == std::vector<std::string>{"c.lp"});
+		CHECK(jobs[1].outputFileName == "c.txt");
+	}
+
+	SECTION("jobs without output file are rejected")
+	{
+		std::stringstream manifest;
+		manifest << "a.lp b.lp a-b.txt\na.lp\n";
+
+		CHECK_THROWS_AS(readBatchJobs("manifest", manifest), LogicException);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[batch] Batch jobs produce the same output as separate translations", "[batch]")
+{
+	using namespace anthem;
+
+	const auto temporaryFileName =
+		[]()
+		{
+			char fileName[] = "/tmp/anthem-test-XXXXXX";
+			const auto fileDescriptor = mkstemp(fileName);
+			REQUIRE(fileDescriptor >= 0);
+			close(fileDescriptor);
+
+			return std::string(fileName);
+		};
+
+	const auto readFile =
+		[](const std::string &fileName)
+		{
+			std::ifstream file(fileName, std::ios::in);
+
+			return std::string(std::istreambuf_iterator<char>(file), {});
+		};
+
+	const char *programs[] = {"p(1..3).\nq(X) :- p(X).\n", "q(X) :- p(X).\np(1..3).\n", "p(X) :- not q(X), X = 1.\n"};
+
+	std::vector<std::string> programFileNames;
+
+	for (const auto *program : programs)
+	{
+		programFileNames.emplace_back(temporaryFileName());
+
+		std::ofstream file(programFileNames.back(), std::ios::out | std::ios::trunc);
+		file << program;
+	}
+
+	std::vector<BatchJob> jobs;
+	jobs.push_back({{programFileNames[0], programFileNames[1]}, temporaryFileName()});
+	jobs.push_back({{programFileNames[1], programFileNames[2]}, temporaryFileName()});
+	jobs.push_back({{programFileNames[2]}, temporaryFileName()});
+
+	std::stringstream errors;
+	Context context(output::Logger(errors, errors));
+	context.translationMode = TranslationMode::HereAndThere;
+	context.numberOfThreads = 2;
+
+	CHECK(runBatchJobs(jobs, context) == 0);
+
+	for (const auto &job : jobs)
+	{
+		std::stringstream output;
+		Context jobContext(output::Logger(output, errors));
+		jobContext.translationMode = TranslationMode::HereAndThere;
+
+		translate(job.inputFileNames, jobContext);
+
+		CHECK(!output.str().empty());
+		CHECK(readFile(job.outputFileName) == output.str());
+
+		std::remove(job.outputFileName.c_str());
+	}
+
+	for (const auto &fileName : programFileNames)
+		std::remove(fileName.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[batch] Failed batch jobs leave no output files behind", "[batch]")
+{
+	using namespace anthem;
+
+	char directoryName[] = "/tmp/anthem-test-XXXXXX";
+	REQUIRE(mkdtemp(directoryName) != nullptr);
+
+	const auto directory = std::string(directoryName);
+
+	const auto directoryEntries =
+		[&]()
+		{
+			std::vector<std::string> entries;
+
+			auto *directoryStream = opendir(directory.c_str());
+			REQUIRE(directoryStream != nullptr);
+
+			while (const auto *entry = readdir(directoryStream))
+				if (entry->d_name[0] != '.')
+					entries.emplace_back(entry->d_name);
+
+			closedir(directoryStream);
+
+			return entries;
+		};
+
+	{
+		std::ofstream file(directory + "/existing.txt", std::ios::out | std::ios::trunc);
+		file << "previous output\n";
+	}
+
+	std::vector<BatchJob> jobs;
+	jobs.push_back({{directory + "/missing.lp"}, directory + "/new.txt"});
+	jobs.push_back({{directory + "/missing.lp"}, directory + "/existing.txt"});
+
+	std::stringstream errors;
+	Context context(output::Logger(errors, errors));
+	context.numberOfThreads = 2;
+
+	CHECK(runBatchJobs(jobs, context) == 2);
+
+	// Neither output files nor temporary files are left behind, and existing files are kept
+	CHECK(directoryEntries() == std::vector<std::string>{"existing.txt"});
+
+	std::ifstream file(directory + "/existing.txt", std::ios::in);
+	CHECK(std::string(std::istreambuf_iterator<char>(file), {}) == "previous output\n");
+
+	std::remove((directory + "/existing.txt").c_str());
+	rmdir(directory.c_str());
+}
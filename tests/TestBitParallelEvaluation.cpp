@@ -0,0 +1,143 @@
+#include <catch2/catch.hpp>
+
+#include <anthem/AST.h>
+#include <anthem/BitParallelEvaluation.h>
+#include <anthem/Context.h>
+#include <anthem/Evaluation.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Makes one variable symbolic per lane
+struct SymbolicVariablesAccessor
+{
+	anthem::TypeLanes operator()(const anthem::ast::Variable &variable,
+		const std::vector<anthem::ast::VariableDeclaration *> &symbolicVariables)
+	{
+		using namespace anthem;
+
+		if (variable.declaration->domain != Domain::Unknown)
+			return TypeLanes::broadcast({variable.declaration->domain, SetSize::Unit});
+
+		Lanes symbolicLanes = 0;
+
+		for (size_t i = 0; i < symbolicVariables.size(); i++)
+			if (symbolicVariables[i] == variable.declaration)
+				symbolicLanes |= Lanes(1) << i;
+
+		auto typeLanes = TypeLanes::broadcast({Domain::Symbolic, SetSize::Unit}, symbolicLanes);
+		typeLanes.add({Domain::Unknown, SetSize::Unit}, ~symbolicLanes);
+
+		return typeLanes;
+	}
+};
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[bit-parallel evaluation] Each lane is evaluated like a single formula", "[bit-parallel evaluation]")
+{
+	using namespace anthem;
+
+	Context context;
+
+	auto *p = context.findOrCreatePredicateDeclaration("p", 2);
+	p->parameters[0].domain = Domain::Integer;
+
+	auto *c = context.findOrCreateFunctionDeclaration("c", 0);
+
+	// forall X, Y, N ((p(X, Y) and not X = N + 1) or (Y in 1..3 -> exists Z (Z < Y or Z = c)) <-> Y in X..N)
+	ast::VariableDeclarationPointers forAllVariables;
+	forAllVariables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::UserDefined));
+	auto *x = forAllVariables.back().get();
+	forAllVariables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::UserDefined));
+	auto *y = forAllVariables.back().get();
+	forAllVariables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::UserDefined, Domain::Integer, "N"));
+	auto *n = forAllVariables.back().get();
+
+	ast::VariableDeclarationPointers existsVariables;
+	existsVariables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::Body));
+	auto *z = existsVariables.back().get();
+
+	std::vector<ast::Term> pArguments;
+	pArguments.emplace_back(ast::Variable(x));
+	pArguments.emplace_back(ast::Variable(y));
+
+	std::vector<ast::Formula> andArguments;
+	andArguments.emplace_back(ast::Predicate(p, std::move(pArguments)));
+	andArguments.emplace_back(ast::Not(ast::Comparison(ast::Comparison::Operator::Equal, ast::Variable(x),
+		ast::BinaryOperation(ast::BinaryOperation::Operator::Plus, ast::Variable(n), ast::Integer(1)))));
+
+	std::vector<ast::Formula> innerOrArguments;
+	innerOrArguments.emplace_back(ast::Comparison(ast::Comparison::Operator::LessThan, ast::Variable(z), ast::Variable(y)));
+	innerOrArguments.emplace_back(ast::Comparison(ast::Comparison::Operator::Equal, ast::Variable(z), ast::Function(c)));
+
+	std::vector<ast::Formula> orArguments;
+	orArguments.emplace_back(ast::And(std::move(andArguments)));
+	orArguments.emplace_back(ast::Implies(ast::In(ast::Variable(y), ast::Interval(ast::Integer(1), ast::Integer(3))),
+		ast::Exists(std::move(existsVariables), ast::Or(std::move(innerOrArguments)))));
+
+	ast::Formula formula = ast::ForAll(std::move(forAllVariables),
+		ast::Biconditional(ast::Or(std::move(orArguments)), ast::In(ast::Variable(y), ast::Interval(ast::Variable(x), ast::Variable(n)))));
+
+	const std::vector<ast::VariableDeclaration *> symbolicVariables = {x, y, z};
+
+	const auto checkLanes =
+		[&](const ast::Formula &formula)
+		{
+			const auto result = evaluateLanes<SymbolicVariablesAccessor>(formula, symbolicVariables);
+
+			for (size_t lane = 0; lane < symbolicVariables.size(); lane++)
+			{
+				symbolicVariables[lane]->domain = Domain::Symbolic;
+				CHECK(result[lane] == evaluate(formula));
+				symbolicVariables[lane]->domain = Domain::Unknown;
+			}
+
+			// Lanes without hypotheses
+			CHECK(result[symbolicVariables.size()] == evaluate(formula));
+			CHECK(result[NumberOfLanes - 1] == evaluate(formula));
+		};
+
+	SECTION("whole formula")
+	{
+		checkLanes(formula);
+	}
+
+	SECTION("subformulas")
+	{
+		const auto &biconditional = formula.get<ast::ForAll>().argument.get<ast::Biconditional>();
+		const auto &or_ = biconditional.left.get<ast::Or>();
+
+		checkLanes(biconditional.right);
+
+		for (const auto &argument : or_.arguments)
+			checkLanes(argument);
+
+		for (const auto &argument : or_.arguments.front().get<ast::And>().arguments)
+			checkLanes(argument);
+	}
+
+	SECTION("result encoding")
+	{
+		auto result = EvaluationResultLanes::broadcast(EvaluationResult::Unknown);
+		result.add(EvaluationResult::True, 1);
+		result.add(EvaluationResult::False, 2);
+		result.add(EvaluationResult::Error, 4);
+
+		CHECK(result[0] == EvaluationResult::True);
+		CHECK(result[1] == EvaluationResult::False);
+		CHECK(result[2] == EvaluationResult::Error);
+		CHECK(result[3] == EvaluationResult::Unknown);
+
+		const auto negatedResult = evaluateNotLanes(result);
+
+		CHECK(negatedResult[0] == EvaluationResult::False);
+		CHECK(negatedResult[1] == EvaluationResult::True);
+		CHECK(negatedResult[2] == EvaluationResult::Error);
+		CHECK(negatedResult[3] == EvaluationResult::Unknown);
+	}
+}
@@ -193,4 +193,24 @@ TEST_CASE("[completion] Rules are completed", "[completion]")
 
 		CHECK(output.str() == "forall V1, V2 (adj(V1, V2) <-> (V1 in (1..n) and V2 in (1..n) and |V1 - V2| = 1))\n");
 	}
+
+	SECTION("multiple threads")
+	{
+		context.numberOfThreads = 4;
+
+		input <<
+			"p :- s.\n"
+			"q :- t.\n"
+			"p :- q.\n"
+			"r :- t.\n"
+			"q :- r.";
+		anthem::translate("input", input, context);
+
+		CHECK(output.str() ==
+			"(p <-> (s or q))\n"
+			"(q <-> (t or r))\n"
+			"(r <-> t)\n"
+			"not s\n"
+			"not t\n");
+	}
 }
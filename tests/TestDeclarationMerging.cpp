@@ -0,0 +1,120 @@
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <unistd.h>
+
+#include <anthem/AST.h>
+#include <anthem/Context.h>
+#include <anthem/DeclarationMerging.h>
+#include <anthem/Translation.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[declaration merging] Declarations of separately translated programs are merged", "[declaration merging]")
+{
+	using namespace anthem;
+
+	Context context;
+	Context otherContext;
+
+	auto *p = context.findOrCreatePredicateDeclaration("p", 1);
+	auto *f = context.findOrCreateFunctionDeclaration("f", 0);
+	f->domain = Domain::Integer;
+
+	auto *otherQ = otherContext.findOrCreatePredicateDeclaration("q", 0);
+	auto *otherP = otherContext.findOrCreatePredicateDeclaration("p", 1);
+	auto *otherF = otherContext.findOrCreateFunctionDeclaration("f", 0);
+	otherP->isUsed = true;
+	otherP->visibility = ast::PredicateDeclaration::Visibility::Visible;
+	otherContext.showStatementsUsed = true;
+	otherContext.defaultPredicateVisibility = ast::PredicateDeclaration::Visibility::Hidden;
+
+	std::vector<ast::Term> arguments;
+	arguments.emplace_back(ast::Function(otherF));
+
+	std::vector<ast::ScopedFormula> otherScopedFormulas;
+	otherScopedFormulas.emplace_back(ast::Implies(ast::Predicate(otherQ), ast::Predicate(otherP, std::move(arguments))),
+		ast::VariableDeclarationPointers());
+
+	mergeDeclarations(context, otherContext, otherScopedFormulas);
+
+	SECTION("new declarations are appended in order")
+	{
+		REQUIRE(context.predicateDeclarations.size() == 2);
+		CHECK(context.predicateDeclarations[0].get() == p);
+		CHECK(context.predicateDeclarations[1]->name == "q");
+		CHECK(context.functionDeclarations.size() == 1);
+	}
+
+	SECTION("attributes are combined")
+	{
+		CHECK(p->isUsed);
+		CHECK(p->visibility == ast::PredicateDeclaration::Visibility::Visible);
+		CHECK(f->domain == Domain::Integer);
+		CHECK(context.showStatementsUsed);
+		CHECK(context.defaultPredicateVisibility == ast::PredicateDeclaration::Visibility::Hidden);
+	}
+
+	SECTION("formulas refer to the merged declarations")
+	{
+		const auto &implies = otherScopedFormulas.front().formula.get<ast::Implies>();
+		const auto &predicate = implies.consequent.get<ast::Predicate>();
+
+		CHECK(implies.antecedent.get<ast::Predicate>().declaration == context.predicateDeclarations[1].get());
+		CHECK(predicate.declaration == p);
+		CHECK(predicate.arguments.front().get<ast::Function>().declaration == f);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[declaration merging] Programs parsed concurrently are translated as if parsed in order", "[declaration merging]")
+{
+	using namespace anthem;
+
+	const auto writeTemporaryFile =
+		[](const char *content)
+		{
+			char fileName[] = "/tmp/anthem-test-XXXXXX";
+			const auto fileDescriptor = mkstemp(fileName);
+			REQUIRE(fileDescriptor >= 0);
+			close(fileDescriptor);
+
+			std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+			file << content;
+
+			return std::string(fileName);
+		};
+
+	const std::vector<std::string> fileNames =
+	{
+		writeTemporaryFile("#show p/1.\np(X) :- q(X), X = a.\n"),
+		writeTemporaryFile("#external q(1).\np(X) :- not not q(X), r.\nr.\n#show r/0.\n"),
+	};
+
+	const auto translate =
+		[&](bool parseConcurrently)
+		{
+			std::stringstream output;
+			std::stringstream errors;
+
+			Context context(output::Logger(output, errors));
+			context.translationMode = TranslationMode::HereAndThere;
+			context.parseConcurrently = parseConcurrently;
+
+			anthem::translate(fileNames, context);
+
+			return output.str();
+		};
+
+	const auto expected = translate(false);
+
+	CHECK(!expected.empty());
+	CHECK(translate(true) == expected);
+
+	for (const auto &fileName : fileNames)
+		std::remove(fileName.c_str());
+}
@@ -0,0 +1,173 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+
+#include <anthem/AST.h>
+#include <anthem/Context.h>
+#include <anthem/Equality.h>
+#include <anthem/Fingerprint.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[fingerprint] Fingerprints respect the symmetries of equality", "[fingerprint]")
+{
+	using namespace anthem;
+
+	Context context;
+
+	auto *p = context.findOrCreatePredicateDeclaration("p", 1);
+	auto *q = context.findOrCreatePredicateDeclaration("q", 1);
+
+	ast::VariableDeclaration x(ast::VariableDeclaration::Type::UserDefined);
+	ast::VariableDeclaration y(ast::VariableDeclaration::Type::UserDefined);
+
+	const auto predicate =
+		[](ast::PredicateDeclaration *declaration, ast::VariableDeclaration *variableDeclaration)
+		{
+			std::vector<ast::Term> arguments;
+			arguments.emplace_back(ast::Variable(variableDeclaration));
+
+			return ast::Formula(ast::Predicate(declaration, std::move(arguments)));
+		};
+
+	SECTION("conjunctions are compared regardless of order and repetition")
+	{
+		std::vector<ast::Formula> arguments;
+		arguments.emplace_back(predicate(p, &x));
+		arguments.emplace_back(predicate(q, &y));
+
+		std::vector<ast::Formula> otherArguments;
+		otherArguments.emplace_back(predicate(q, &y));
+		otherArguments.emplace_back(predicate(p, &x));
+		otherArguments.emplace_back(predicate(q, &y));
+
+		const ast::Formula and_ = ast::And(std::move(arguments));
+		const ast::Formula otherAnd = ast::And(std::move(otherArguments));
+
+		CHECK(ast::equal(and_, otherAnd) == Tristate::True);
+		CHECK(ast::fingerprint(and_) == ast::fingerprint(otherAnd));
+	}
+
+	SECTION("different formulas have different fingerprints")
+	{
+		CHECK(ast::fingerprint(predicate(p, &x)) != ast::fingerprint(predicate(q, &x)));
+		CHECK(ast::fingerprint(predicate(p, &x)) != ast::fingerprint(predicate(p, &y)));
+
+		const ast::Formula implies = ast::Implies(predicate(p, &x), predicate(q, &x));
+		const ast::Formula reversedImplies = ast::Implies(predicate(q, &x), predicate(p, &x));
+
+		CHECK(ast::fingerprint(implies) != ast::fingerprint(reversedImplies));
+	}
+
+	SECTION("bound variables may be renamed")
+	{
+		const auto exists =
+			[&]()
+			{
+				ast::VariableDeclarationPointers variables;
+				variables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::Body));
+				auto *variable = variables.back().get();
+
+				return ast::Formula(ast::Exists(std::move(variables), predicate(p, variable)));
+			};
+
+		CHECK(ast::fingerprint(exists()) == ast::fingerprint(exists()));
+		CHECK(ast::equal(exists(), exists()) == Tristate::True);
+	}
+
+	SECTION("quantified formulas are compared up to renaming the bound variables")
+	{
+		const auto forAll =
+			[&](bool isSwapped)
+			{
+				ast::VariableDeclarationPointers variables;
+				variables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::Body));
+				variables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::Body));
+				auto *first = variables[0].get();
+				auto *second = variables[1].get();
+
+				std::vector<ast::Formula> arguments;
+
+				for (size_t i = 0; i < 6; i++)
+					arguments.emplace_back(predicate((i % 2 == 0) ? p : q, (i < 3) ? first : second));
+
+				std::reverse(arguments.begin(), arguments.end());
+
+				ast::VariableDeclarationPointers innerVariables;
+				innerVariables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::Body));
+				auto *inner = innerVariables.back().get();
+				arguments.emplace_back(ast::Exists(std::move(innerVariables), predicate(p, isSwapped ? first : inner)));
+
+				return ast::Formula(ast::ForAll(std::move(variables), ast::And(std::move(arguments))));
+			};
+
+		const auto formula = forAll(false);
+		const auto renamedFormula = forAll(false);
+		const auto otherFormula = forAll(true);
+
+		ast::FingerprintCache fingerprintCache;
+
+		CHECK(ast::equal(formula, renamedFormula, fingerprintCache) == Tristate::True);
+		CHECK(ast::equal(formula, otherFormula, fingerprintCache) == Tristate::Unknown);
+		CHECK(ast::equal(formula, ast::Formula(ast::Boolean(true))) == Tristate::Unknown);
+
+		// Free variables aren’t renamed
+		ast::VariableDeclarationPointers variables;
+		variables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::Body));
+		const ast::Formula exists = ast::Exists(std::move(variables), predicate(p, &x));
+
+		ast::VariableDeclarationPointers otherVariables;
+		otherVariables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::Body));
+		const ast::Formula otherExists = ast::Exists(std::move(otherVariables), predicate(p, &y));
+
+		CHECK(ast::equal(exists, otherExists) == Tristate::Unknown);
+	}
+
+	SECTION("conjunctions with many arguments are matched through fingerprints")
+	{
+		const auto conjunction =
+			[&](bool isReversed, ast::VariableDeclaration *lastVariableDeclaration)
+			{
+				std::vector<ast::Formula> arguments;
+
+				for (size_t i = 0; i < 8; i++)
+				{
+					std::vector<ast::Formula> disjunctionArguments;
+					disjunctionArguments.emplace_back(predicate(p, (i % 2 == 0) ? &x : &y));
+					disjunctionArguments.emplace_back(predicate(q, (i == 7) ? lastVariableDeclaration : &x));
+					arguments.emplace_back(ast::Or(std::move(disjunctionArguments)));
+				}
+
+				if (isReversed)
+					std::reverse(arguments.begin(), arguments.end());
+
+				return ast::Formula(ast::And(std::move(arguments)));
+			};
+
+		const auto and_ = conjunction(false, &x);
+		const auto reversedAnd = conjunction(true, &x);
+		const auto otherAnd = conjunction(true, &y);
+
+		ast::FingerprintCache fingerprintCache;
+
+		CHECK(ast::equal(and_, reversedAnd, fingerprintCache) == Tristate::True);
+		CHECK(ast::equal(and_, otherAnd, fingerprintCache) == Tristate::Unknown);
+		CHECK(fingerprintCache.fingerprint(and_) == ast::fingerprint(and_));
+	}
+
+	SECTION("conjunctions with mismatching arguments are not equal")
+	{
+		std::vector<ast::Formula> arguments;
+		arguments.emplace_back(predicate(p, &x));
+		arguments.emplace_back(predicate(q, &x));
+
+		std::vector<ast::Formula> otherArguments;
+		otherArguments.emplace_back(predicate(p, &x));
+		otherArguments.emplace_back(predicate(q, &y));
+
+		const ast::Formula or_ = ast::Or(std::move(arguments));
+		const ast::Formula otherOr = ast::Or(std::move(otherArguments));
+
+		CHECK(ast::equal(or_, otherOr) == Tristate::Unknown);
+	}
+}
@@ -0,0 +1,383 @@
+#include <catch2/catch.hpp>
+
+#include <sstream>
+
+#include <anthem/AST.h>
+#include <anthem/Context.h>
+#include <anthem/Evaluation.h>
+#include <anthem/FlatAST.h>
+#include <anthem/Type.h>
+#include <anthem/output/FormatterHumanReadable.h>
+#include <anthem/output/FormatterTPTP.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+template<class Formatter, class Value>
+std::string printToString(const Value &value, const anthem::Context &context)
+{
+	std::stringstream output;
+	anthem::output::ColorStream stream(output);
+	anthem::output::PrintContext printContext(context);
+
+	anthem::output::print<Formatter>(stream, value, printContext);
+
+	return output.str();
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[flat AST] Flat ASTs are equivalent to the pointer-linked AST", "[flat AST]")
+{
+	using namespace anthem;
+
+	Context context;
+
+	auto *p = context.findOrCreatePredicateDeclaration("p", 2);
+	auto *q = context.findOrCreatePredicateDeclaration("q", 1);
+	auto *f = context.findOrCreateFunctionDeclaration("f", 1);
+
+	// Free variable, referenced by the flat AST
+	ast::VariableDeclaration y(ast::VariableDeclaration::Type::Head);
+
+	// forall X (p(X, 1..3) and not q(f(Y)) -> exists Z (X = |Z| or q(#sup)))
+	ast::VariableDeclarationPointers forAllVariables;
+	forAllVariables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::UserDefined));
+	auto *x = forAllVariables.back().get();
+
+	ast::VariableDeclarationPointers existsVariables;
+	existsVariables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::Body));
+	auto *z = existsVariables.back().get();
+
+	std::vector<ast::Term> pArguments;
+	pArguments.emplace_back(ast::Variable(x));
+	pArguments.emplace_back(ast::Interval(ast::Integer(1), ast::Integer(3)));
+
+	std::vector<ast::Term> fArguments;
+	fArguments.emplace_back(ast::Variable(&y));
+
+	std::vector<ast::Term> qArguments;
+	qArguments.emplace_back(ast::Function(f, std::move(fArguments)));
+
+	std::vector<ast::Formula> andArguments;
+	andArguments.emplace_back(ast::Predicate(p, std::move(pArguments)));
+	andArguments.emplace_back(ast::Not(ast::Predicate(q, std::move(qArguments))));
+
+	std::vector<ast::Term> q2Arguments;
+	q2Arguments.emplace_back(ast::SpecialInteger(ast::SpecialInteger::Type::Supremum));
+
+	std::vector<ast::Formula> orArguments;
+	orArguments.emplace_back(ast::Comparison(ast::Comparison::Operator::Equal, ast::Variable(x),
+		ast::UnaryOperation(ast::UnaryOperation::Operator::Absolute, ast::Variable(z))));
+	orArguments.emplace_back(ast::Predicate(q, std::move(q2Arguments)));
+
+	ast::Formula formula = ast::ForAll(std::move(forAllVariables),
+		ast::Implies(ast::And(std::move(andArguments)), ast::Exists(std::move(existsVariables), ast::Or(std::move(orArguments)))));
+
+	flat::Tree tree;
+	const auto root = tree.add(formula);
+
+	SECTION("nodes are stored in preorder")
+	{
+		CHECK(tree.type(root) == flat::NodeType::ForAll);
+		CHECK(tree.children(root).size() == 2);
+		CHECK(tree.type(tree.children(root)[0]) == flat::NodeType::Variable);
+		CHECK(tree.type(tree.children(root)[1]) == flat::NodeType::Implies);
+
+		for (flat::NodeIndex node = 0; node < tree.size(); node++)
+			for (const auto child : tree.children(node))
+				CHECK(child > node);
+	}
+
+	SECTION("flat ASTs are printed identically")
+	{
+		const auto expected = printToString<output::FormatterHumanReadable>(formula, context);
+
+		CHECK(expected == "forall U1 ((p(U1, 1..3) and not q(f(V1))) -> exists X1 (U1 = |X1| or q(#sup)))");
+		CHECK(printToString<output::FormatterHumanReadable>(flat::Node{tree, root}, context) == expected);
+	}
+
+	SECTION("flat ASTs are converted back to the pointer-linked AST")
+	{
+		const auto roundTrip = tree.toFormula(root);
+
+		CHECK(printToString<output::FormatterHumanReadable>(roundTrip, context) == printToString<output::FormatterHumanReadable>(formula, context));
+
+		// Bound variables are declared anew, while free variables are shared
+		const auto &forAll = roundTrip.get<ast::ForAll>();
+		CHECK(forAll.variables.front().get() != x);
+	}
+
+	SECTION("flat ASTs are evaluated identically")
+	{
+		CHECK(evaluate(tree, root) == evaluate(formula));
+
+		const auto &implies = formula.get<ast::ForAll>().argument.get<ast::Implies>();
+		const auto &predicate = implies.antecedent.get<ast::And>().arguments.front().get<ast::Predicate>();
+
+		const auto flatImplies = tree.children(root)[1];
+		const auto flatAnd = tree.children(flatImplies)[0];
+		const auto flatPredicate = tree.children(flatAnd)[0];
+
+		for (size_t i = 0; i < predicate.arguments.size(); i++)
+		{
+			const auto expectedType = type(predicate.arguments[i]);
+			const auto actualType = type(tree, tree.children(flatPredicate)[i]);
+
+			CHECK(actualType.domain == expectedType.domain);
+			CHECK(actualType.setSize == expectedType.setSize);
+		}
+	}
+
+	SECTION("flat ASTs are printed identically in TPTP")
+	{
+		std::vector<ast::Term> arguments;
+		arguments.emplace_back(ast::BinaryOperation(ast::BinaryOperation::Operator::Plus, ast::Integer(-2), ast::Variable(&y)));
+		arguments.emplace_back(ast::UnaryOperation(ast::UnaryOperation::Operator::Minus, ast::Integer(4)));
+
+		y.domain = Domain::Integer;
+
+		ast::Formula tptpFormula = ast::Biconditional(ast::Predicate(p, std::move(arguments)),
+			ast::Comparison(ast::Comparison::Operator::LessThan, ast::Variable(&y), ast::Integer(5)));
+
+		flat::Tree tptpTree;
+		const auto tptpRoot = tptpTree.add(tptpFormula);
+
+		CHECK(printToString<output::FormatterTPTP>(flat::Node{tptpTree, tptpRoot}, context) == printToString<output::FormatterTPTP>(tptpFormula, context));
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+// Prints a value, or the error message if the formatter doesn’t support it
+template<class Formatter, class Value>
+std::string printToStringOrError(const Value &value, const anthem::Context &context)
+{
+	try
+	{
+		return printToString<Formatter>(value, context);
+	}
+	catch (const std::exception &exception)
+	{
+		return std::string("error: ") + exception.what();
+	}
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[flat AST] All node types are printed identically in both representations", "[flat AST]")
+{
+	using namespace anthem;
+
+	Context context;
+
+	auto *p = context.findOrCreatePredicateDeclaration("p", 7);
+	auto *q = context.findOrCreatePredicateDeclaration("q", 0);
+	auto *r = context.findOrCreatePredicateDeclaration("r", 1);
+	auto *s = context.findOrCreatePredicateDeclaration("s", 0);
+	auto *f = context.findOrCreateFunctionDeclaration("f", 2);
+	auto *c = context.findOrCreateFunctionDeclaration("c", 0);
+
+	// Free variables of all types, referenced by the flat AST
+	ast::VariableDeclaration u(ast::VariableDeclaration::Type::UserDefined);
+	ast::VariableDeclaration v(ast::VariableDeclaration::Type::Head);
+	ast::VariableDeclaration w(ast::VariableDeclaration::Type::Body);
+
+	const auto variable =
+		[](ast::VariableDeclaration *variableDeclaration)
+		{
+			return ast::Term(ast::Variable(variableDeclaration));
+		};
+
+	const auto binaryOperation =
+		[](ast::BinaryOperation::Operator operator_, ast::Term &&left, ast::Term &&right)
+		{
+			return ast::Term(ast::BinaryOperation(operator_, std::move(left), std::move(right)));
+		};
+
+	const auto unaryOperation =
+		[](ast::UnaryOperation::Operator operator_, ast::Term &&argument)
+		{
+			return ast::Term(ast::UnaryOperation(operator_, std::move(argument)));
+		};
+
+	const auto function =
+		[](ast::FunctionDeclaration *declaration, ast::Term &&left, ast::Term &&right)
+		{
+			std::vector<ast::Term> arguments;
+			arguments.emplace_back(std::move(left));
+			arguments.emplace_back(std::move(right));
+
+			return ast::Term(ast::Function(declaration, std::move(arguments)));
+		};
+
+	const auto predicate =
+		[](ast::PredicateDeclaration *declaration, std::vector<ast::Term> &&arguments)
+		{
+			return ast::Formula(ast::Predicate(declaration, std::move(arguments)));
+		};
+
+	// forall X1, X2 (p(terms) <-> exists X3 ((X1 > X3 and … and X1 = X3) or not q or (#true -> #false) or extra formula))
+	const auto makeFormula =
+		[&](const auto &makeTerms, ast::Formula &&extraFormula, Domain domain)
+		{
+			ast::VariableDeclarationPointers forAllVariables;
+			forAllVariables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::Body));
+			forAllVariables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::Body));
+			auto *x1 = forAllVariables[0].get();
+			auto *x2 = forAllVariables[1].get();
+
+			ast::VariableDeclarationPointers existsVariables;
+			existsVariables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::Body));
+			auto *x3 = existsVariables.back().get();
+
+			x1->domain = domain;
+			x2->domain = domain;
+			x3->domain = Domain::Integer;
+
+			std::vector<ast::Formula> comparisons;
+
+			for (const auto operator_ : {ast::Comparison::Operator::GreaterThan, ast::Comparison::Operator::LessThan,
+				ast::Comparison::Operator::LessEqual, ast::Comparison::Operator::GreaterEqual,
+				ast::Comparison::Operator::NotEqual, ast::Comparison::Operator::Equal})
+			{
+				comparisons.emplace_back(ast::Comparison(operator_, variable(x1), variable(x3)));
+			}
+
+			ast::Formula notQ = ast::Not(predicate(q, {}));
+
+			std::vector<ast::Formula> orArguments;
+			orArguments.emplace_back(ast::And(std::move(comparisons)));
+			orArguments.emplace_back(std::move(notQ));
+			orArguments.emplace_back(ast::Implies(ast::Boolean(true), ast::Boolean(false)));
+			orArguments.emplace_back(std::move(extraFormula));
+
+			return ast::Formula(ast::ForAll(std::move(forAllVariables),
+				ast::Biconditional(predicate(p, makeTerms(x1, x2)), ast::Exists(std::move(existsVariables), ast::Or(std::move(orArguments))))));
+		};
+
+	const auto checkPrintedIdentically =
+		[&](const ast::Formula &formula, const auto &formatter, const std::string &expected)
+		{
+			using Formatter = std::decay_t<decltype(formatter)>;
+
+			flat::Tree tree;
+			const auto root = tree.add(formula);
+
+			CHECK(printToString<Formatter>(formula, context) == expected);
+			CHECK(printToString<Formatter>(flat::Node{tree, root}, context) == expected);
+		};
+
+	SECTION("human-readable format")
+	{
+		const auto formula = makeFormula(
+			[&](ast::VariableDeclaration *x1, ast::VariableDeclaration *x2)
+			{
+				std::vector<ast::Term> arguments;
+				arguments.emplace_back(binaryOperation(ast::BinaryOperation::Operator::Multiplication,
+					binaryOperation(ast::BinaryOperation::Operator::Plus, variable(x1), ast::Integer(1)),
+					binaryOperation(ast::BinaryOperation::Operator::Minus, variable(x2), ast::Integer(-2))));
+				arguments.emplace_back(binaryOperation(ast::BinaryOperation::Operator::Power,
+					binaryOperation(ast::BinaryOperation::Operator::Modulo,
+						binaryOperation(ast::BinaryOperation::Operator::Division, variable(x1), ast::Integer(2)), ast::Integer(3)),
+					variable(&u)));
+				arguments.emplace_back(unaryOperation(ast::UnaryOperation::Operator::Minus,
+					unaryOperation(ast::UnaryOperation::Operator::Absolute, variable(x2))));
+				arguments.emplace_back(ast::Interval(ast::Integer(1), ast::SpecialInteger(ast::SpecialInteger::Type::Supremum)));
+				arguments.emplace_back(function(f, ast::SpecialInteger(ast::SpecialInteger::Type::Infimum), ast::String("s")));
+				arguments.emplace_back(ast::Function(c));
+				arguments.emplace_back(ast::Boolean(true));
+
+				return arguments;
+			},
+			ast::In(variable(&w), ast::Interval(variable(&u), variable(&v))), Domain::Unknown);
+
+		checkPrintedIdentically(formula, output::FormatterHumanReadable(),
+			"forall X1, X2 (p((X1 + 1) * (X2 - -2), ((X1 / 2) % 3) ** U1, -|X2|, 1..#sup, f(#inf, \"s\"), c, #true)"
+			" <-> exists N1 ((X1 > N1 and X1 < N1 and X1 <= N1 and X1 >= N1 and X1 != N1 and X1 = N1)"
+			" or not q or (#true -> #false) or X3 in (U1..V1)))");
+
+		context.parenthesisStyle = output::ParenthesisStyle::Full;
+
+		checkPrintedIdentically(formula, output::FormatterHumanReadable(),
+			"(forall X1, X2 (p(((X1 + 1) * (X2 - -2)), (((X1 / 2) % 3) ** U1), -|X2|, (1..#sup), f(#inf, \"s\"), c, #true)"
+			" <-> (exists N1 (((X1 > N1) and (X1 < N1) and (X1 <= N1) and (X1 >= N1) and (X1 != N1) and (X1 = N1))"
+			" or (not q) or (#true -> #false) or (X3 in (U1..V1))))))");
+	}
+
+	SECTION("TPTP format")
+	{
+		const auto formula = makeFormula(
+			[&](ast::VariableDeclaration *x1, ast::VariableDeclaration *x2)
+			{
+				std::vector<ast::Term> arguments;
+				arguments.emplace_back(binaryOperation(ast::BinaryOperation::Operator::Multiplication,
+					binaryOperation(ast::BinaryOperation::Operator::Plus, variable(x1), ast::Integer(1)),
+					binaryOperation(ast::BinaryOperation::Operator::Minus, variable(x2), ast::Integer(-2))));
+				arguments.emplace_back(unaryOperation(ast::UnaryOperation::Operator::Minus, variable(x1)));
+				arguments.emplace_back(function(f, variable(&u), variable(&v)));
+				arguments.emplace_back(ast::Function(c));
+				arguments.emplace_back(variable(&w));
+				arguments.emplace_back(ast::Integer(3));
+				arguments.emplace_back(ast::Boolean(true));
+
+				return arguments;
+			},
+			predicate(s, {}), Domain::Integer);
+
+		for (auto *variableDeclaration : {&u, &v, &w})
+			variableDeclaration->domain = Domain::Integer;
+
+		checkPrintedIdentically(formula, output::FormatterTPTP(),
+			"(![X1: object, X2: object]: (p(f__product__(f__sum__(X1, 1), f__difference__(X2, $uminus(2))), f__unary_minus__(X1), f(U1, X3), c, X4, 3, $true)"
+			" <=> (?[X5: object]: ((p__greater__(X1, X5) & p__less__(X1, X5) & p__less_equal__(X1, X5) & p__greater_equal__(X1, X5) & (X1 != X5) & (X1 = X5))"
+			" | (~q) | ($true => $false) | s))))");
+	}
+
+	SECTION("nodes not supported in TPTP are rejected in both representations")
+	{
+		std::vector<ast::Formula> formulas;
+
+		const auto addPredicate =
+			[&](ast::Term &&term)
+			{
+				std::vector<ast::Term> arguments;
+				arguments.emplace_back(std::move(term));
+				formulas.emplace_back(predicate(r, std::move(arguments)));
+			};
+
+		for (const auto operator_ : {ast::BinaryOperation::Operator::Division, ast::BinaryOperation::Operator::Modulo,
+			ast::BinaryOperation::Operator::Power})
+		{
+			addPredicate(binaryOperation(operator_, ast::Integer(1), ast::Integer(2)));
+		}
+
+		addPredicate(unaryOperation(ast::UnaryOperation::Operator::Absolute, ast::Integer(1)));
+		addPredicate(ast::Interval(ast::Integer(1), ast::Integer(2)));
+		addPredicate(ast::SpecialInteger(ast::SpecialInteger::Type::Infimum));
+		addPredicate(ast::String("s"));
+		addPredicate(variable(&u));
+		formulas.emplace_back(ast::In(ast::Integer(1), ast::Integer(2)));
+
+		for (const auto &formula : formulas)
+		{
+			flat::Tree tree;
+			const auto root = tree.add(formula);
+
+			const auto expected = printToStringOrError<output::FormatterTPTP>(formula, context);
+
+			CHECK(expected.rfind("error: ", 0) == 0);
+			CHECK(printToStringOrError<output::FormatterTPTP>(flat::Node{tree, root}, context) == expected);
+		}
+	}
+}
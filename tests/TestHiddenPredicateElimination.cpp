@@ -1,5 +1,6 @@
 #include <catch2/catch.hpp>
 
+#include <algorithm>
 #include <sstream>
 
 #include <anthem/AST.h>
@@ -111,6 +112,43 @@ TEST_CASE("[hidden predicate elimination] Hidden predicates are correctly elimin
 			"forall V3 (e(V3) <-> e(V3))\n");
 	}
 
+	SECTION("chains of hidden predicates are eliminated regardless of their order")
+	{
+		input <<
+			"a(X) :- z(X).\n"
+			"z(X) :- y(X).\n"
+			"y(X) :- x(X).\n"
+			"x(1..2).\n"
+			"#show a/1.";
+		anthem::translate("input", input, context);
+
+		CHECK(output.str() ==
+			"forall V1 (a(V1) <-> V1 in (1..2))\n");
+	}
+
+	SECTION("large definitions used more than once are kept as abbreviations if requested")
+	{
+		context.abbreviationThreshold = 1;
+
+		input <<
+			"a(X) :- b(X).\n"
+			"c(X) :- b(X).\n"
+			"b(X) :- d(X), e(X).\n"
+			"d(1..2).\n"
+			"e(2..3).\n"
+			"#show a/1.\n"
+			"#show c/1.";
+		anthem::translate("input", input, context);
+
+		const auto result = output.str();
+
+		CHECK(result.find("forall V1 (a(V1) <-> b(V1))\n") == 0);
+		CHECK(result.find("b(V2)") != std::string::npos);
+		CHECK(std::count(result.begin(), result.end(), '\n') == 3);
+		CHECK(result.find("d(") == std::string::npos);
+		CHECK(result.find("e(") == std::string::npos);
+	}
+
 	SECTION("simple Booleans are recognized")
 	{
 		input <<
@@ -66,6 +66,23 @@ TEST_CASE("[integer detection] Integer variables are correctly detected", "[inte
 			"forall N2 (q(N2) <-> exists N3 (p(N3) and N2 in ((N3 + 5) / 3)))\n");
 	}
 
+	SECTION("integer parameters propagated through predicates defined later on")
+	{
+		input
+			<< "p(X) :- q(X).\n"
+			<< "q(X) :- r(X).\n"
+			<< "r(X) :- X = 1..5.";
+		anthem::translate("input", input, context);
+
+		CHECK(output.str() ==
+			"int(p/1@1)\n"
+			"int(q/1@1)\n"
+			"int(r/1@1)\n"
+			"forall N1 (p(N1) <-> q(N1))\n"
+			"forall N2 (q(N2) <-> r(N2))\n"
+			"forall N3 (r(N3) <-> N3 in (1..5))\n");
+	}
+
 	SECTION("multiple mixed parameters")
 	{
 		input
@@ -83,6 +100,31 @@ TEST_CASE("[integer detection] Integer variables are correctly detected", "[inte
 			"forall N2, V2, N3 (r(N2, V2, N3) <-> exists N4 (p(N4) and N2 = (N4 ** 2) and q(V2) and p(N3)))\n");
 	}
 
+	SECTION("more integer parameters than evaluated at once")
+	{
+		input << "p(X1";
+
+		for (size_t i = 2; i <= 70; i++)
+			input << ", X" << i;
+
+		input << ") :- X1 = 1..5";
+
+		for (size_t i = 2; i <= 70; i++)
+			input << ", X" << i << " = " << (i % 2 == 0 ? "1..5" : "error");
+
+		input << ".";
+		anthem::translate("input", input, context);
+
+		const auto result = output.str();
+
+		CHECK(result.find("int(p/70@1)\n") != std::string::npos);
+		CHECK(result.find("int(p/70@3)\n") == std::string::npos);
+		CHECK(result.find("int(p/70@64)\n") != std::string::npos);
+		CHECK(result.find("int(p/70@65)\n") == std::string::npos);
+		CHECK(result.find("int(p/70@66)\n") != std::string::npos);
+		CHECK(result.find("int(p/70@70)\n") != std::string::npos);
+	}
+
 	SECTION("integer parameter despite usage of constant symbol")
 	{
 		input
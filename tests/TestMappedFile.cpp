@@ -0,0 +1,61 @@
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+#include <unistd.h>
+
+#include <anthem/MappedFile.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[mapped file] Regular files are mapped as null-terminated strings", "[mapped file]")
+{
+	using namespace anthem;
+
+	char fileName[] = "/tmp/anthem-test-XXXXXX";
+	const auto fileDescriptor = mkstemp(fileName);
+	REQUIRE(fileDescriptor >= 0);
+	close(fileDescriptor);
+
+	const auto write =
+		[&](const std::string &content)
+		{
+			std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+			file << content;
+		};
+
+	SECTION("files are mapped with their contents")
+	{
+		write("p(1).\nq(X) :- p(X).\n");
+
+		MappedFile mappedFile(fileName);
+
+		REQUIRE(mappedFile.isMapped());
+		CHECK(mappedFile.size() == 20);
+		CHECK(std::string(mappedFile.data()) == "p(1).\nq(X) :- p(X).\n");
+	}
+
+	SECTION("files ending at a page boundary are null-terminated")
+	{
+		const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		write(std::string(pageSize, 'a'));
+
+		MappedFile mappedFile(fileName);
+
+		REQUIRE(mappedFile.isMapped());
+		CHECK(mappedFile.size() == pageSize);
+		CHECK(mappedFile.data()[pageSize] == '\0');
+	}
+
+	SECTION("empty files and special files are not mapped")
+	{
+		write("");
+
+		CHECK(!MappedFile(fileName).isMapped());
+		CHECK(!MappedFile("/dev/null").isMapped());
+		CHECK(!MappedFile("/nonexistent/file").isMapped());
+	}
+
+	std::remove(fileName);
+}
@@ -0,0 +1,144 @@
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <thread>
+
+#include <anthem/AST.h>
+#include <anthem/Context.h>
+#include <anthem/output/ColorStream.h>
+#include <anthem/output/FormatterHumanReadable.h>
+#include <anthem/output/Formatting.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[output] Buffered color streams write their output in chunks", "[output]")
+{
+	using namespace anthem;
+
+	std::stringstream output;
+	output::ColorStream stream(output);
+
+	SECTION("unbuffered output is written immediately")
+	{
+		stream << output::Keyword("forall") << " " << 42;
+
+		CHECK(output.str() == "forall 42");
+	}
+
+	SECTION("buffered output is written when flushed")
+	{
+		stream.enableBuffering(16);
+		stream << output::Keyword("forall") << " " << 42;
+
+		CHECK(output.str().empty());
+
+		stream.flush();
+
+		CHECK(output.str() == "forall 42");
+	}
+
+	SECTION("buffered output exceeding the buffer size is passed on")
+	{
+		stream.enableBuffering(16);
+
+		const std::string text(40, 'x');
+		stream << "a" << text << "b";
+		stream.flush();
+
+		CHECK(output.str() == "a" + text + "b");
+	}
+
+	SECTION("the color decision follows the color policy")
+	{
+		CHECK(!stream.supportsColor());
+
+		stream.setColorPolicy(output::ColorStream::ColorPolicy::Always);
+		stream.enableBuffering();
+		stream << output::Keyword("not");
+		stream.flush();
+
+		CHECK(stream.supportsColor());
+		CHECK(output.str() != "not");
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[output] Variables are numbered by their first occurrence", "[output]")
+{
+	using namespace anthem;
+
+	Context context;
+
+	ast::VariableDeclaration x(ast::VariableDeclaration::Type::Head);
+	ast::VariableDeclaration y(ast::VariableDeclaration::Type::Body);
+	ast::VariableDeclaration z(ast::VariableDeclaration::Type::Head);
+
+	const auto print =
+		[&](output::PrintContext &printContext, std::initializer_list<const ast::VariableDeclaration *> variableDeclarations)
+		{
+			std::stringstream output;
+			output::ColorStream stream(output);
+
+			for (const auto *variableDeclaration : variableDeclarations)
+			{
+				output::print<output::FormatterHumanReadable>(stream, *variableDeclaration, printContext);
+				stream << " ";
+			}
+
+			return output.str();
+		};
+
+	SECTION("variables are numbered separately for each prefix")
+	{
+		output::PrintContext printContext(context);
+
+		CHECK(print(printContext, {&z, &y, &x, &z, &y}) == "V1 X1 V2 V1 X1 ");
+	}
+
+	SECTION("each print context numbers variables anew")
+	{
+		output::PrintContext printContext(context);
+		CHECK(print(printContext, {&x, &z}) == "V1 V2 ");
+
+		output::PrintContext otherPrintContext(context);
+		CHECK(print(otherPrintContext, {&z, &x}) == "V1 V2 ");
+
+		CHECK(print(printContext, {&z, &y, &x}) == "V2 X1 V1 ");
+		CHECK(print(otherPrintContext, {&y, &x}) == "X1 V2 ");
+	}
+
+	SECTION("print contexts may be used concurrently")
+	{
+		std::vector<std::string> outputs(4);
+		std::vector<std::thread> threads;
+
+		for (auto &output : outputs)
+			threads.emplace_back(
+				[&]()
+				{
+					output::PrintContext printContext(context);
+
+					for (size_t i = 0; i < 1000; i++)
+						output = print(printContext, {&z, &y, &x});
+				});
+
+		for (auto &thread : threads)
+			thread.join();
+
+		for (const auto &output : outputs)
+			CHECK(output == "V1 X1 V2 ");
+	}
+
+	SECTION("variables keep their numbers when their domain changes")
+	{
+		output::PrintContext printContext(context);
+		CHECK(print(printContext, {&x, &z}) == "V1 V2 ");
+
+		z.domain = Domain::Integer;
+		CHECK(print(printContext, {&z, &x}) == "N1 V1 ");
+
+		z.domain = Domain::Unknown;
+		CHECK(print(printContext, {&z, &x}) == "V2 V1 ");
+	}
+}
@@ -0,0 +1,123 @@
+#include <catch2/catch.hpp>
+
+#include <sstream>
+
+#include <anthem/Context.h>
+#include <anthem/Profiler.h>
+#include <anthem/Translation.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+size_t countOccurrences(const std::string &string, const std::string &substring)
+{
+	size_t numberOfOccurrences = 0;
+
+	for (auto position = string.find(substring); position != std::string::npos; position = string.find(substring, position + 1))
+		numberOfOccurrences++;
+
+	return numberOfOccurrences;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[profiler] Events are written in the trace event format", "[profiler]")
+{
+	using namespace anthem;
+
+	Profiler profiler(false);
+
+	SECTION("spans and counters are written as complete and counter events")
+	{
+		const auto startTime = Profiler::Clock::now();
+		profiler.recordSpan("parsing", startTime, startTime + std::chrono::microseconds(1500));
+		profiler.recordCounter("AST nodes", 42);
+
+		std::stringstream trace;
+		profiler.write(trace);
+
+		const auto text = trace.str();
+
+		CHECK(text.rfind("{\"traceEvents\": [", 0) == 0);
+		CHECK(text.find(R"({"name": "parsing", "ph": "X", "pid": 1, "tid": )") != std::string::npos);
+		CHECK(text.find(R"(, "dur": 1500})") != std::string::npos);
+		CHECK(text.find(R"({"name": "AST nodes", "ph": "C", "pid": 1, "tid": )") != std::string::npos);
+		CHECK(text.find(R"(, "args": {"value": 42}})") != std::string::npos);
+		CHECK(text.find("\n], \"displayTimeUnit\": \"ms\"}\n") + 29 == text.size());
+	}
+
+	SECTION("names are escaped")
+	{
+		{
+			Profiler::Span span(&profiler, "parsing \"a\\b\"\nc");
+			Profiler::Span controlCharactersSpan(&profiler, "d\te\rf\bg\fh\x01i\x1f");
+		}
+
+		std::stringstream trace;
+		profiler.write(trace);
+
+		CHECK(trace.str().find(R"("name": "parsing \"a\\b\"\nc")") != std::string::npos);
+		CHECK(trace.str().find(R"("name": "d\te\rf\bg\fh\u0001i\u001f")") != std::string::npos);
+	}
+
+	SECTION("spans without profiler and details that aren’t requested are not recorded")
+	{
+		{
+			Profiler::Span span(nullptr, "parsing");
+			Profiler::Span detailSpan(Profiler::details(&profiler), "simplify formula 1");
+		}
+
+		std::stringstream trace;
+		profiler.write(trace);
+
+		CHECK(trace.str().find("\"name\"") == std::string::npos);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[profiler] AST sizes are recorded at the boundaries of translation phases", "[profiler]")
+{
+	using namespace anthem;
+
+	std::stringstream output;
+	std::stringstream errors;
+
+	Context context{output::Logger(output::ColorStream(output), output::ColorStream(errors))};
+	context.translationMode = TranslationMode::Completion;
+	context.performSimplification = true;
+	context.profiler = std::make_shared<Profiler>(false);
+
+	const std::vector<ProgramText> programs{{"a", "#show p/1. p(X) :- q(X), r(X). q(1..3). r(2)."}};
+
+	const auto trace =
+		[&]()
+		{
+			std::stringstream text;
+			context.profiler->write(text);
+
+			return text.str();
+		};
+
+	SECTION("after parsing and before printing")
+	{
+		context.performCompletion = false;
+
+		translate(programs, context);
+
+		CHECK(countOccurrences(trace(), R"("name": "AST nodes")") == 2);
+	}
+
+	SECTION("also before and after hidden predicate elimination and after integer detection")
+	{
+		context.performCompletion = true;
+		context.performIntegerDetection = true;
+
+		translate(programs, context);
+
+		const auto text = trace();
+
+		CHECK(countOccurrences(text, R"("name": "AST nodes")") == 5);
+		CHECK(countOccurrences(text, R"("name": "hidden predicate elimination")") == 1);
+		CHECK(countOccurrences(text, R"("name": "integer detection")") == 1);
+	}
+}
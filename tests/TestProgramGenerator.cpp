@@ -0,0 +1,75 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+#include <anthem/ProgramGenerator.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[program generator] Generated programs follow the options", "[program generator]")
+{
+	using namespace anthem;
+
+	const auto countLines =
+		[](const std::string &program, const std::string &prefix)
+		{
+			std::stringstream stream(program);
+			std::string line;
+			size_t count = 0;
+
+			while (std::getline(stream, line))
+				if (line.compare(0, prefix.size(), prefix) == 0)
+					count++;
+
+			return count;
+		};
+
+	ProgramGeneratorOptions options;
+	options.numberOfPredicates = 20;
+	options.rulesPerPredicate = 4;
+	options.externalDensity = 0.25;
+	options.showDensity = 0.5;
+
+	const auto program = generateProgram(options);
+
+	SECTION("programs are reproducible")
+	{
+		CHECK(generateProgram(options) == program);
+
+		options.seed = 1;
+		CHECK(generateProgram(options) != program);
+	}
+
+	SECTION("predicates are declared, defined, and shown as requested")
+	{
+		CHECK(countLines(program, "#external ") == 5);
+		CHECK(countLines(program, "#show ") == 8);
+		CHECK(countLines(program, "p20(") + countLines(program, "{p20(") == 4);
+		CHECK(std::count(program.begin(), program.end(), '\n') == 5 + 15 * 4 + 8);
+	}
+
+	SECTION("choice rules, pools, and intervals only occur if requested")
+	{
+		options.choiceRuleShare = 0.0;
+		options.poolShare = 0.0;
+		options.intervalShare = 0.0;
+
+		const auto plainProgram = generateProgram(options);
+
+		CHECK(plainProgram.find('{') == std::string::npos);
+		CHECK(plainProgram.find(';') == std::string::npos);
+		CHECK(plainProgram.find("..") == std::string::npos);
+
+		options.choiceRuleShare = 1.0;
+
+		CHECK(countLines(generateProgram(options), "{") == 15 * 4);
+	}
+
+	SECTION("all predicates are shown without #show statements")
+	{
+		options.showDensity = 1.0;
+
+		CHECK(countLines(generateProgram(options), "#show") == 0);
+	}
+}
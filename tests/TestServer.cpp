@@ -0,0 +1,135 @@
+#include <catch2/catch.hpp>
+
+#include <sstream>
+
+#include <anthem/Context.h>
+#include <anthem/Server.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[server] Requests are answered independently of each other", "[server]")
+{
+	using namespace anthem;
+
+	std::stringstream output;
+	std::stringstream errors;
+
+	Context context{output::Logger(output::ColorStream(output), output::ColorStream(errors))};
+	context.translationMode = TranslationMode::Completion;
+
+	Server server(context);
+
+	const auto contains =
+		[](const std::string &string, const std::string &substring)
+		{
+			return string.find(substring) != std::string::npos;
+		};
+
+	SECTION("requests carry the program text and options")
+	{
+		const auto reply = server.handleRequest(
+			R"({"id": 7, "program": "p(1..5).", "simplify": false, "complete": false})");
+
+		CHECK(contains(reply, R"({"id": 7, "success": true, )"));
+		CHECK(contains(reply, R"("output": "(V1 in (1..5) -> p(V1))\n")"));
+	}
+
+	SECTION("repeated requests produce the same replies")
+	{
+		const std::string request = R"({"id": "a", "mode": "here-and-there", "programs": ["p(X) :- q(X).", "p(X) :- not r(X)."]})";
+
+		const auto firstReply = server.handleRequest(request);
+		const auto secondReply = server.handleRequest(request);
+
+		CHECK(contains(firstReply, R"("success": true)"));
+		CHECK(firstReply == secondReply);
+	}
+
+	SECTION("cache statistics are logged by the server instead of being replied")
+	{
+		context.logger.setLogPriority(output::Priority::Info);
+
+		// Programs start with an implicit “#program base.” statement
+		const std::string request = R"({"id": 1, "program": "p(1..5). q :- p(3)."})";
+
+		const auto firstReply = server.handleRequest(request);
+		const auto secondReply = server.handleRequest(request);
+
+		CHECK(firstReply == secondReply);
+		CHECK(!contains(secondReply, "reused"));
+		CHECK(contains(errors.str(), "reused the translations of 0 of 3 statements"));
+		CHECK(contains(errors.str(), "reused the translations of 3 of 3 statements"));
+	}
+
+	SECTION("errors are reported in the diagnostics")
+	{
+		CHECK(contains(server.handleRequest(R"({"id": 1, "program": )"), R"("success": false)"));
+		CHECK(contains(server.handleRequest(R"({"id": 2, "program": "p(1..5).", "mode": "unknown"})"), "unknown head mode"));
+		CHECK(contains(server.handleRequest(R"({"id": 3, "program": "p(X :- q."})"), R"({"id": 3, "success": false)"));
+		CHECK(contains(server.handleRequest(R"({"programs": []})"), "no input files specified"));
+	}
+
+	SECTION("malformed requests are rejected")
+	{
+		const auto deeplyNestedRequest = R"({"id": 4, "nested": )" + std::string(100, '[') + std::string(100, ']') + "}";
+
+		CHECK(contains(server.handleRequest(deeplyNestedRequest), "nested more than 64 levels deep"));
+		CHECK(contains(server.handleRequest(R"({"id": 5, "program": "% \ud83d\u0041"})"), "unpaired surrogate"));
+		CHECK(contains(server.handleRequest(R"({"id": 6, "program": "% \ud83d"})"), "unpaired surrogate"));
+		CHECK(contains(server.handleRequest(R"({"id": 7, "program": "% \ude00"})"), "unpaired surrogate"));
+		CHECK(!contains(server.handleRequest(R"({"id": 8, "program": "% \ud83d\ude00\np."})"), "malformed request"));
+	}
+
+	SECTION("numbers follow the JSON grammar")
+	{
+		CHECK(contains(server.handleRequest(R"({"id": -0.5e+3, "program": "p."})"), R"({"id": -0.5e+3, "success": )"));
+		CHECK(contains(server.handleRequest(R"({"id": 10E2, "program": "p."})"), R"({"id": 10E2, "success": )"));
+		CHECK(contains(server.handleRequest(R"({"id": 01, "program": "p."})"), "invalid number"));
+		CHECK(contains(server.handleRequest(R"({"id": -, "program": "p."})"), "invalid number"));
+		CHECK(contains(server.handleRequest(R"({"id": 1+2, "program": "p."})"), "malformed request"));
+		CHECK(contains(server.handleRequest(R"({"id": +1, "program": "p."})"), "malformed request"));
+		CHECK(contains(server.handleRequest(R"({"id": 1., "program": "p."})"), "invalid number"));
+		CHECK(contains(server.handleRequest(R"({"id": 1e, "program": "p."})"), "invalid number"));
+	}
+
+	SECTION("invalid UTF-8 is replaced in replies")
+	{
+		const auto idOf =
+			[&](const std::string &id)
+			{
+				const auto reply = server.handleRequest("{\"id\": \"" + id + "\", \"program\": \"p.\"}");
+
+				return reply.substr(0, reply.find(", \"success\""));
+			};
+
+		CHECK(idOf("a\xc3\xa4\xe2\x82\xac\xf0\x9f\x98\x80" "b") == "{\"id\": \"a\xc3\xa4\xe2\x82\xac\xf0\x9f\x98\x80" "b\"");
+		CHECK(idOf("a\xff" "b") == R"({"id": "a\ufffdb")");
+		// Overlong encodings, surrogates, and truncated sequences
+		CHECK(idOf("\xc0\xaf") == R"({"id": "\ufffd\ufffd")");
+		CHECK(idOf("\xed\xa0\x80") == R"({"id": "\ufffd\ufffd\ufffd")");
+		CHECK(idOf("a\xe2\x82") == R"({"id": "a\ufffd\ufffd")");
+	}
+
+	SECTION("requests are read line by line")
+	{
+		std::stringstream requests;
+		requests << R"({"id": 1, "program": "p(1..5).", "output-format": "tptp"})" << "\n\n"
+			<< R"({"id": 2, "program": "p(1..5).\nq."})" << "\n";
+
+		std::stringstream replies;
+		server.serve(requests, replies);
+
+		std::string firstReply;
+		std::string secondReply;
+		std::string end;
+		std::getline(replies, firstReply);
+		std::getline(replies, secondReply);
+
+		CHECK(contains(firstReply, R"({"id": 1, "success": true)"));
+		CHECK(contains(secondReply, R"({"id": 2, "success": true)"));
+		CHECK(!std::getline(replies, end));
+	}
+
+	// Replies aren’t written to the server’s own streams
+	CHECK(output.str().empty());
+}
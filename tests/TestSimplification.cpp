@@ -4,6 +4,8 @@
 
 #include <anthem/AST.h>
 #include <anthem/Context.h>
+#include <anthem/Simplification.h>
+#include <anthem/Statistics.h>
 #include <anthem/Translation.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -82,3 +84,113 @@ TEST_CASE("[simplification] Rules are simplified correctly", "[simplification]")
 		CHECK(output.str() == "forall V1 (p(V1) <-> V1 = a)\n");
 	}
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[simplification] Statistics are collected per rule and formula", "[simplification]")
+{
+	using namespace anthem;
+
+	SECTION("rewrites are counted for the rule that applied")
+	{
+		Context context;
+		auto *p = context.findOrCreatePredicateDeclaration("p", 0);
+
+		// not not p
+		ast::Formula notP = ast::Not(ast::Predicate(p));
+		ast::Formula formula = ast::Not(std::move(notP));
+
+		SimplificationStatistics statistics;
+		simplify(formula, statistics);
+
+		REQUIRE(formula.is<ast::Predicate>());
+		REQUIRE(!statistics.rules.empty());
+		CHECK(statistics.numberOfIterations > 0);
+
+		const auto &doubleNegation = statistics.rules.front();
+
+		CHECK(std::string(doubleNegation.description) == "not not F === F");
+		CHECK(doubleNegation.numberOfAttempts >= 1);
+		CHECK(doubleNegation.numberOfRewrites == 1);
+		CHECK(doubleNegation.time > std::chrono::nanoseconds::zero());
+
+		for (size_t i = 1; i < statistics.rules.size(); i++)
+		{
+			CHECK(statistics.rules[i].numberOfAttempts >= 1);
+			CHECK(statistics.rules[i].numberOfRewrites == 0);
+		}
+	}
+
+	SECTION("statistics of concurrently simplified formulas are merged in the order of the output")
+	{
+		const auto collectStatistics =
+			[](size_t numberOfThreads)
+			{
+				std::stringstream input;
+				std::stringstream output;
+				std::stringstream errors;
+
+				Context context{output::Logger(output::ColorStream(output), output::ColorStream(errors))};
+				context.translationMode = TranslationMode::Completion;
+				context.performSimplification = true;
+				context.performCompletion = false;
+				context.collectStatistics = true;
+				context.numberOfThreads = numberOfThreads;
+
+				input << "p(1).\n"
+					<< "q(X) :- p(X).\n"
+					<< "r(X) :- q(X), not p(X).\n"
+					<< ":- r(X), not not q(X).\n"
+					<< "s(X, Y) :- p(X), q(Y), X < Y, not r(Y).\n"
+					<< "t(N) :- N = 1..5, not s(N, N).\n"
+					<< "u :- not not t(3), p(2), q(3), r(4).\n"
+					<< "v(X + Y) :- p(X), p(Y).\n";
+				translate("input", input, context);
+
+				return context.statistics;
+			};
+
+		const auto sequentialStatistics = collectStatistics(1);
+		const auto concurrentStatistics = collectStatistics(4);
+
+		REQUIRE(sequentialStatistics.numberOfSimplificationIterations.size() == 8);
+		CHECK(concurrentStatistics.numberOfSimplificationIterations == sequentialStatistics.numberOfSimplificationIterations);
+
+		REQUIRE(concurrentStatistics.simplificationRules.size() == sequentialStatistics.simplificationRules.size());
+
+		for (size_t i = 0; i < sequentialStatistics.simplificationRules.size(); i++)
+		{
+			CHECK(concurrentStatistics.simplificationRules[i].numberOfAttempts == sequentialStatistics.simplificationRules[i].numberOfAttempts);
+			CHECK(concurrentStatistics.simplificationRules[i].numberOfRewrites == sequentialStatistics.simplificationRules[i].numberOfRewrites);
+		}
+	}
+
+	SECTION("fixpoint iterations are summarized unless details are requested")
+	{
+		Statistics statistics;
+		statistics.numberOfSimplificationIterations = {1, 3, 2, 1, 9};
+
+		const auto print =
+			[&](bool printDetails)
+			{
+				std::stringstream output;
+				output::ColorStream stream(output);
+				statistics.print(stream, printDetails);
+
+				return output.str();
+			};
+
+		const auto summary = print(false);
+
+		CHECK(summary.find("simplification fixpoint iterations: 16 in total, 9 at most for 5 formulas\n"
+			"  1 iterations: 2 formulas\n"
+			"  2-3 iterations: 2 formulas\n"
+			"  8-15 iterations: 1 formulas\n") != std::string::npos);
+		CHECK(summary.find("formula 1:") == std::string::npos);
+
+		const auto details = print(true);
+
+		CHECK(details.find("  formula 1: 1\n") != std::string::npos);
+		CHECK(details.find("  formula 5: 9\n") != std::string::npos);
+	}
+}
@@ -0,0 +1,117 @@
+#include <catch2/catch.hpp>
+
+#include <sstream>
+
+#include <anthem/Context.h>
+#include <anthem/StatementCache.h>
+#include <anthem/Translation.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[statement cache] Edited programs are translated as if translated from scratch", "[statement cache]")
+{
+	using namespace anthem;
+
+	const auto translateWithCache =
+		[](const std::vector<ProgramText> &programs, TranslationMode translationMode,
+			std::shared_ptr<StatementCache> statementCache)
+		{
+			std::stringstream output;
+			std::stringstream errors;
+
+			Context context{output::Logger(output::ColorStream(output), output::ColorStream(errors))};
+			context.translationMode = translationMode;
+			context.performSimplification = true;
+			context.performCompletion = true;
+			context.statementCache = std::move(statementCache);
+
+			translate(programs, context);
+
+			return output.str();
+		};
+
+	auto statementCache = std::make_shared<StatementCache>();
+
+	const auto checkSameOutput =
+		[&](const std::vector<ProgramText> &programs, TranslationMode translationMode)
+		{
+			CHECK(translateWithCache(programs, translationMode, statementCache)
+				== translateWithCache(programs, translationMode, nullptr));
+		};
+
+	SECTION("completion")
+	{
+		checkSameOutput({{"a", "p(X) :- q(X), not r(X).\nq(1..3).\nr(2).\n#show p/1."}}, TranslationMode::Completion);
+		CHECK(statementCache->numberOfTranslatedStatements() == 5);
+
+		// Changing one rule only translates that rule again
+		checkSameOutput({{"a", "p(X) :- q(X), not r(X).\nq(1..4).\nr(2).\n#show p/1."}}, TranslationMode::Completion);
+		CHECK(statementCache->numberOfStatements() == 5);
+		CHECK(statementCache->numberOfTranslatedStatements() == 1);
+
+		// Removing the #show statement makes all predicates visible again
+		checkSameOutput({{"a", "p(X) :- q(X), not r(X).\nq(1..4).\nr(2)."}}, TranslationMode::Completion);
+		CHECK(statementCache->numberOfTranslatedStatements() == 0);
+
+		// Reordered rules yield differently ordered definitions
+		checkSameOutput({{"a", "r(2).\nq(1..4).\np(X) :- q(X), not r(X).\np(5)."}}, TranslationMode::Completion);
+		CHECK(statementCache->numberOfTranslatedStatements() == 1);
+	}
+
+	SECTION("here-and-there")
+	{
+		checkSameOutput({{"a", "p(X) :- q(X)."}, {"b", "p(X) :- not r(X)."}}, TranslationMode::HereAndThere);
+		checkSameOutput({{"a", "p(X) :- q(X)."}, {"b", "p(X) :- not r(X), s(X)."}}, TranslationMode::HereAndThere);
+		CHECK(statementCache->numberOfTranslatedStatements() == 1);
+	}
+
+	SECTION("switching modes")
+	{
+		checkSameOutput({{"a", "p(X) :- q(X).\n#external integer(f(1))."}}, TranslationMode::HereAndThere);
+		checkSameOutput({{"a", "p(X) :- q(X).\n#external integer(f(1))."}}, TranslationMode::Completion);
+		checkSameOutput({{"a", "p(X) :- q(X).\n#external integer(f(1))."}}, TranslationMode::HereAndThere);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[statement cache] Repeatedly edited programs don’t grow the cache", "[statement cache]")
+{
+	using namespace anthem;
+
+	auto statementCache = std::make_shared<StatementCache>();
+
+	const auto translateEdit =
+		[&](size_t edit)
+		{
+			// Every edit changes all facts and thus replaces their cached translations
+			std::stringstream program;
+
+			for (size_t i = 0; i < 50; i++)
+				program << "q(" << edit << ", " << i << ").\n";
+
+			program << "p(X) :- q(X, Y), not r(Y).\n";
+
+			std::stringstream output;
+			std::stringstream errors;
+
+			Context context{output::Logger(output::ColorStream(output), output::ColorStream(errors))};
+			context.translationMode = TranslationMode::Completion;
+			context.performSimplification = true;
+			context.performCompletion = true;
+			context.statementCache = statementCache;
+
+			translate(std::vector<ProgramText>{{"a", program.str()}}, context);
+		};
+
+	for (size_t edit = 0; edit < 10; edit++)
+		translateEdit(edit);
+
+	const auto capacityAfterWarmUp = statementCache->arenaCapacity();
+
+	for (size_t edit = 10; edit < 200; edit++)
+		translateEdit(edit);
+
+	// Without recycling the memory of discarded statements, the cache would grow by 190 edits of 50 facts
+	CHECK(statementCache->arenaCapacity() <= 2 * capacityAfterWarmUp);
+}
@@ -0,0 +1,147 @@
+#include <catch2/catch.hpp>
+
+#include <cstdlib>
+#include <sstream>
+
+#include <unistd.h>
+
+#include <anthem/Context.h>
+#include <anthem/SHA256.h>
+#include <anthem/Translation.h>
+#include <anthem/TranslationCache.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+std::string temporaryDirectoryName()
+{
+	char directoryName[] = "/tmp/anthem-test-XXXXXX";
+	REQUIRE(mkdtemp(directoryName) != nullptr);
+
+	// Let the cache create the directory itself
+	rmdir(directoryName);
+
+	return std::string(directoryName) + "/cache";
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[translation cache] SHA-256 hashes are computed correctly", "[translation cache]")
+{
+	const auto hash =
+		[](const std::string &text)
+		{
+			anthem::SHA256 sha256;
+
+			// Feed the text in uneven pieces to cover partially filled blocks
+			for (size_t position = 0; position < text.size(); position += 7)
+				sha256.update(text.substr(position, 7));
+
+			return sha256.hexadecimalDigest();
+		};
+
+	CHECK(hash("") == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+	CHECK(hash("abc") == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+	CHECK(hash(std::string(64, 'y')) == "ffbf30ab94107b2c14d75cfb455ec94f200400ddc5ce304e0c21894090db055f");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[translation cache] Cached outputs are keyed by the programs and the options", "[translation cache]")
+{
+	using namespace anthem;
+
+	std::stringstream output;
+	std::stringstream errors;
+
+	Context context{output::Logger(output::ColorStream(output), output::ColorStream(errors))};
+
+	TranslationCache translationCache(temporaryDirectoryName(), 20);
+
+	const std::vector<ProgramText> programs = {{"a", "p."}, {"b", "q."}};
+	const auto key = translationCache.key(programs, context);
+
+	SECTION("keys depend on the program texts but not on their names")
+	{
+		CHECK(translationCache.key({{"c", "p."}, {"d", "q."}}, context) == key);
+		CHECK(translationCache.key({{"a", "p.q."}, {"b", ""}}, context) != key);
+		CHECK(translationCache.key({{"a", "q."}, {"b", "p."}}, context) != key);
+	}
+
+	SECTION("keys depend on the options affecting the output")
+	{
+		context.translationMode = TranslationMode::Completion;
+		CHECK(translationCache.key(programs, context) != key);
+
+		context.translationMode = TranslationMode::HereAndThere;
+		context.outputFormat = OutputFormat::TPTP;
+		CHECK(translationCache.key(programs, context) != key);
+
+		context.outputFormat = OutputFormat::HumanReadable;
+		context.parenthesisStyle = output::ParenthesisStyle::Full;
+		CHECK(translationCache.key(programs, context) != key);
+
+		context.parenthesisStyle = output::ParenthesisStyle::Normal;
+		context.numberOfThreads = 4;
+		CHECK(translationCache.key(programs, context) == key);
+	}
+
+	SECTION("the least recently used outputs are evicted")
+	{
+		std::stringstream cachedOutput;
+		CHECK(!translationCache.load(key, cachedOutput));
+
+		translationCache.store(key, "output 1\n");
+		CHECK(translationCache.load(key, cachedOutput));
+		CHECK(cachedOutput.str() == "output 1\n");
+
+		const auto otherKey = translationCache.key({{"a", "r."}}, context);
+		translationCache.store(otherKey, "output 2\n");
+
+		// Make the first output the most recently used one
+		sleep(1);
+		CHECK(translationCache.load(key, cachedOutput));
+
+		translationCache.store(translationCache.key({{"a", "s."}}, context), "output 3\n");
+
+		std::stringstream otherCachedOutput;
+		CHECK(translationCache.load(key, otherCachedOutput));
+		CHECK(!translationCache.load(otherKey, otherCachedOutput));
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[translation cache] Cached translations produce the same output", "[translation cache]")
+{
+	using namespace anthem;
+
+	const auto translateCached =
+		[](std::shared_ptr<TranslationCache> translationCache)
+		{
+			std::stringstream input("p(X) :- q(X), not r(X).\nq(1..3).");
+			std::stringstream output;
+			std::stringstream errors;
+
+			Context context{output::Logger(output::ColorStream(output), output::ColorStream(errors))};
+			context.translationMode = TranslationMode::Completion;
+			context.performSimplification = true;
+			context.performCompletion = true;
+			context.translationCache = std::move(translationCache);
+
+			translate("input", input, context);
+
+			return output.str();
+		};
+
+	auto translationCache = std::make_shared<TranslationCache>(temporaryDirectoryName(), 1024 * 1024);
+
+	const auto output = translateCached(nullptr);
+
+	CHECK(translateCached(translationCache) == output);
+	CHECK(translateCached(translationCache) == output);
+}
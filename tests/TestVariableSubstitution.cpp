@@ -0,0 +1,110 @@
+#include <catch2/catch.hpp>
+
+#include <sstream>
+
+#include <anthem/AST.h>
+#include <anthem/ASTUtils.h>
+#include <anthem/Context.h>
+#include <anthem/output/FormatterHumanReadable.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[variable substitution] Variables are replaced as if one after the other", "[variable substitution]")
+{
+	using namespace anthem;
+
+	Context context;
+
+	auto *p = context.findOrCreatePredicateDeclaration("p", 3);
+
+	// exists X, Y, Z p(X, Y, Z)
+	ast::VariableDeclarationPointers variables;
+	variables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::UserDefined, "X"));
+	auto *x = variables.back().get();
+	variables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::UserDefined, "Y"));
+	auto *y = variables.back().get();
+	variables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::UserDefined, "Z"));
+	auto *z = variables.back().get();
+
+	std::vector<ast::Term> arguments;
+	arguments.emplace_back(ast::Variable(x));
+	arguments.emplace_back(ast::Variable(y));
+	arguments.emplace_back(ast::Variable(z));
+
+	ast::Formula formula = ast::Exists(std::move(variables), ast::Predicate(p, std::move(arguments)));
+
+	const auto print =
+		[&]()
+		{
+			std::stringstream output;
+			output::ColorStream stream(output);
+			output::PrintContext printContext(context);
+			output::print<output::FormatterHumanReadable>(stream, formula, printContext);
+
+			return output.str();
+		};
+
+	ast::VariableSubstitution substitution;
+
+	SECTION("later replacements apply to earlier ones")
+	{
+		substitution.add(*x, *z);
+		substitution.add(*z, ast::Integer(3));
+		substitution.apply(formula);
+
+		CHECK(print() == "exists U1, U2, U3 p(3, U2, 3)");
+		CHECK(substitution.find(*y) == nullptr);
+	}
+
+	SECTION("variables are only replaced once")
+	{
+		substitution.add(*x, *y);
+		substitution.add(*x, *z);
+		substitution.apply(formula);
+
+		CHECK(print() == "exists U1, U2, U3 p(U2, U2, U3)");
+	}
+
+	SECTION("replacements are not substituted themselves")
+	{
+		substitution.add(*y, ast::BinaryOperation(ast::BinaryOperation::Operator::Plus, ast::Variable(y), ast::Integer(1)));
+		substitution.apply(formula);
+
+		CHECK(print() == "exists U1, U2, U3 p(U1, U2 + 1, U3)");
+	}
+
+	SECTION("substitutions sharing variables don’t interfere")
+	{
+		substitution.add(*x, ast::Integer(1));
+
+		ast::VariableSubstitution otherSubstitution;
+		otherSubstitution.add(*y, ast::Integer(2));
+		otherSubstitution.add(*x, ast::Integer(3));
+
+		substitution.add(*z, *y);
+		substitution.apply(formula);
+
+		CHECK(print() == "exists U1, U2, U3 p(1, U2, U2)");
+		CHECK(otherSubstitution.find(*x)->get<ast::Integer>().value == 3);
+	}
+
+	SECTION("many variables are replaced at once")
+	{
+		ast::VariableDeclarationPointers otherVariables;
+
+		for (size_t i = 0; i < 12; i++)
+		{
+			otherVariables.emplace_back(std::make_unique<ast::VariableDeclaration>(ast::VariableDeclaration::Type::UserDefined));
+			substitution.add(*otherVariables.back(), ast::Integer(i));
+		}
+
+		substitution.add(*y, ast::Integer(12));
+		substitution.add(*otherVariables[5], ast::Integer(13));
+		substitution.apply(formula);
+
+		CHECK(print() == "exists U1, U2, U3 p(U1, 12, U3)");
+		CHECK(substitution.find(*otherVariables[5])->get<ast::Integer>().value == 5);
+		CHECK(substitution.find(*otherVariables[11])->get<ast::Integer>().value == 11);
+		CHECK(substitution.find(*x) == nullptr);
+	}
+}
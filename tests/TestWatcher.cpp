@@ -0,0 +1,79 @@
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <anthem/Context.h>
+#include <anthem/Watcher.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("[watcher] Input files are translated again after they change", "[watcher]")
+{
+	using namespace anthem;
+
+	char directoryName[] = "/tmp/anthem-test-XXXXXX";
+	REQUIRE(mkdtemp(directoryName) != nullptr);
+
+	const auto fileName = std::string(directoryName) + "/input.lp";
+
+	const auto writeFile =
+		[](const std::string &fileName, const std::string &content)
+		{
+			std::ofstream file(fileName, std::ios::out);
+			file << content;
+		};
+
+	writeFile(fileName, "p(1..5).");
+
+	std::stringstream output;
+	std::stringstream errors;
+
+	Context context{output::Logger(output::ColorStream(output), output::ColorStream(errors))};
+	context.translationMode = TranslationMode::Completion;
+	context.performSimplification = false;
+	context.performCompletion = false;
+
+	Watcher watcher({fileName}, context);
+
+	watcher.translate();
+	CHECK(output.str() == "(V1 in (1..5) -> p(V1))\n");
+
+	SECTION("files written in place are noticed")
+	{
+		CHECK(!watcher.waitForChange(0));
+
+		writeFile(fileName, "q(1..5).");
+		REQUIRE(watcher.waitForChange(1000));
+
+		output.str("");
+		watcher.translate();
+		CHECK(output.str() == "(V1 in (1..5) -> q(V1))\n");
+	}
+
+	SECTION("replaced files are noticed")
+	{
+		writeFile(fileName + ".new", "q(1..5).");
+		std::rename((fileName + ".new").c_str(), fileName.c_str());
+		CHECK(watcher.waitForChange(1000));
+	}
+
+	SECTION("other files are ignored")
+	{
+		writeFile(std::string(directoryName) + "/other.lp", "q(1..5).");
+		CHECK(!watcher.waitForChange(50));
+	}
+
+	SECTION("errors don’t stop watching")
+	{
+		writeFile(fileName, "p(X :- q.");
+		REQUIRE(watcher.waitForChange(1000));
+
+		output.str("");
+		watcher.translate();
+		CHECK(output.str().empty());
+		CHECK(errors.str().find("error") != std::string::npos);
+	}
+}